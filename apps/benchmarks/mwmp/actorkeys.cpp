@@ -0,0 +1,144 @@
+#include <benchmark/benchmark.h>
+
+#include <components/openmw-mp/ActorKey.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    std::atomic<std::size_t> allocations(0);
+}
+
+// Count every allocation, so each benchmark can report how many it made per actor looked up
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void *pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+namespace
+{
+    // The actors in a crowded cell, most of them from content files and the rest placed during play
+    struct Actor
+    {
+        unsigned int refNum;
+        unsigned int mpNum;
+    };
+
+    std::vector<Actor> generateActors(std::size_t number)
+    {
+        std::vector<Actor> actors(number);
+
+        for (std::size_t i = 0; i < number; ++i)
+        {
+            if (i % 5 == 0)
+                actors[i] = { 0, static_cast<unsigned int>(1000000 + i) };
+            else
+                actors[i] = { static_cast<unsigned int>(100000 + i * 7), 0 };
+        }
+
+        return actors;
+    }
+
+    void reportAllocations(benchmark::State& state, std::size_t allocationsBefore, std::size_t lookups)
+    {
+        const std::size_t made = allocations.load(std::memory_order_relaxed) - allocationsBefore;
+        state.counters["allocationsPerLookup"] = static_cast<double>(made) / static_cast<double>(lookups);
+    }
+
+    // Utils::toString, which the previous CellController::generateMapIndex used
+    std::string toString(int num)
+    {
+        std::ostringstream stream;
+        stream << num;
+        return stream.str();
+    }
+
+    // The previous CellController::generateMapIndex and the std::map it was used with
+    std::string generateStringIndex(int refNum, int mpNum)
+    {
+        return toString(refNum) + "-" + toString(mpNum);
+    }
+
+    void lookUpByString(benchmark::State& state)
+    {
+        const std::vector<Actor> actors = generateActors(state.range(0));
+        std::map<std::string, int> dedicatedActors;
+
+        for (std::size_t i = 0; i < actors.size(); ++i)
+            dedicatedActors[generateStringIndex(actors[i].refNum, actors[i].mpNum)] = static_cast<int>(i);
+
+        std::size_t lookups = 0;
+        const std::size_t allocationsBefore = allocations.load(std::memory_order_relaxed);
+
+        // Every actor of an ID_ACTOR_POSITION packet, as read by Cell::readPositions
+        while (state.KeepRunning())
+        {
+            for (const Actor &actor : actors)
+            {
+                std::string mapIndex = generateStringIndex(actor.refNum, actor.mpNum);
+
+                if (dedicatedActors.count(mapIndex) > 0)
+                    benchmark::DoNotOptimize(dedicatedActors[mapIndex]);
+            }
+
+            lookups += actors.size();
+        }
+
+        reportAllocations(state, allocationsBefore, lookups);
+    }
+
+    void lookUpByActorKey(benchmark::State& state)
+    {
+        const std::vector<Actor> actors = generateActors(state.range(0));
+        std::unordered_map<mwmp::ActorKey, int> dedicatedActors;
+
+        for (std::size_t i = 0; i < actors.size(); ++i)
+            dedicatedActors[mwmp::getActorKey(actors[i].refNum, actors[i].mpNum)] = static_cast<int>(i);
+
+        std::size_t lookups = 0;
+        const std::size_t allocationsBefore = allocations.load(std::memory_order_relaxed);
+
+        while (state.KeepRunning())
+        {
+            for (const Actor &actor : actors)
+            {
+                auto it = dedicatedActors.find(mwmp::getActorKey(actor.refNum, actor.mpNum));
+
+                if (it != dedicatedActors.end())
+                    benchmark::DoNotOptimize(it->second);
+            }
+
+            lookups += actors.size();
+        }
+
+        reportAllocations(state, allocationsBefore, lookups);
+    }
+} // namespace
+
+BENCHMARK(lookUpByString)->Arg(50)->Arg(300);
+BENCHMARK(lookUpByActorKey)->Arg(50)->Arg(300);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,184 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/cellref.hpp>
+#include <components/misc/stringops.hpp>
+
+#include "apps/openmw/mwmp/RefNumIndex.hpp"
+
+#include <list>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // How many objects an ID_CONTAINER packet for a large container sync refers to
+    const std::size_t searchesPerPacket = 300;
+
+    // The references of a cluttered cell, with the ones placed during play having an mpNum instead
+    // of a reference number, kept in a list like the CellRefLists of a CellStore
+    std::list<ESM::CellRef> generateReferences(std::size_t number)
+    {
+        std::list<ESM::CellRef> references;
+
+        for (std::size_t i = 0; i < number; ++i)
+        {
+            ESM::CellRef &reference = references.emplace_back();
+            reference.blank();
+            reference.mRefID = "misc_com_bottle_" + std::to_string(i % 15);
+
+            if (i % 4 == 0)
+                reference.mMpNum = static_cast<unsigned int>(i + 1);
+            else
+                reference.mRefNum.mIndex = static_cast<unsigned int>(i + 1);
+        }
+
+        return references;
+    }
+
+    struct Search
+    {
+        unsigned int mRefNum;
+        unsigned int mMpNum;
+        std::string mRefId;
+    };
+
+    // Searches for references picked at random, with the given share of them for references that
+    // are no longer in the cell, such as objects another player already picked up
+    std::vector<Search> generateSearches(const std::vector<ESM::CellRef *> &references, double missRatio)
+    {
+        std::minstd_rand random;
+        std::uniform_int_distribution<std::size_t> distribution(0, references.size() - 1);
+        std::bernoulli_distribution miss(missRatio);
+        std::vector<Search> searches;
+
+        for (std::size_t i = 0; i < searchesPerPacket; ++i)
+        {
+            if (miss(random))
+                searches.push_back({0, static_cast<unsigned int>(references.size() + 1 + i), "misc_com_bottle_0"});
+            else
+            {
+                const ESM::CellRef &reference = *references[distribution(random)];
+                searches.push_back({reference.mRefNum.mIndex, reference.mMpNum, reference.mRefID});
+            }
+        }
+
+        return searches;
+    }
+
+    // The check CellStore::searchExact makes on every reference it goes through
+    bool matches(const ESM::CellRef &reference, const Search &search)
+    {
+        return reference.mRefNum.mIndex == search.mRefNum && reference.mMpNum == search.mMpNum &&
+            (search.mRefId.empty() || Misc::StringUtils::ciEqual(reference.mRefID, search.mRefId));
+    }
+
+    // The previous CellStore::searchExact, which went through mMergedRefs until it found a match and
+    // through all of it for every miss
+    void searchByScan(benchmark::State& state)
+    {
+        std::list<ESM::CellRef> storage = generateReferences(state.range(0));
+        std::vector<ESM::CellRef *> references;
+
+        for (ESM::CellRef &reference : storage)
+            references.push_back(&reference);
+
+        const std::vector<Search> searches = generateSearches(references, state.range(1) / 100.0);
+
+        while (state.KeepRunning())
+        {
+            for (const Search &search : searches)
+            {
+                const ESM::CellRef *found = nullptr;
+
+                for (const ESM::CellRef *reference : references)
+                {
+                    if (matches(*reference, search))
+                    {
+                        found = reference;
+                        break;
+                    }
+                }
+
+                benchmark::DoNotOptimize(found);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * searches.size());
+    }
+
+    // CellStore::searchExact going through the RefNumIndex it keeps up to date
+    void searchByIndex(benchmark::State& state)
+    {
+        std::list<ESM::CellRef> storage = generateReferences(state.range(0));
+        std::vector<ESM::CellRef *> references;
+        mwmp::RefNumIndex<ESM::CellRef> index;
+        index.reserve(storage.size());
+
+        for (ESM::CellRef &reference : storage)
+        {
+            references.push_back(&reference);
+            index.add(&reference, reference.mRefNum.mIndex, reference.mMpNum);
+        }
+
+        const std::vector<Search> searches = generateSearches(references, state.range(1) / 100.0);
+
+        while (state.KeepRunning())
+        {
+            for (const Search &search : searches)
+            {
+                const ESM::CellRef *found = nullptr;
+
+                if (const std::vector<ESM::CellRef *> *candidates = index.find(search.mRefNum, search.mMpNum))
+                {
+                    for (const ESM::CellRef *reference : *candidates)
+                    {
+                        if (matches(*reference, search))
+                        {
+                            found = reference;
+                            break;
+                        }
+                    }
+                }
+
+                benchmark::DoNotOptimize(found);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * searches.size());
+    }
+
+    // Objects being placed in a cell and moved out of it, which used to make the next search rebuild
+    // the index of the whole cell
+    void updateIndex(benchmark::State& state)
+    {
+        std::list<ESM::CellRef> storage = generateReferences(state.range(0));
+        mwmp::RefNumIndex<ESM::CellRef> index;
+        index.reserve(storage.size());
+
+        for (ESM::CellRef &reference : storage)
+            index.add(&reference, reference.mRefNum.mIndex, reference.mMpNum);
+
+        auto it = storage.begin();
+
+        while (state.KeepRunning())
+        {
+            index.remove(&*it);
+            index.add(&*it, it->mRefNum.mIndex, it->mMpNum);
+
+            if (++it == storage.end())
+                it = storage.begin();
+        }
+    }
+} // namespace
+
+// The number of references in the cell and the percentage of searches that miss
+#define CELL_SEARCH_BENCHMARK(function) \
+    BENCHMARK(function)->Args({500, 0})->Args({2000, 0})->Args({8000, 0}) \
+        ->Args({500, 50})->Args({2000, 50})->Args({8000, 50});
+
+CELL_SEARCH_BENCHMARK(searchByScan)
+CELL_SEARCH_BENCHMARK(searchByIndex)
+BENCHMARK(updateIndex)->Arg(500)->Arg(8000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,299 @@
+#include <benchmark/benchmark.h>
+
+#include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
+
+#include <components/esm/esmreader.hpp>
+#include <components/esm/esmwriter.hpp>
+#include <components/esm/records.hpp>
+#include <components/loadinglistener/loadinglistener.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include "apps/openmw/mwworld/esmstore.hpp"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // How many references each generated cell has
+    const int refsPerCell = 100;
+
+    const std::string engineVersion = "benchmark";
+
+    Loading::Listener listener;
+
+    template <class T>
+    void writeRecord(ESM::ESMWriter &writer, const T &record, uint32_t flags = 0)
+    {
+        writer.startRecord(T::sRecordId, flags);
+        record.save(writer);
+        writer.endRecord(T::sRecordId);
+    }
+
+    // A master file with the given number of objects and a cell for every hundred of them, placing
+    // each object once, followed by a plugin changing every tenth object, as a stand in for a
+    // typical list of content files
+    struct ContentFiles
+    {
+        boost::filesystem::path mDirectory;
+        std::vector<std::string> mPaths;
+        std::vector<ESM::StoreSnapshot::ContentFile> mSnapshotContentFiles;
+
+        explicit ContentFiles(int objectCount)
+        {
+            mDirectory = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("openmw-esmstore-%%%%-%%%%");
+            boost::filesystem::create_directories(mDirectory);
+
+            for (int file = 0; file < 2; ++file)
+            {
+                const std::string name = file == 0 ? "master.esm" : "plugin.esp";
+                mPaths.push_back((mDirectory / name).string());
+                mSnapshotContentFiles.push_back({name, static_cast<unsigned int>(file)});
+
+                // Records are split into parts for parsing ahead of time by the count in the header
+                const int objectRecordCount = file == 0 ? objectCount : (objectCount + 4) / 10;
+                const int cellRecordCount = file == 0 ? objectCount / refsPerCell : 0;
+
+                boost::filesystem::ofstream stream(mPaths.back(), std::ios::binary);
+                ESM::ESMWriter writer;
+                writer.setFormat(0);
+                writer.setVersion();
+                writer.setRecordCount(1 + objectRecordCount + cellRecordCount);
+                writer.save(stream);
+
+                ESM::Class cls;
+                cls.blank();
+                cls.mId = "class";
+                writeRecord(writer, cls);
+
+                for (int i = file == 0 ? 0 : 5; i < objectCount; i += file == 0 ? 1 : 10)
+                {
+                    const std::string id = "Object_" + std::to_string(i);
+
+                    switch (i % 3)
+                    {
+                        case 0:
+                        {
+                            ESM::Static record;
+                            record.blank();
+                            record.mId = id;
+                            record.mModel = "meshes\\x\\" + id + (file == 0 ? ".nif" : "_changed.nif");
+                            writeRecord(writer, record);
+                            break;
+                        }
+                        case 1:
+                        {
+                            ESM::Miscellaneous record;
+                            record.blank();
+                            record.mId = id;
+                            record.mName = "Some item";
+                            record.mModel = "meshes\\m\\" + id + ".nif";
+                            record.mData.mValue = file + 1;
+                            writeRecord(writer, record);
+                            break;
+                        }
+                        default:
+                        {
+                            ESM::NPC record;
+                            record.blank();
+                            record.mId = id;
+                            record.mName = "Someone";
+                            record.mClass = "class";
+                            record.mRace = "imperial";
+                            record.mNpdt.mLevel = static_cast<short>(file + 1);
+                            writeRecord(writer, record, 0x0400);
+                            break;
+                        }
+                    }
+                }
+
+                if (file == 0)
+                {
+                    for (int i = 0; i < objectCount / refsPerCell; ++i)
+                    {
+                        ESM::Cell cell;
+                        cell.blank();
+                        cell.mName = "Cell " + std::to_string(i);
+                        cell.mData.mFlags = ESM::Cell::Interior;
+
+                        writer.startRecord(ESM::Cell::sRecordId);
+                        cell.save(writer);
+
+                        for (int j = 0; j < refsPerCell; ++j)
+                        {
+                            ESM::CellRef ref;
+                            ref.blank();
+                            ref.mRefNum.mIndex = i * refsPerCell + j + 1;
+                            ref.mRefID = "object_" + std::to_string(i * refsPerCell + j);
+                            ref.save(writer);
+                        }
+
+                        writer.endRecord(ESM::Cell::sRecordId);
+                    }
+                }
+
+                writer.close();
+            }
+        }
+
+        ~ContentFiles()
+        {
+            boost::system::error_code error;
+            boost::filesystem::remove_all(mDirectory, error);
+        }
+
+        std::string getSnapshotPath() const
+        {
+            return (mDirectory / "snapshot").string();
+        }
+
+        void stage(MWWorld::ESMStore &store, ToUTF8::Utf8Encoder &encoder, std::size_t partCount) const
+        {
+            store.stage(mPaths, &encoder, &listener, partCount);
+        }
+
+        // Load the content files in order, adding whatever was parsed ahead of time instead of
+        // parsing it again
+        void loadContentFiles(MWWorld::ESMStore &store, ToUTF8::Utf8Encoder &encoder) const
+        {
+            std::vector<ESM::ESMReader> readers(mPaths.size());
+
+            for (std::size_t i = 0; i < mPaths.size(); ++i)
+            {
+                readers[i].setEncoder(&encoder);
+                readers[i].setIndex(static_cast<int>(i));
+                readers[i].setGlobalReaderList(&readers);
+                readers[i].open(mPaths[i]);
+                store.load(readers[i], &listener);
+            }
+
+            store.setUp(true);
+        }
+
+        // Load the content files as the engine does at startup, after loading the snapshot if
+        // given one and otherwise after parsing records ahead of time
+        void load(MWWorld::ESMStore &store, ToUTF8::Utf8Encoder &encoder, bool useSnapshot) const
+        {
+            if (!useSnapshot || !store.loadSnapshot(getSnapshotPath(), engineVersion, mSnapshotContentFiles, &encoder))
+                stage(store, encoder, 0);
+
+            loadContentFiles(store, encoder);
+        }
+    };
+
+    // Parsing the records of the content files ahead of time, with every file split into the given
+    // number of parts, or as many as their size and the hardware threads call for with 0
+    void stageContentFiles(benchmark::State& state)
+    {
+        const ContentFiles contentFiles(state.range(0));
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        std::optional<MWWorld::ESMStore> store;
+
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            store.emplace();
+            state.ResumeTiming();
+
+            contentFiles.stage(*store, encoder, state.range(1));
+        }
+    }
+
+    // Loading the content files in order after parsing their records ahead of time, which only has
+    // to add the parsed records to the stores
+    void loadStagedContentFiles(benchmark::State& state)
+    {
+        const ContentFiles contentFiles(state.range(0));
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        std::optional<MWWorld::ESMStore> store;
+
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            store.emplace();
+            contentFiles.stage(*store, encoder, state.range(1));
+            state.ResumeTiming();
+
+            contentFiles.loadContentFiles(*store, encoder);
+        }
+    }
+
+    // Loading the content files in order while parsing every record, as before records were parsed
+    // ahead of time
+    void loadContentFilesInFull(benchmark::State& state)
+    {
+        const ContentFiles contentFiles(state.range(0));
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        std::optional<MWWorld::ESMStore> store;
+
+        while (state.KeepRunning())
+        {
+            state.PauseTiming();
+            store.emplace();
+            state.ResumeTiming();
+
+            contentFiles.loadContentFiles(*store, encoder);
+        }
+    }
+
+    // Startup on the first launch with a list of content files, which has to parse all of them
+    void loadWithoutSnapshot(benchmark::State& state)
+    {
+        const ContentFiles contentFiles(state.range(0));
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+
+        while (state.KeepRunning())
+        {
+            MWWorld::ESMStore store;
+            contentFiles.load(store, encoder, false);
+            benchmark::DoNotOptimize(store.getRefCount("object_0"));
+        }
+    }
+
+    // Startup on later launches with the same list of content files
+    void loadWithSnapshot(benchmark::State& state)
+    {
+        const ContentFiles contentFiles(state.range(0));
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+
+        {
+            MWWorld::ESMStore store;
+            contentFiles.load(store, encoder, false);
+            store.writeSnapshot(contentFiles.getSnapshotPath(), engineVersion, contentFiles.mSnapshotContentFiles, &encoder);
+        }
+
+        while (state.KeepRunning())
+        {
+            MWWorld::ESMStore store;
+            contentFiles.load(store, encoder, true);
+            benchmark::DoNotOptimize(store.getRefCount("object_0"));
+        }
+    }
+
+    // The extra work done once on the first launch
+    void writeSnapshot(benchmark::State& state)
+    {
+        const ContentFiles contentFiles(state.range(0));
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+
+        MWWorld::ESMStore store;
+        contentFiles.load(store, encoder, false);
+
+        while (state.KeepRunning())
+            store.writeSnapshot(contentFiles.getSnapshotPath(), engineVersion, contentFiles.mSnapshotContentFiles, &encoder);
+    }
+
+} // namespace
+
+// The number of objects and the number of parts every file is split into for parsing ahead of time
+BENCHMARK(stageContentFiles)->Args({100000, 0})->Args({100000, 1})->Args({100000, 4})->Unit(benchmark::kMillisecond);
+BENCHMARK(loadStagedContentFiles)->Args({100000, 0})->Args({100000, 4})->Unit(benchmark::kMillisecond);
+BENCHMARK(loadContentFilesInFull)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK(loadWithoutSnapshot)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(loadWithSnapshot)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+BENCHMARK(writeSnapshot)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
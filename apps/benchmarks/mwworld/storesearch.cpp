@@ -0,0 +1,145 @@
+#include <benchmark/benchmark.h>
+
+#include <components/esm/records.hpp>
+#include <components/misc/stringops.hpp>
+
+#include "apps/openmw/mwworld/store.hpp"
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // IDs as they reach searches from content files, scripts and packets, in any letter case,
+    // with every tenth one missing from the store
+    std::vector<std::string> generateIds(std::size_t count, std::mt19937 &random)
+    {
+        std::vector<std::string> ids;
+        ids.reserve(count);
+
+        for (std::size_t i = 0; i < count; ++i)
+            ids.push_back((i % 2 == 0 ? "Record_" : "record_ID_") + std::to_string(i));
+
+        std::shuffle(ids.begin(), ids.end(), random);
+        return ids;
+    }
+
+    template <class T>
+    void fillStore(MWWorld::Store<T> &store, const std::vector<std::string> &ids)
+    {
+        T record;
+
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            if (i % 10 == 9)
+                continue;
+
+            record.mId = ids[i];
+
+            // A few records changed during play, like the ones a server sends
+            if (i % 100 == 0)
+                store.insert(record);
+            else
+                store.insertStatic(record);
+        }
+    }
+
+    // Search the way Store used to, with a lowercase copy of the ID looked up in the map of
+    // dynamic records and then the one of static records
+    template <class T>
+    void searchMaps(benchmark::State& state)
+    {
+        std::mt19937 random;
+        const std::vector<std::string> ids = generateIds(state.range(0), random);
+
+        std::map<std::string, T> dynamicRecords;
+        std::map<std::string, T> staticRecords;
+
+        for (std::size_t i = 0; i < ids.size(); ++i)
+        {
+            if (i % 10 != 9)
+                (i % 100 == 0 ? dynamicRecords : staticRecords)[Misc::StringUtils::lowerCase(ids[i])].mId = ids[i];
+        }
+
+        std::size_t index = 0;
+
+        while (state.KeepRunning())
+        {
+            const std::string &id = ids[index++ % ids.size()];
+            const std::string idLower = Misc::StringUtils::lowerCase(id);
+            const T *found = nullptr;
+
+            auto dynamicIt = dynamicRecords.find(idLower);
+            if (dynamicIt != dynamicRecords.end())
+                found = &dynamicIt->second;
+            else
+            {
+                auto staticIt = staticRecords.find(idLower);
+                if (staticIt != staticRecords.end())
+                    found = &staticIt->second;
+            }
+
+            benchmark::DoNotOptimize(found);
+        }
+    }
+
+    template <class T>
+    void searchStore(benchmark::State& state)
+    {
+        std::mt19937 random;
+        const std::vector<std::string> ids = generateIds(state.range(0), random);
+
+        MWWorld::Store<T> store;
+        fillStore(store, ids);
+
+        std::size_t index = 0;
+
+        while (state.KeepRunning())
+            benchmark::DoNotOptimize(store.search(ids[index++ % ids.size()]));
+    }
+} // namespace
+
+#define STORE_SEARCH_BENCHMARKS(T) \
+    BENCHMARK_TEMPLATE(searchMaps, T)->Arg(1000)->Arg(100000); \
+    BENCHMARK_TEMPLATE(searchStore, T)->Arg(1000)->Arg(100000);
+
+STORE_SEARCH_BENCHMARKS(ESM::Activator)
+STORE_SEARCH_BENCHMARKS(ESM::Apparatus)
+STORE_SEARCH_BENCHMARKS(ESM::Armor)
+STORE_SEARCH_BENCHMARKS(ESM::BirthSign)
+STORE_SEARCH_BENCHMARKS(ESM::BodyPart)
+STORE_SEARCH_BENCHMARKS(ESM::Book)
+STORE_SEARCH_BENCHMARKS(ESM::Class)
+STORE_SEARCH_BENCHMARKS(ESM::Clothing)
+STORE_SEARCH_BENCHMARKS(ESM::Container)
+STORE_SEARCH_BENCHMARKS(ESM::Creature)
+STORE_SEARCH_BENCHMARKS(ESM::CreatureLevList)
+STORE_SEARCH_BENCHMARKS(ESM::Dialogue)
+STORE_SEARCH_BENCHMARKS(ESM::Door)
+STORE_SEARCH_BENCHMARKS(ESM::Enchantment)
+STORE_SEARCH_BENCHMARKS(ESM::Faction)
+STORE_SEARCH_BENCHMARKS(ESM::GameSetting)
+STORE_SEARCH_BENCHMARKS(ESM::Global)
+STORE_SEARCH_BENCHMARKS(ESM::Ingredient)
+STORE_SEARCH_BENCHMARKS(ESM::ItemLevList)
+STORE_SEARCH_BENCHMARKS(ESM::Light)
+STORE_SEARCH_BENCHMARKS(ESM::Lockpick)
+STORE_SEARCH_BENCHMARKS(ESM::Miscellaneous)
+STORE_SEARCH_BENCHMARKS(ESM::NPC)
+STORE_SEARCH_BENCHMARKS(ESM::Potion)
+STORE_SEARCH_BENCHMARKS(ESM::Probe)
+STORE_SEARCH_BENCHMARKS(ESM::Race)
+STORE_SEARCH_BENCHMARKS(ESM::Region)
+STORE_SEARCH_BENCHMARKS(ESM::Repair)
+STORE_SEARCH_BENCHMARKS(ESM::Script)
+STORE_SEARCH_BENCHMARKS(ESM::Sound)
+STORE_SEARCH_BENCHMARKS(ESM::SoundGenerator)
+STORE_SEARCH_BENCHMARKS(ESM::Spell)
+STORE_SEARCH_BENCHMARKS(ESM::StartScript)
+STORE_SEARCH_BENCHMARKS(ESM::Static)
+STORE_SEARCH_BENCHMARKS(ESM::Weapon)
+
+BENCHMARK_MAIN();
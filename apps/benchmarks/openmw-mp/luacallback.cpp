@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+
+#include <Script/LangLua/LangLua.hpp>
+
+#include <boost/any.hpp>
+
+#include <stdexcept>
+#include <string>
+
+// Registering the server's script functions is left out along with them, since the script is loaded
+// by the benchmark itself
+void LangLua::LoadProgram(const char *filename)
+{
+    throw std::logic_error("Lua scripts can't be loaded as programs in the benchmark");
+}
+
+namespace
+{
+    const char *script =
+        "messages = 0\n"
+        "function OnPlayerSendMessage(pid, message)\n"
+        "    messages = messages + 1\n"
+        "end\n";
+
+    const unsigned int callbackId = 1;
+
+    lua_State *createState()
+    {
+        lua_State *lua = luaL_newstate();
+        luaL_openlibs(lua);
+
+        if (luaL_dostring(lua, script) != 0)
+            throw std::runtime_error(lua_tostring(lua, -1));
+
+        // Give the globals table enough unrelated entries to resemble a loaded server script
+        for (int i = 0; i < 2000; ++i)
+        {
+            lua_pushinteger(lua, i);
+            lua_setglobal(lua, ("serverGlobal" + std::to_string(i)).c_str());
+        }
+
+        return lua;
+    }
+
+    // LangLua::Call, which Script::Call used to go through, finding the callback by name and keeping
+    // its result as a LuaRef
+    void callByName(benchmark::State& state)
+    {
+        LangLua langLua(createState());
+
+        while (state.KeepRunning())
+        {
+            boost::any result = langLua.Call("OnPlayerSendMessage", "is", 0, 7u, "Hello");
+
+            // Call leaves the result on the stack
+            lua_pop(langLua.lua, 1);
+            benchmark::DoNotOptimize(result);
+        }
+
+        langLua.FreeProgram();
+    }
+
+    // LangLua::CallCallback, which keeps a registry reference to the callback and discards its result
+    void callByReference(benchmark::State& state)
+    {
+        LangLua langLua(createState());
+
+        while (state.KeepRunning())
+            langLua.CallCallback(callbackId, "OnPlayerSendMessage", "is", 7u, "Hello");
+
+        langLua.FreeProgram();
+    }
+} // namespace
+
+BENCHMARK(callByName);
+BENCHMARK(callByReference);
+
+BENCHMARK_MAIN();
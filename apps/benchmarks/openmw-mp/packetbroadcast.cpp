@@ -0,0 +1,90 @@
+#include <benchmark/benchmark.h>
+
+#include <components/openmw-mp/Base/BaseActor.hpp>
+#include <components/openmw-mp/Packets/Actor/PacketActorPosition.hpp>
+
+#include <random>
+
+namespace
+{
+    template <typename Random>
+    void generateActorList(mwmp::BaseActorList& actorList, std::size_t number, Random& random)
+    {
+        std::uniform_real_distribution<float> distribution(-8192.0f, 8192.0f);
+
+        actorList.cell.blank();
+        actorList.cell.mName = "Balmora";
+        actorList.baseActors.resize(number);
+
+        for (std::size_t i = 0; i < number; ++i)
+        {
+            mwmp::BaseActor& actor = actorList.baseActors[i];
+            actor.refNum = static_cast<unsigned int>(i);
+            actor.mpNum = 0;
+
+            for (int j = 0; j < 3; ++j)
+            {
+                actor.position.pos[j] = distribution(random);
+                actor.position.rot[j] = distribution(random);
+                actor.direction.pos[j] = distribution(random);
+            }
+        }
+
+        actorList.count = static_cast<unsigned int>(number);
+    }
+
+    // The old sendToLoaded behaviour, where the packet is encoded again for every recipient
+    void encodePerRecipient(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        mwmp::BaseActorList actorList;
+        generateActorList(actorList, 32, random);
+
+        RakNet::BitStream bitStream;
+        mwmp::PacketActorPosition packet(nullptr);
+        packet.setActorList(&actorList);
+
+        const auto recipients = state.range(0);
+
+        while (state.KeepRunning())
+        {
+            for (auto i = 0; i < recipients; ++i)
+            {
+                bitStream.ResetWritePointer();
+                packet.Packet(&bitStream, true);
+                benchmark::DoNotOptimize(bitStream.GetData());
+            }
+        }
+    }
+
+    // The packet is encoded once and the same buffer is handed to every recipient
+    void encodeOnce(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        mwmp::BaseActorList actorList;
+        generateActorList(actorList, 32, random);
+
+        RakNet::BitStream bitStream;
+        mwmp::PacketActorPosition packet(nullptr);
+        packet.SetSendStream(&bitStream);
+        packet.setActorList(&actorList);
+
+        const auto recipients = state.range(0);
+
+        while (state.KeepRunning())
+        {
+            const mwmp::SerializedPacketPtr serializedPacket = packet.Serialize();
+
+            for (auto i = 0; i < recipients; ++i)
+            {
+                mwmp::SerializedPacketPtr recipientPacket = serializedPacket;
+                benchmark::DoNotOptimize(recipientPacket);
+            }
+        }
+    }
+} // namespace
+
+BENCHMARK(encodePerRecipient)->RangeMultiplier(2)->Range(1, 128);
+BENCHMARK(encodeOnce)->RangeMultiplier(2)->Range(1, 128);
+
+BENCHMARK_MAIN();
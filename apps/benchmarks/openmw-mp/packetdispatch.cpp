@@ -0,0 +1,182 @@
+#include <benchmark/benchmark.h>
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Controllers/SystemPacketController.hpp>
+#include <components/openmw-mp/Controllers/PlayerPacketController.hpp>
+#include <components/openmw-mp/Controllers/ActorPacketController.hpp>
+#include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
+#include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
+#include <components/openmw-mp/Controllers/PacketDispatchTable.hpp>
+
+#include <RakPeerInterface.h>
+
+#include <random>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    // Relative frequencies of packet identifiers as received by a server with a handful of
+    // players moving around a populated exterior cell, where position and animation updates
+    // make up most of the traffic
+    const std::vector<std::pair<RakNet::MessageID, unsigned int>> packetMix = {
+        { ID_PLAYER_POSITION, 40 },
+        { ID_ACTOR_POSITION, 25 },
+        { ID_PLAYER_ANIM_FLAGS, 8 },
+        { ID_ACTOR_ANIM_FLAGS, 6 },
+        { ID_PLAYER_STATS_DYNAMIC, 5 },
+        { ID_ACTOR_STATS_DYNAMIC, 4 },
+        { ID_PLAYER_ATTACK, 2 },
+        { ID_ACTOR_ATTACK, 2 },
+        { ID_OBJECT_ACTIVATE, 1 },
+        { ID_OBJECT_PLACE, 1 },
+        { ID_CONTAINER, 1 },
+        { ID_PLAYER_INVENTORY, 1 },
+        { ID_PLAYER_CELL_CHANGE, 1 },
+        { ID_WORLD_TIME, 1 },
+        { ID_CHAT_MESSAGE, 1 }
+    };
+
+    std::vector<RakNet::MessageID> recordPackets(std::size_t number)
+    {
+        std::minstd_rand random;
+        std::vector<unsigned int> weights;
+
+        for (const auto &entry : packetMix)
+            weights.push_back(entry.second);
+
+        std::discrete_distribution<std::size_t> distribution(weights.begin(), weights.end());
+        std::vector<RakNet::MessageID> packets;
+        packets.reserve(number);
+
+        for (std::size_t i = 0; i < number; ++i)
+            packets.push_back(packetMix[distribution(random)].first);
+
+        return packets;
+    }
+
+    struct Controllers
+    {
+        Controllers() : peer(RakNet::RakPeerInterface::GetInstance()), system(peer), player(peer), actor(peer),
+            object(peer), worldstate(peer)
+        {
+        }
+
+        ~Controllers()
+        {
+            RakNet::RakPeerInterface::DestroyInstance(peer);
+        }
+
+        RakNet::RakPeerInterface *peer;
+        mwmp::SystemPacketController system;
+        mwmp::PlayerPacketController player;
+        mwmp::ActorPacketController actor;
+        mwmp::ObjectPacketController object;
+        mwmp::WorldstatePacketController worldstate;
+    };
+
+    // The previous controllers kept their packets in hash maps, answered ContainsPacket by walking
+    // every entry and bound the read stream to every packet they owned
+    struct LegacyController
+    {
+        template<typename Controller>
+        explicit LegacyController(Controller &controller)
+        {
+            for (unsigned int id = 0; id < 256; ++id)
+            {
+                mwmp::BasePacket *packet = controller.GetPacket(static_cast<RakNet::MessageID>(id));
+
+                if (packet != nullptr)
+                    packets.emplace(static_cast<unsigned char>(id), packet);
+            }
+        }
+
+        bool ContainsPacket(RakNet::MessageID id) const
+        {
+            for (const auto &packet : packets)
+            {
+                if (packet.first == id)
+                    return true;
+            }
+            return false;
+        }
+
+        void SetStream(RakNet::BitStream *inStream)
+        {
+            for (const auto &packet : packets)
+                packet.second->SetStreams(inStream, nullptr);
+        }
+
+        mwmp::BasePacket *GetPacket(RakNet::MessageID id)
+        {
+            return packets[id];
+        }
+
+        std::unordered_map<unsigned char, mwmp::BasePacket *> packets;
+    };
+
+    void dispatchByControllerChain(benchmark::State& state)
+    {
+        Controllers controllers;
+        std::vector<LegacyController> chain = { LegacyController(controllers.system),
+            LegacyController(controllers.player), LegacyController(controllers.actor),
+            LegacyController(controllers.object), LegacyController(controllers.worldstate) };
+
+        const std::vector<RakNet::MessageID> packets = recordPackets(state.range(0));
+        RakNet::BitStream bsIn;
+
+        while (state.KeepRunning())
+        {
+            for (RakNet::MessageID id : packets)
+            {
+                for (LegacyController &controller : chain)
+                {
+                    if (controller.ContainsPacket(id))
+                    {
+                        controller.SetStream(&bsIn);
+                        benchmark::DoNotOptimize(controller.GetPacket(id));
+                        break;
+                    }
+                }
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * packets.size());
+    }
+
+    void dispatchByTable(benchmark::State& state)
+    {
+        Controllers controllers;
+        mwmp::PacketDispatchTable dispatchTable;
+        dispatchTable.addController(mwmp::PacketDispatchTable::Category::System, controllers.system);
+        dispatchTable.addController(mwmp::PacketDispatchTable::Category::Player, controllers.player);
+        dispatchTable.addController(mwmp::PacketDispatchTable::Category::Actor, controllers.actor);
+        dispatchTable.addController(mwmp::PacketDispatchTable::Category::Object, controllers.object);
+        dispatchTable.addController(mwmp::PacketDispatchTable::Category::Worldstate, controllers.worldstate);
+
+        const std::vector<RakNet::MessageID> packets = recordPackets(state.range(0));
+        RakNet::BitStream bsIn;
+
+        while (state.KeepRunning())
+        {
+            for (RakNet::MessageID id : packets)
+            {
+                const mwmp::PacketDispatchTable::Entry &entry = dispatchTable.get(id);
+
+                if (entry.packet != nullptr)
+                    entry.packet->SetReadStream(&bsIn);
+
+                benchmark::DoNotOptimize(entry.category);
+                benchmark::DoNotOptimize(entry.packet);
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * packets.size());
+    }
+} // namespace
+
+BENCHMARK(dispatchByControllerChain)->Arg(1024)->Arg(16384);
+BENCHMARK(dispatchByTable)->Arg(1024)->Arg(16384);
+
+BENCHMARK_MAIN();
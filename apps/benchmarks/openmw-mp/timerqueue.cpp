@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <components/openmw-mp/TimerQueue.hpp>
+
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+    const long tickMsec = 16;
+
+    // Respawn, buff and AI timers of a busy server, spread over the next minute
+    std::vector<long> generateDurations(std::size_t number)
+    {
+        std::minstd_rand random;
+        std::uniform_int_distribution<long> distribution(tickMsec, 60000);
+        std::vector<long> durations(number);
+
+        for (long &duration : durations)
+            duration = distribution(random);
+
+        return durations;
+    }
+
+    // The previous TimerAPI checked every timer on every tick, reading the clock for each of them
+    struct LegacyTimer
+    {
+        double startTime;
+        double targetMsec;
+        bool isEnded;
+    };
+
+    double getLegacyTime()
+    {
+        const auto duration = std::chrono::system_clock::now().time_since_epoch();
+        return static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(duration).count());
+    }
+
+    void tickEveryTimer(benchmark::State& state)
+    {
+        const std::vector<long> durations = generateDurations(state.range(0));
+        std::unordered_map<int, LegacyTimer *> timers;
+
+        for (std::size_t i = 0; i < durations.size(); ++i)
+            timers[static_cast<int>(i)] = new LegacyTimer{ getLegacyTime(), static_cast<double>(durations[i]), false };
+
+        std::size_t expired = 0;
+
+        while (state.KeepRunning())
+        {
+            for (auto timer : timers)
+            {
+                if (timer.second == nullptr || timer.second->isEnded)
+                    continue;
+
+                const double time = getLegacyTime();
+
+                if (time - timer.second->startTime >= timer.second->targetMsec)
+                {
+                    timer.second->isEnded = true;
+                    expired++;
+                }
+            }
+        }
+
+        benchmark::DoNotOptimize(expired);
+
+        for (auto timer : timers)
+            delete timer.second;
+    }
+
+    void tickExpiredTimers(benchmark::State& state)
+    {
+        typedef mwmp::TimerQueue::Clock Clock;
+
+        const std::vector<long> durations = generateDurations(state.range(0));
+        mwmp::TimerQueue queue;
+        Clock::time_point now = Clock::time_point();
+
+        for (std::size_t i = 0; i < durations.size(); ++i)
+            queue.schedule(static_cast<int>(i), now + std::chrono::milliseconds(durations[i]));
+
+        std::vector<int> expired;
+
+        while (state.KeepRunning())
+        {
+            now += std::chrono::milliseconds(tickMsec);
+
+            expired.clear();
+            queue.popExpired(now, expired);
+
+            // Expired timers are restarted, as repeating script timers are, so the number of active
+            // timers stays the same throughout
+            for (int id : expired)
+                queue.schedule(id, now + std::chrono::milliseconds(durations[id]));
+        }
+
+        benchmark::DoNotOptimize(queue.size());
+    }
+} // namespace
+
+BENCHMARK(tickEveryTimer)->Arg(1000)->Arg(100000);
+BENCHMARK(tickExpiredTimers)->Arg(1000)->Arg(100000);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,262 @@
+#include <benchmark/benchmark.h>
+
+#include <components/misc/stringops.hpp>
+#include <components/vfs/archive.hpp>
+#include <components/vfs/bsaarchive.hpp>
+#include <components/vfs/filesystemarchive.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Stands in for an archive when there is no data set to load
+    class GeneratedFile : public VFS::File
+    {
+    public:
+        Files::IStreamPtr open() override
+        {
+            return nullptr;
+        }
+    };
+
+    class GeneratedArchive : public VFS::Archive
+    {
+    public:
+        GeneratedArchive(const std::string& name, const std::vector<std::string>& paths)
+            : mName(name), mFiles(paths.size())
+        {
+            for (std::size_t i = 0; i < paths.size(); ++i)
+                mIndex[paths[i]] = &mFiles[i];
+        }
+
+        void listResources(std::map<std::string, VFS::File*>& out, char (*normalize_function) (char)) override
+        {
+            for (const auto& [path, file] : mIndex)
+            {
+                std::string normalized = path;
+                std::transform(normalized.begin(), normalized.end(), normalized.begin(), normalize_function);
+                out[normalized] = file;
+            }
+        }
+
+        bool contains(const std::string& file, char (*normalize_function) (char)) const override
+        {
+            return mIndex.find(file) != mIndex.end();
+        }
+
+        std::string getDescription() const override
+        {
+            return mName;
+        }
+
+    private:
+        std::string mName;
+        std::vector<GeneratedFile> mFiles;
+        std::map<std::string, VFS::File*> mIndex;
+    };
+
+    // Paths shaped like the ones of the original game, with expansions replacing some of the files
+    // before them
+    std::vector<std::string> generatePaths(const std::string& prefix, std::size_t count, std::size_t replaced)
+    {
+        const char* const directories[] = {"meshes/f/", "meshes/x/", "meshes/i/", "meshes/r/", "textures/",
+            "textures/menu_", "icons/m/", "icons/w/", "sound/fx/", "sound/vo/d/m/"};
+        const char* const extensions[] = {".nif", ".nif", ".nif", ".nif", ".dds", ".dds", ".tga", ".tga", ".wav", ".mp3"};
+
+        std::vector<std::string> paths;
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::size_t kind = i % 10;
+            const std::string name = i < replaced ? "base_" + std::to_string(i) : prefix + std::to_string(i);
+            paths.push_back(directories[kind] + name + extensions[kind]);
+        }
+
+        return paths;
+    }
+
+    // Morrowind, Tribunal and Bloodmoon along with their loose files from a data directory given
+    // through OPENMW_BENCHMARK_DATA, or generated archives shaped like them otherwise
+    std::vector<VFS::Archive*> createArchives()
+    {
+        std::vector<VFS::Archive*> archives;
+
+        if (const char* dataPath = std::getenv("OPENMW_BENCHMARK_DATA"))
+        {
+            for (const char* name : {"Morrowind.bsa", "Tribunal.bsa", "Bloodmoon.bsa"})
+            {
+                const boost::filesystem::path path = boost::filesystem::path(dataPath) / name;
+                if (boost::filesystem::exists(path))
+                    archives.push_back(new VFS::BsaArchive(path.string()));
+            }
+
+            archives.push_back(new VFS::FileSystemArchive(dataPath));
+        }
+        else
+        {
+            archives.push_back(new GeneratedArchive("Morrowind.bsa", generatePaths("morrowind_", 12000, 0)));
+            archives.push_back(new GeneratedArchive("Tribunal.bsa", generatePaths("tribunal_", 3000, 300)));
+            archives.push_back(new GeneratedArchive("Bloodmoon.bsa", generatePaths("bloodmoon_", 3500, 300)));
+        }
+
+        return archives;
+    }
+
+    struct DataSet
+    {
+        VFS::Manager mManager{false};
+
+        // The archives in the order they were registered in, as Manager used to go through them
+        std::vector<VFS::Archive*> mArchives;
+
+        // Every path of the data set spelled like content files do, with backslashes and in any
+        // letter case
+        std::vector<std::string> mPaths;
+
+        DataSet()
+            : mArchives(createArchives())
+        {
+            for (VFS::Archive* archive : mArchives)
+                mManager.addArchive(archive);
+
+            std::mt19937 random;
+
+            for (const auto& [path, file] : mManager.getIndex())
+            {
+                std::string spelled = path;
+
+                for (char& ch : spelled)
+                {
+                    if (ch == '/')
+                        ch = '\\';
+                    else if (random() % 4 == 0)
+                        ch = static_cast<char>(std::toupper(static_cast<unsigned char>(ch)));
+                }
+
+                mPaths.push_back(spelled);
+            }
+
+            std::shuffle(mPaths.begin(), mPaths.end(), random);
+        }
+    };
+
+    const DataSet& getDataSet()
+    {
+        static const DataSet dataSet;
+        return dataSet;
+    }
+
+    char normalizeChar(char ch)
+    {
+        return ch == '\\' ? '/' : Misc::StringUtils::toLower(ch);
+    }
+
+    // Resolve every path the way Manager used to, normalizing a copy of it and searching the map
+    void resolveWithMap(benchmark::State& state)
+    {
+        const DataSet& dataSet = getDataSet();
+        const std::map<std::string, VFS::File*>& index = dataSet.mManager.getIndex();
+
+        while (state.KeepRunning())
+        {
+            for (const std::string& path : dataSet.mPaths)
+            {
+                std::string normalized = path;
+                std::transform(normalized.begin(), normalized.end(), normalized.begin(), &normalizeChar);
+                benchmark::DoNotOptimize(index.find(normalized));
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations() * dataSet.mPaths.size());
+    }
+
+    void resolveWithHashIndex(benchmark::State& state)
+    {
+        const DataSet& dataSet = getDataSet();
+
+        for (const std::string& path : dataSet.mPaths)
+        {
+            if (!dataSet.mManager.exists(path))
+            {
+                state.SkipWithError(("Couldn't find " + path).c_str());
+                return;
+            }
+        }
+
+        while (state.KeepRunning())
+        {
+            for (const std::string& path : dataSet.mPaths)
+                benchmark::DoNotOptimize(dataSet.mManager.exists(path));
+        }
+
+        state.SetItemsProcessed(state.iterations() * dataSet.mPaths.size());
+    }
+
+    // Find the archives of paths the way Manager used to, asking every archive from the last one
+    // whether it has the file, which the archives of the original game do by going through all
+    // of their files
+    void getArchiveByAsking(benchmark::State& state)
+    {
+        const DataSet& dataSet = getDataSet();
+        std::size_t index = 0;
+
+        while (state.KeepRunning())
+        {
+            std::string normalized = dataSet.mPaths[index++ % dataSet.mPaths.size()];
+            std::transform(normalized.begin(), normalized.end(), normalized.begin(), &normalizeChar);
+
+            for (auto it = dataSet.mArchives.rbegin(); it != dataSet.mArchives.rend(); ++it)
+            {
+                if ((*it)->contains(normalized, &normalizeChar))
+                {
+                    benchmark::DoNotOptimize(*it);
+                    break;
+                }
+            }
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void getArchiveFromHashIndex(benchmark::State& state)
+    {
+        const DataSet& dataSet = getDataSet();
+        std::size_t index = 0;
+
+        while (state.KeepRunning())
+            benchmark::DoNotOptimize(dataSet.mManager.getArchive(dataSet.mPaths[index++ % dataSet.mPaths.size()]));
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    // Register the archives of the data set and build the index, as the engine does at startup
+    void registerArchives(benchmark::State& state)
+    {
+        while (state.KeepRunning())
+        {
+            VFS::Manager manager(false);
+
+            for (VFS::Archive* archive : createArchives())
+                manager.addArchive(archive);
+
+            benchmark::DoNotOptimize(manager.getIndex().size());
+        }
+    }
+} // namespace
+
+BENCHMARK(resolveWithMap)->Unit(benchmark::kMillisecond);
+BENCHMARK(resolveWithHashIndex)->Unit(benchmark::kMillisecond);
+BENCHMARK(getArchiveByAsking);
+BENCHMARK(getArchiveFromHashIndex);
+BENCHMARK(registerArchives)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -8,6 +8,26 @@
 #include <fstream>
 #include <cmath>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <unordered_map>
+
+#include <boost/crc.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include <components/esm/storesnapshot.hpp>
+#include <components/misc/stringops.hpp>
+/*
+    End of tes3mp addition
+*/
+
 #include <boost/program_options.hpp>
 
 #include <components/esm/esmreader.hpp>
@@ -65,6 +85,19 @@ struct Arguments
     std::vector<std::string> types;
     std::string name;
 
+    /*
+        Start of tes3mp addition
+
+        Keep track of how many passes over the file to make in bench mode
+    */
+    int iterations;
+
+    // Every file given, for modes that take more than two of them
+    std::vector<std::string> inputFiles;
+    /*
+        End of tes3mp addition
+    */
+
     ESMData data;
     ESM::ESMReader reader;
     ESM::ESMWriter writer;
@@ -72,7 +105,7 @@ struct Arguments
 
 bool parseOptions (int argc, char** argv, Arguments &info)
 {
-    bpo::options_description desc("Inspect and extract from Morrowind ES files (ESM, ESP, ESS)\nSyntax: esmtool [options] mode infile [outfile]\nAllowed modes:\n  dump\t Dumps all readable data from the input file.\n  clone\t Clones the input file to the output file.\n  comp\t Compares the given files.\n\nAllowed options");
+    bpo::options_description desc("Inspect and extract from Morrowind ES files (ESM, ESP, ESS)\nSyntax: esmtool [options] mode infile [outfile]\nAllowed modes:\n  dump\t Dumps all readable data from the input file.\n  clone\t Clones the input file to the output file.\n  comp\t Compares the given files.\n  bench\t Measures how fast the input file is read through a stream and through a memory mapping.\n  verify\t Checks that a snapshot of merged records matches the content files given after it in load order.\n\nAllowed options");
 
     desc.add_options()
         ("help,h", "print help message.")
@@ -90,6 +123,17 @@ bool parseOptions (int argc, char** argv, Arguments &info)
          "Only affects dump mode.")
         ("quiet,q", "Suppress all record information. Useful for speed tests.")
         ("loadcells,C", "Browse through contents of all cells.")
+        /*
+            Start of tes3mp addition
+
+            Make it possible to choose how many passes over the file to make in bench mode
+        */
+        ("iterations,I", bpo::value<int>(&(info.iterations))->default_value(5),
+         "Number of passes over the file for each way of reading it, of which the fastest is "
+         "reported. Only affects bench mode.")
+        /*
+            End of tes3mp addition
+        */
 
         ( "encoding,e", bpo::value<std::string>(&(info.encoding))->
           default_value("win1252"),
@@ -110,7 +154,15 @@ bool parseOptions (int argc, char** argv, Arguments &info)
         ;
 
     bpo::positional_options_description p;
-    p.add("mode", 1).add("input-file", 2);
+    /*
+        Start of tes3mp change (minor)
+
+        Allow any number of input files, since verify mode takes a list of content files
+    */
+    p.add("mode", 1).add("input-file", -1);
+    /*
+        End of tes3mp change (minor)
+    */
 
     // there might be a better way to do this
     bpo::options_description all;
@@ -155,7 +207,8 @@ bool parseOptions (int argc, char** argv, Arguments &info)
         info.name = variables["name"].as<std::string>();
 
     info.mode = variables["mode"].as<std::string>();
-    if (!(info.mode == "dump" || info.mode == "clone" || info.mode == "comp"))
+    if (!(info.mode == "dump" || info.mode == "clone" || info.mode == "comp" || info.mode == "bench" ||
+        info.mode == "verify"))
     {
         std::cout << std::endl << "ERROR: invalid mode \"" << info.mode << "\"" << std::endl << std::endl
                   << desc << finalText << std::endl;
@@ -178,6 +231,15 @@ bool parseOptions (int argc, char** argv, Arguments &info)
       }*/
 
     info.filename = variables["input-file"].as< std::vector<std::string> >()[0];
+    /*
+        Start of tes3mp addition
+
+        Keep track of every input file
+    */
+    info.inputFiles = variables["input-file"].as< std::vector<std::string> >();
+    /*
+        End of tes3mp addition
+    */
     if (variables["input-file"].as< std::vector<std::string> >().size() > 1)
         info.outname = variables["input-file"].as< std::vector<std::string> >()[1];
 
@@ -204,6 +266,16 @@ void loadCell(ESM::Cell &cell, ESM::ESMReader &esm, Arguments& info);
 int load(Arguments& info);
 int clone(Arguments& info);
 int comp(Arguments& info);
+/*
+    Start of tes3mp addition
+
+    Declare the bench and verify modes
+*/
+int bench(Arguments& info);
+int verify(Arguments& info);
+/*
+    End of tes3mp addition
+*/
 
 int main(int argc, char**argv)
 {
@@ -219,6 +291,18 @@ int main(int argc, char**argv)
             return clone(info);
         else if (info.mode == "comp")
             return comp(info);
+        /*
+            Start of tes3mp addition
+
+            Handle the bench and verify modes
+        */
+        else if (info.mode == "bench")
+            return bench(info);
+        else if (info.mode == "verify")
+            return verify(info);
+        /*
+            End of tes3mp addition
+        */
         else
         {
             std::cout << "Invalid or no mode specified, dying horribly. Have a nice day." << std::endl;
@@ -571,3 +655,333 @@ int comp(Arguments& info)
 
     return 0;
 }
+
+/*
+    Start of tes3mp addition
+
+    Parse every record and cell reference of a file the way the game does, both through a stream
+    and through a memory mapping, and report the fastest pass of each
+*/
+int bench(Arguments& info)
+{
+    ToUTF8::Utf8Encoder encoder (ToUTF8::calculateEncoding(info.encoding));
+
+    std::cout << "Benchmarking file: " << info.filename << std::endl;
+
+    for (bool memoryMapped : { false, true })
+    {
+        double fastestTime = std::numeric_limits<double>::max();
+        size_t recordCount = 0;
+        size_t refCount = 0;
+        size_t fileSize = 0;
+
+        for (int i = 0; i < std::max(info.iterations, 1); ++i)
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            ESM::ESMReader esm;
+            esm.setEncoder(&encoder);
+            esm.setMemoryMapped(memoryMapped);
+            esm.open(info.filename);
+
+            recordCount = 0;
+            refCount = 0;
+            fileSize = esm.getFileSize();
+
+            while (esm.hasMoreRecs())
+            {
+                const ESM::NAME n = esm.getRecName();
+                esm.getRecHeader();
+
+                std::unique_ptr<EsmTool::RecordBase> record(EsmTool::RecordBase::create(n));
+                if (record == nullptr)
+                {
+                    esm.skipRecord();
+                    continue;
+                }
+
+                record->load(esm);
+                recordCount++;
+
+                if (record->getType().intval == ESM::REC_CELL)
+                {
+                    ESM::Cell &cell = record->cast<ESM::Cell>()->get();
+                    cell.restore(esm, 0);
+
+                    ESM::CellRef ref;
+                    bool deleted = false;
+                    while (cell.getNextRef(esm, ref, deleted))
+                        refCount++;
+                }
+            }
+
+            fastestTime = std::min(fastestTime,
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        std::cout << (memoryMapped ? "Memory mapped: " : "Stream:        ") << recordCount << " records and "
+                  << refCount << " references in " << fastestTime * 1000 << " ms ("
+                  << fileSize / fastestTime / (1024 * 1024) << " MiB/s)" << std::endl;
+    }
+
+    return 0;
+}
+
+namespace
+{
+    // Writes single records the same way a content file or snapshot has them
+    class RecordSerializer
+    {
+    public:
+        RecordSerializer(ToUTF8::Utf8Encoder *encoder)
+        {
+            mWriter.setEncoder(encoder);
+            mWriter.setFormat(0);
+            mWriter.setVersion();
+            mWriter.save(mStream);
+        }
+
+        std::string write(EsmTool::RecordBase &record)
+        {
+            // Only NPCs and creatures keep a flag of their record header, which is written back
+            // to snapshots
+            const uint32_t type = record.getType().intval;
+            const uint32_t flags = (type == ESM::REC_NPC_ || type == ESM::REC_CREA) ? record.getFlags() & 0x0400 : 0;
+
+            mStream.str(std::string());
+            mWriter.startRecord(type, flags);
+            record.save(mWriter);
+            mWriter.endRecord(type);
+            return mStream.str();
+        }
+
+    private:
+        std::stringstream mStream;
+        ESM::ESMWriter mWriter;
+    };
+
+    // The records of one type merged from content files in the order the engine keeps them, along
+    // with each one written out
+    struct MergedRecords
+    {
+        typedef std::list<std::pair<std::string, std::string>> List;
+
+        List mRecords;
+        std::unordered_map<std::string, List::iterator> mIndex;
+    };
+
+    unsigned int getChecksum(const std::string &path)
+    {
+        boost::crc_32_type crc32;
+        boost::filesystem::ifstream stream(path, std::ios::binary);
+
+        if (!stream)
+            throw std::runtime_error("Could not open " + path);
+
+        char buffer[65536];
+
+        do
+        {
+            stream.read(buffer, sizeof(buffer));
+            crc32.process_bytes(buffer, stream.gcount());
+        } while (stream);
+
+        return crc32.checksum();
+    }
+
+    std::unique_ptr<EsmTool::RecordBase> loadRecord(ESM::ESMReader &esm, ESM::NAME type)
+    {
+        std::unique_ptr<EsmTool::RecordBase> record(EsmTool::RecordBase::create(type));
+
+        if (record == nullptr)
+            esm.fail("Unknown record type " + type.toString());
+
+        record->setFlags(esm.getRecordFlags());
+        record->load(esm);
+        record->setId(Misc::StringUtils::lowerCase(record->getId()));
+        return record;
+    }
+}
+
+// Merge the records of the content files the way the engine's stores do, independently of them, and
+// compare the result to the snapshot record by record
+int verify(Arguments& info)
+{
+    if (info.inputFiles.size() < 2)
+    {
+        std::cout << "You need to specify a snapshot followed by the content files it was made from" << std::endl;
+        return 1;
+    }
+
+    const size_t maxReportedDifferences = 20;
+
+    ToUTF8::Utf8Encoder encoder (ToUTF8::calculateEncoding(info.encoding));
+
+    ESM::ESMReader snapshotReader;
+    snapshotReader.setEncoder(&encoder);
+    snapshotReader.open(info.inputFiles[0]);
+
+    if (!snapshotReader.hasMoreRecs() || snapshotReader.getRecName().intval != ESM::StoreSnapshot::sRecordId)
+    {
+        std::cout << info.inputFiles[0] << " is not a snapshot" << std::endl;
+        return 1;
+    }
+
+    snapshotReader.getRecHeader();
+
+    ESM::StoreSnapshot snapshot;
+    snapshot.load(snapshotReader);
+
+    if (snapshot.mFormat != ESM::StoreSnapshot::sCurrentFormat)
+    {
+        std::cout << "The snapshot is in format " << snapshot.mFormat << ", but only format "
+                  << ESM::StoreSnapshot::sCurrentFormat << " can be verified" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Snapshot made by version " << snapshot.mEngineVersion << " from " << snapshot.mContentFiles.size()
+              << " content files, with " << snapshot.mRecordTypes.size() << " record types and "
+              << snapshot.mRefCounts.size() << " reference counts" << std::endl;
+
+    const std::vector<std::string> contentFiles(info.inputFiles.begin() + 1, info.inputFiles.end());
+
+    if (contentFiles.size() != snapshot.mContentFiles.size())
+    {
+        std::cout << "The snapshot was made from " << snapshot.mContentFiles.size() << " content files, but "
+                  << contentFiles.size() << " were given" << std::endl;
+        return 1;
+    }
+
+    size_t differences = 0;
+
+    for (size_t i = 0; i < contentFiles.size(); ++i)
+    {
+        const std::string name = boost::filesystem::path(contentFiles[i]).filename().string();
+        const unsigned int checksum = getChecksum(contentFiles[i]);
+        const ESM::StoreSnapshot::ContentFile &snapshotFile = snapshot.mContentFiles[i];
+
+        if (!Misc::StringUtils::ciEqual(name, snapshotFile.mName) || checksum != snapshotFile.mChecksum)
+        {
+            std::cout << "Content file " << i << " is " << name << " with checksum " << std::hex << checksum
+                      << ", but the snapshot was made from " << snapshotFile.mName << " with checksum "
+                      << snapshotFile.mChecksum << std::dec << std::endl;
+            differences++;
+        }
+    }
+
+    std::map<int, MergedRecords> mergedRecords;
+
+    for (int type : snapshot.mRecordTypes)
+        mergedRecords[type];
+
+    RecordSerializer serializer(&encoder);
+
+    for (const std::string &contentFile : contentFiles)
+    {
+        ESM::ESMReader esm;
+        esm.setEncoder(&encoder);
+        esm.open(contentFile);
+
+        while (esm.hasMoreRecs())
+        {
+            const ESM::NAME n = esm.getRecName();
+            esm.getRecHeader();
+
+            auto it = mergedRecords.find(n.intval);
+
+            if (it == mergedRecords.end())
+            {
+                esm.skipRecord();
+                continue;
+            }
+
+            std::unique_ptr<EsmTool::RecordBase> record = loadRecord(esm, n);
+            MergedRecords &merged = it->second;
+            auto indexIt = merged.mIndex.find(record->getId());
+
+            if (record->isDeleted())
+            {
+                if (indexIt != merged.mIndex.end())
+                {
+                    merged.mRecords.erase(indexIt->second);
+                    merged.mIndex.erase(indexIt);
+                }
+            }
+            else if (indexIt != merged.mIndex.end())
+                indexIt->second->second = serializer.write(*record);
+            else
+            {
+                merged.mRecords.emplace_back(record->getId(), serializer.write(*record));
+                merged.mIndex[record->getId()] = std::prev(merged.mRecords.end());
+            }
+        }
+    }
+
+    std::map<int, MergedRecords::List::const_iterator> positions;
+    size_t recordCount = 0;
+
+    for (const auto &merged : mergedRecords)
+        positions[merged.first] = merged.second.mRecords.begin();
+
+    const auto reportDifference = [&] (const std::string &difference)
+    {
+        if (differences++ < maxReportedDifferences)
+            std::cout << difference << std::endl;
+    };
+
+    while (snapshotReader.hasMoreRecs())
+    {
+        const ESM::NAME n = snapshotReader.getRecName();
+        snapshotReader.getRecHeader();
+
+        auto it = mergedRecords.find(n.intval);
+
+        if (it == mergedRecords.end())
+        {
+            reportDifference("Record of type " + n.toString() + " in the snapshot is not of a type listed in its header");
+            snapshotReader.skipRecord();
+            continue;
+        }
+
+        std::unique_ptr<EsmTool::RecordBase> record = loadRecord(snapshotReader, n);
+        MergedRecords::List::const_iterator &position = positions[n.intval];
+        recordCount++;
+
+        if (position == it->second.mRecords.end() || position->first != record->getId())
+        {
+            reportDifference(n.toString() + " record " + record->getId() +
+                " in the snapshot is not the next one merged from the content files");
+            continue;
+        }
+
+        if (position->second != serializer.write(*record))
+            reportDifference(n.toString() + " record " + record->getId() + " differs from the content files");
+
+        ++position;
+    }
+
+    for (const auto &merged : mergedRecords)
+    {
+        for (auto it = positions[merged.first]; it != merged.second.mRecords.end(); ++it)
+        {
+            ESM::NAME n;
+            n.intval = merged.first;
+            reportDifference(n.toString() + " record " + it->first + " from the content files is missing from the snapshot");
+        }
+    }
+
+    if (differences > maxReportedDifferences)
+        std::cout << "..." << std::endl;
+
+    if (differences > 0)
+    {
+        std::cout << "The snapshot doesn't match the content files, with " << differences << " differences" << std::endl;
+        return 1;
+    }
+
+    std::cout << "The snapshot matches the content files, with " << recordCount << " records" << std::endl;
+    return 0;
+}
+/*
+    End of tes3mp addition
+*/
@@ -1353,4 +1353,39 @@ std::string Record<ESM::Skill>::getId() const
     return std::string(); // No ID for Skill record
 }
 
+/*
+    Start of tes3mp addition
+
+    Make it possible to compare records the way the engine stores them, with their ids in
+    lower case and without the deleted ones
+*/
+template<>
+void Record<ESM::Cell>::setId(const std::string &id)
+{
+    mData.mName = id;
+}
+
+template<>
+void Record<ESM::Land>::setId(const std::string &id)
+{
+}
+
+template<>
+void Record<ESM::MagicEffect>::setId(const std::string &id)
+{
+}
+
+template<>
+void Record<ESM::Pathgrid>::setId(const std::string &id)
+{
+}
+
+template<>
+void Record<ESM::Skill>::setId(const std::string &id)
+{
+}
+/*
+    End of tes3mp addition
+*/
+
 } // end namespace
@@ -34,6 +34,18 @@ namespace EsmTool
 
         virtual std::string getId() const = 0;
 
+        /*
+            Start of tes3mp addition
+
+            Make it possible to compare records the way the engine stores them, with their ids in
+            lower case and without the deleted ones
+        */
+        virtual void setId(const std::string &id) = 0;
+        virtual bool isDeleted() const = 0;
+        /*
+            End of tes3mp addition
+        */
+
         uint32_t getFlags() const {
             return mFlags;
         }
@@ -78,6 +90,23 @@ namespace EsmTool
             return mData.mId;
         }
 
+        /*
+            Start of tes3mp addition
+
+            Make it possible to compare records the way the engine stores them, with their ids in
+            lower case and without the deleted ones
+        */
+        void setId(const std::string &id) override {
+            mData.mId = id;
+        }
+
+        bool isDeleted() const override {
+            return mIsDeleted;
+        }
+        /*
+            End of tes3mp addition
+        */
+
         T &get() {
             return mData;
         }
@@ -99,6 +128,21 @@ namespace EsmTool
     template<> std::string Record<ESM::Pathgrid>::getId() const;
     template<> std::string Record<ESM::Skill>::getId() const;
 
+    /*
+        Start of tes3mp addition
+
+        Make it possible to compare records the way the engine stores them, with their ids in
+        lower case and without the deleted ones
+    */
+    template<> void Record<ESM::Cell>::setId(const std::string &id);
+    template<> void Record<ESM::Land>::setId(const std::string &id);
+    template<> void Record<ESM::MagicEffect>::setId(const std::string &id);
+    template<> void Record<ESM::Pathgrid>::setId(const std::string &id);
+    template<> void Record<ESM::Skill>::setId(const std::string &id);
+    /*
+        End of tes3mp addition
+    */
+
     template<> void Record<ESM::Activator>::print();
     template<> void Record<ESM::Potion>::print();
     template<> void Record<ESM::Armor>::print();
@@ -3,12 +3,17 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 
 #include <iostream>
+#include "Networking.hpp"
 #include "Player.hpp"
 #include "Script/Script.hpp"
 
 Cell::Cell(ESM::Cell cell) : cell(cell)
 {
+    cellActorList.cell = cell;
     cellActorList.count = 0;
+    cellActorListRevision = actorStore.getRevision();
+    queuedActorPositions.cell = cell;
+    queuedActorPositions.count = 0;
 }
 
 Cell::Iterator Cell::begin() const
@@ -24,9 +29,7 @@ Cell::Iterator Cell::end() const
 void Cell::addPlayer(Player *player)
 {
     // Ensure the player hasn't already been added
-    auto it = find(begin(), end(), player);
-
-    if (it != end())
+    if (players.count(player) != 0)
     {
         LOG_APPEND(TimedLog::LOG_INFO, "- Attempt to add %s to Cell %s again was ignored", player->npc.mName.c_str(), getShortDescription().c_str());
         return;
@@ -44,121 +47,62 @@ void Cell::addPlayer(Player *player)
 
     Script::Call<Script::CallbackIdentity("OnCellLoad")>(player->getId(), getShortDescription().c_str());
 
-    players.push_back(player);
+    // The players already in this cell and the new one now have each other loaded
+    for (auto other : players)
+    {
+        player->addLoadedPlayer(other);
+        other->addLoadedPlayer(player);
+    }
+
+    players.insert(player);
+
+    sendActorSnapshot(player);
 }
 
 void Cell::removePlayer(Player *player, bool cleanPlayer)
 {
-    for (Iterator it = begin(); it != end(); it++)
-    {
-        if (*it == player)
-        {
-            if (cleanPlayer)
-            {
-                auto it2 = find(player->cells.begin(), player->cells.end(), this);
-                if (it2 != player->cells.end())
-                {
-                    LOG_APPEND(TimedLog::LOG_INFO, "- Removing %s from Player %s", getShortDescription().c_str(), player->npc.mName.c_str());
-
-                    player->cells.erase(it2);
-                }
-            }
+    auto it = players.find(player);
 
-            LOG_APPEND(TimedLog::LOG_INFO, "- Removing %s from Cell %s", player->npc.mName.c_str(), getShortDescription().c_str());
+    if (it == players.end())
+        return;
 
-            Script::Call<Script::CallbackIdentity("OnCellUnload")>(player->getId(), getShortDescription().c_str());
+    if (cleanPlayer)
+    {
+        auto it2 = find(player->cells.begin(), player->cells.end(), this);
+        if (it2 != player->cells.end())
+        {
+            LOG_APPEND(TimedLog::LOG_INFO, "- Removing %s from Player %s", getShortDescription().c_str(), player->npc.mName.c_str());
 
-            players.erase(it);
-            return;
+            player->cells.erase(it2);
         }
     }
-}
-
-void Cell::readActorList(unsigned char packetID, const mwmp::BaseActorList *newActorList)
-{
-    for (unsigned int i = 0; i < newActorList->count; i++)
-    {
-        mwmp::BaseActor newActor = newActorList->baseActors.at(i);
-        mwmp::BaseActor *cellActor;
 
-        if (containsActor(newActor.refNum, newActor.mpNum))
-        {
-            cellActor = getActor(newActor.refNum, newActor.mpNum);
-
-            switch (packetID)
-            {
-            case ID_ACTOR_POSITION:
+    LOG_APPEND(TimedLog::LOG_INFO, "- Removing %s from Cell %s", player->npc.mName.c_str(), getShortDescription().c_str());
 
-                cellActor->hasPositionData = true;
-                cellActor->position = newActor.position;
-                break;
+    Script::Call<Script::CallbackIdentity("OnCellUnload")>(player->getId(), getShortDescription().c_str());
 
-            case ID_ACTOR_STATS_DYNAMIC:
+    players.erase(it);
 
-                cellActor->hasStatsDynamicData = true;
-                cellActor->creatureStats.mDynamic[0] = newActor.creatureStats.mDynamic[0];
-                cellActor->creatureStats.mDynamic[1] = newActor.creatureStats.mDynamic[1];
-                cellActor->creatureStats.mDynamic[2] = newActor.creatureStats.mDynamic[2];
-                break;
-            }
-        }
-        else
-            cellActorList.baseActors.push_back(newActor);
+    for (auto other : players)
+    {
+        player->removeLoadedPlayer(other);
+        other->removeLoadedPlayer(player);
     }
-
-    cellActorList.count = cellActorList.baseActors.size();
 }
 
-bool Cell::containsActor(int refNum, int mpNum)
+void Cell::readActorList(unsigned char packetID, const mwmp::BaseActorList *newActorList)
 {
-    for (unsigned int i = 0; i < cellActorList.baseActors.size(); i++)
-    {
-        mwmp::BaseActor actor = cellActorList.baseActors.at(i);
-
-        if (actor.refNum == refNum && actor.mpNum == mpNum)
-            return true;
-    }
-    return false;
+    actorStore.read(packetID, *newActorList);
 }
 
-mwmp::BaseActor *Cell::getActor(int refNum, int mpNum)
+bool Cell::containsActor(int refNum, int mpNum)
 {
-    for (unsigned int i = 0; i < cellActorList.baseActors.size(); i++)
-    {
-        mwmp::BaseActor *actor = &cellActorList.baseActors.at(i);
-
-        if (actor->refNum == refNum && actor->mpNum == mpNum)
-            return actor;
-    }
-    return 0;
+    return actorStore.contains(refNum, mpNum);
 }
 
 void Cell::removeActors(const mwmp::BaseActorList *newActorList)
 {
-    for (std::vector<mwmp::BaseActor>::iterator it = cellActorList.baseActors.begin(); it != cellActorList.baseActors.end();)
-    {
-        int refNum = (*it).refNum;
-        int mpNum = (*it).mpNum;
-
-        bool foundActor = false;
-
-        for (unsigned int i = 0; i < newActorList->count; i++)
-        {
-            mwmp::BaseActor newActor = newActorList->baseActors.at(i);
-
-            if (newActor.refNum == refNum && newActor.mpNum == mpNum)
-            {
-                it = cellActorList.baseActors.erase(it);
-                foundActor = true;
-                break;
-            }
-        }
-
-        if (!foundActor)
-            it++;
-    }
-
-    cellActorList.count = cellActorList.baseActors.size();
+    actorStore.remove(*newActorList);
 }
 
 RakNet::RakNetGUID *Cell::getAuthority()
@@ -169,13 +113,49 @@ RakNet::RakNetGUID *Cell::getAuthority()
 void Cell::setAuthority(const RakNet::RakNetGUID& guid)
 {
     authorityGuid = guid;
+
+    // Positions queued from the previous authority are no longer relevant
+    queuedActorPositions.baseActors.clear();
+    queuedActorIndexes.clear();
+}
+
+bool Cell::hasAuthority() const
+{
+    for (auto player : players)
+    {
+        if (player->guid == authorityGuid)
+            return true;
+    }
+
+    return false;
 }
 
 mwmp::BaseActorList *Cell::getActorList()
 {
+    if (cellActorListRevision != actorStore.getRevision())
+    {
+        actorStore.fillActorList(cellActorList);
+        cellActorListRevision = actorStore.getRevision();
+    }
+
     return &cellActorList;
 }
 
+void Cell::sendActorSnapshot(Player *player)
+{
+    if (actorStore.empty() || player->guid == authorityGuid || !hasAuthority())
+        return;
+
+    mwmp::BaseActorList *actorList = getActorList();
+    actorList->guid = authorityGuid;
+    actorList->timestamp = mwmp::Networking::get().getPositionTimestamp();
+
+    mwmp::ActorPacket *actorPacket = mwmp::Networking::get().getActorPacketController()->GetPacket(ID_ACTOR_SNAPSHOT);
+    actorPacket->setActorList(actorList);
+
+    mwmp::Networking::getPtr()->getPacketBatcher()->queue(player->guid, actorPacket->Serialize());
+}
+
 Cell::TPlayers Cell::getPlayers() const
 {
     return players;
@@ -186,25 +166,30 @@ void Cell::sendToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *bas
     if (players.empty())
         return;
 
-    std::list <Player*> plList;
+    actorPacket->setActorList(baseActorList);
 
-    for (auto pl : players)
-    {
-        if (pl != nullptr && !pl->npc.mName.empty())
-            plList.push_back(pl);
-    }
+    PacketBatcher *packetBatcher = mwmp::Networking::getPtr()->getPacketBatcher();
 
-    plList.sort();
-    plList.unique();
+    // Only serialize the packet once, and only if it has at least one eligible recipient
+    mwmp::SerializedPacketPtr serializedPacket;
 
-    for (auto pl : plList)
+    for (auto pl : players)
     {
-        if (pl->guid == baseActorList->guid) continue;
+        if (pl == nullptr || pl->npc.mName.empty() || pl->guid == baseActorList->guid) continue;
+
+        if (actorPacket->usesDeltaState())
+        {
+            actorPacket->setDeltaState(pl->getPositionDeltaState());
+            packetBatcher->queue(pl->guid, actorPacket->Serialize());
+            actorPacket->setDeltaState(nullptr);
+            continue;
+        }
 
-        actorPacket->setActorList(baseActorList);
+        if (!serializedPacket)
+            serializedPacket = actorPacket->Serialize();
 
-        // Send the packet to this eligible guid
-        actorPacket->Send(pl->guid);
+        // Send the packet to this eligible guid at the end of the tick
+        packetBatcher->queue(pl->guid, serializedPacket);
     }
 }
 
@@ -213,28 +198,59 @@ void Cell::sendToLoaded(mwmp::ObjectPacket *objectPacket, mwmp::BaseObjectList *
     if (players.empty())
         return;
 
-    std::list <Player*> plList;
+    objectPacket->setObjectList(baseObjectList);
+
+    PacketBatcher *packetBatcher = mwmp::Networking::getPtr()->getPacketBatcher();
+
+    // Only serialize the packet once, and only if it has at least one eligible recipient
+    mwmp::SerializedPacketPtr serializedPacket;
 
     for (auto pl : players)
     {
-        if (pl != nullptr && !pl->npc.mName.empty())
-            plList.push_back(pl);
+        if (pl == nullptr || pl->npc.mName.empty() || pl->guid == baseObjectList->guid) continue;
+
+        if (!serializedPacket)
+            serializedPacket = objectPacket->Serialize();
+
+        // Send the packet to this eligible guid at the end of the tick
+        packetBatcher->queue(pl->guid, serializedPacket);
     }
+}
 
-    plList.sort();
-    plList.unique();
+void Cell::queueActorPositions(const mwmp::BaseActorList *newActorList)
+{
+    queuedActorPositions.guid = newActorList->guid;
 
-    for (auto pl : plList)
+    for (auto &&newActor : newActorList->baseActors)
     {
-        if (pl->guid == baseObjectList->guid) continue;
-
-        objectPacket->setObjectList(baseObjectList);
+        mwmp::ActorKey actorKey = mwmp::getActorKey(newActor.refNum, newActor.mpNum);
+        auto it = queuedActorIndexes.find(actorKey);
 
-        // Send the packet to this eligible guid
-        objectPacket->Send(pl->guid);
+        if (it != queuedActorIndexes.end())
+            queuedActorPositions.baseActors[it->second] = newActor;
+        else
+        {
+            queuedActorIndexes[actorKey] = queuedActorPositions.baseActors.size();
+            queuedActorPositions.baseActors.push_back(newActor);
+        }
     }
 }
 
+void Cell::sendQueuedActorPositions()
+{
+    if (queuedActorPositions.baseActors.empty())
+        return;
+
+    mwmp::ActorPacket *actorPacket = mwmp::Networking::get().getActorPacketController()->GetPacket(ID_ACTOR_POSITION);
+
+    queuedActorPositions.count = (unsigned int) queuedActorPositions.baseActors.size();
+    queuedActorPositions.timestamp = mwmp::Networking::get().getPositionTimestamp();
+    sendToLoaded(actorPacket, &queuedActorPositions);
+
+    queuedActorPositions.baseActors.clear();
+    queuedActorIndexes.clear();
+}
+
 std::string Cell::getShortDescription() const
 {
     return cell.getShortDescription();
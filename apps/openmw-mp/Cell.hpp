@@ -1,14 +1,19 @@
 #ifndef OPENMW_SERVERCELL_HPP
 #define OPENMW_SERVERCELL_HPP
 
-#include <deque>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <components/esm/records.hpp>
+#include <components/openmw-mp/ActorKey.hpp>
 #include <components/openmw-mp/Base/BaseActor.hpp>
 #include <components/openmw-mp/Base/BaseObject.hpp>
 #include <components/openmw-mp/Packets/Actor/ActorPacket.hpp>
 #include <components/openmw-mp/Packets/Object/ObjectPacket.hpp>
 
+#include "CellActorStore.hpp"
+
 class Player;
 class Cell;
 
@@ -17,7 +22,7 @@ class Cell
     friend class CellController;
 public:
     Cell(ESM::Cell cell);
-    typedef std::deque<Player*> TPlayers;
+    typedef std::unordered_set<Player*> TPlayers;
     typedef TPlayers::const_iterator Iterator;
 
     Iterator begin() const;
@@ -28,17 +33,30 @@ public:
 
     void readActorList(unsigned char packetID, const mwmp::BaseActorList *newActorList);
     bool containsActor(int refNum, int mpNum);
-    mwmp::BaseActor *getActor(int refNum, int mpNum);
     void removeActors(const mwmp::BaseActorList *newActorList);
 
     RakNet::RakNetGUID *getAuthority();
     void setAuthority(const RakNet::RakNetGUID& guid);
+    // Whether the authority is one of the players in this cell, which it stops being when it leaves
+    // until the scripts pick another one
+    bool hasAuthority() const;
+    // Get the stored actors as an actor list, which is only rebuilt when they have changed
     mwmp::BaseActorList *getActorList();
 
+    // Send the stored actors to a player who has just loaded this cell as a single ID_ACTOR_SNAPSHOT,
+    // instead of leaving them without that data until the authority next sends it, unless there is
+    // no authority to keep that data up to date
+    void sendActorSnapshot(Player *player);
+
     TPlayers getPlayers() const;
     void sendToLoaded(mwmp::ActorPacket *actorPacket, mwmp::BaseActorList *baseActorList) const;
     void sendToLoaded(mwmp::ObjectPacket *objectPacket, mwmp::BaseObjectList *baseObjectList) const;
 
+    // Actor positions received during a tick are only sent to the cell's players at its end,
+    // so a newer position for an actor replaces the one before it
+    void queueActorPositions(const mwmp::BaseActorList *newActorList);
+    void sendQueuedActorPositions();
+
     std::string getShortDescription() const;
 
 
@@ -47,7 +65,12 @@ private:
     ESM::Cell cell;
 
     RakNet::RakNetGUID authorityGuid;
+    CellActorStore actorStore;
     mwmp::BaseActorList cellActorList;
+    unsigned int cellActorListRevision;
+
+    mwmp::BaseActorList queuedActorPositions;
+    std::unordered_map<mwmp::ActorKey, size_t> queuedActorIndexes;
 };
 
 
@@ -0,0 +1,145 @@
+#include "CellActorStore.hpp"
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+
+#include <utility>
+
+CellActorStore::CellActorStore() : revision(0)
+{
+
+}
+
+void CellActorStore::read(unsigned char packetID, const mwmp::BaseActorList &actorList)
+{
+    for (const auto &newActor : actorList.baseActors)
+    {
+        // Only keep the parts of actor updates that are also sent on their own
+        if (packetID == ID_ACTOR_UPDATE && !(newActor.updateFlags & mwmp::BaseActor::UPDATE_STATS_DYNAMIC))
+            continue;
+
+        std::size_t index = getOrAdd(newActor);
+
+        switch (packetID)
+        {
+        case ID_ACTOR_POSITION:
+
+            positions[index] = newActor.position;
+            directions[index] = newActor.direction;
+            hasPositions[index] = true;
+            break;
+
+        case ID_ACTOR_STATS_DYNAMIC:
+        case ID_ACTOR_UPDATE:
+
+            statsDynamic[index].mDynamic[0] = newActor.creatureStats.mDynamic[0];
+            statsDynamic[index].mDynamic[1] = newActor.creatureStats.mDynamic[1];
+            statsDynamic[index].mDynamic[2] = newActor.creatureStats.mDynamic[2];
+            hasStatsDynamic[index] = true;
+            break;
+        }
+    }
+
+    revision++;
+}
+
+void CellActorStore::remove(const mwmp::BaseActorList &actorList)
+{
+    for (const auto &actor : actorList.baseActors)
+    {
+        auto it = indexes.find(mwmp::getActorKey(actor.refNum, actor.mpNum));
+
+        if (it == indexes.end())
+            continue;
+
+        const std::size_t index = it->second;
+        const std::size_t lastIndex = keys.size() - 1;
+
+        indexes.erase(it);
+
+        if (index != lastIndex)
+        {
+            keys[index] = keys[lastIndex];
+            refIds[index] = std::move(refIds[lastIndex]);
+            positions[index] = positions[lastIndex];
+            directions[index] = directions[lastIndex];
+            hasPositions[index] = hasPositions[lastIndex];
+            statsDynamic[index] = statsDynamic[lastIndex];
+            hasStatsDynamic[index] = hasStatsDynamic[lastIndex];
+
+            indexes[keys[index]] = index;
+        }
+
+        keys.pop_back();
+        refIds.pop_back();
+        positions.pop_back();
+        directions.pop_back();
+        hasPositions.pop_back();
+        statsDynamic.pop_back();
+        hasStatsDynamic.pop_back();
+    }
+
+    revision++;
+}
+
+bool CellActorStore::contains(unsigned int refNum, unsigned int mpNum) const
+{
+    return indexes.count(mwmp::getActorKey(refNum, mpNum)) != 0;
+}
+
+bool CellActorStore::empty() const
+{
+    return keys.empty();
+}
+
+unsigned int CellActorStore::getRevision() const
+{
+    return revision;
+}
+
+void CellActorStore::fillActorList(mwmp::BaseActorList &actorList) const
+{
+    actorList.baseActors.clear();
+    actorList.baseActors.resize(keys.size());
+
+    for (std::size_t i = 0; i < keys.size(); i++)
+    {
+        mwmp::BaseActor &actor = actorList.baseActors[i];
+
+        actor.refNum = static_cast<unsigned int>(keys[i] >> 32);
+        actor.mpNum = static_cast<unsigned int>(keys[i]);
+        actor.refId = refIds[i];
+
+        actor.hasPositionData = hasPositions[i];
+        actor.position = positions[i];
+        actor.direction = directions[i];
+
+        actor.hasStatsDynamicData = hasStatsDynamic[i];
+        actor.creatureStats.mDynamic[0] = statsDynamic[i].mDynamic[0];
+        actor.creatureStats.mDynamic[1] = statsDynamic[i].mDynamic[1];
+        actor.creatureStats.mDynamic[2] = statsDynamic[i].mDynamic[2];
+    }
+
+    actorList.count = (unsigned int) actorList.baseActors.size();
+}
+
+std::size_t CellActorStore::getOrAdd(const mwmp::BaseActor &actor)
+{
+    const mwmp::ActorKey key = mwmp::getActorKey(actor.refNum, actor.mpNum);
+    auto it = indexes.find(key);
+
+    if (it != indexes.end())
+        return it->second;
+
+    const std::size_t index = keys.size();
+    indexes.emplace(key, index);
+
+    keys.push_back(key);
+    refIds.push_back(actor.refId);
+    positions.push_back(actor.position);
+    directions.push_back(actor.direction);
+    hasPositions.push_back(false);
+    statsDynamic.push_back(actor.creatureStats);
+    hasStatsDynamic.push_back(false);
+
+    return index;
+}
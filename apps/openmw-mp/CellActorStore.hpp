@@ -0,0 +1,59 @@
+#ifndef OPENMW_CELLACTORSTORE_HPP
+#define OPENMW_CELLACTORSTORE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <components/esm/defs.hpp>
+#include <components/openmw-mp/ActorKey.hpp>
+#include <components/openmw-mp/Base/BaseActor.hpp>
+
+/*
+    The last known state of the actors in a cell, as reported by the cell's authority
+
+    Actors are found through a hash index keyed by their refNum and mpNum, while their data is kept
+    in separate densely packed arrays, so updating one kind of data or building a snapshot only
+    goes through the memory holding that kind of data. Removing an actor moves the last one into
+    its place to keep the arrays dense
+*/
+class CellActorStore
+{
+public:
+    CellActorStore();
+
+    // Store the data from an ID_ACTOR_POSITION or ID_ACTOR_STATS_DYNAMIC packet, adding actors
+    // that are not stored yet
+    void read(unsigned char packetID, const mwmp::BaseActorList &actorList);
+    void remove(const mwmp::BaseActorList &actorList);
+
+    bool contains(unsigned int refNum, unsigned int mpNum) const;
+    bool empty() const;
+
+    // Incremented every time the stored data changes
+    unsigned int getRevision() const;
+
+    // Replace the actors in an actor list with the stored ones
+    void fillActorList(mwmp::BaseActorList &actorList) const;
+
+private:
+    std::size_t getOrAdd(const mwmp::BaseActor &actor);
+
+    std::unordered_map<mwmp::ActorKey, std::size_t> indexes;
+
+    std::vector<mwmp::ActorKey> keys;
+    std::vector<std::string> refIds;
+
+    std::vector<ESM::Position> positions;
+    std::vector<ESM::Position> directions;
+    std::vector<bool> hasPositions;
+
+    std::vector<mwmp::SimpleCreatureStats> statsDynamic;
+    std::vector<bool> hasStatsDynamic;
+
+    unsigned int revision;
+};
+
+#endif //OPENMW_CELLACTORSTORE_HPP
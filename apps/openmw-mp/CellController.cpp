@@ -12,8 +12,11 @@ CellController::CellController()
 
 CellController::~CellController()
 {
-    for (auto cell : cells)
-        delete cell;
+    for (auto &&cell : exteriorCells)
+        delete cell.second;
+
+    for (auto &&cell : interiorCells)
+        delete cell.second;
 }
 
 CellController *CellController::sThis = nullptr;
@@ -48,66 +51,46 @@ Cell *CellController::getCell(ESM::Cell *esmCell)
 
 Cell *CellController::getCellByXY(int x, int y)
 {
-    auto it = find_if(cells.begin(), cells.end(), [x, y](const Cell *c)
-    {
-        return c->cell.mData.mX == x && c->cell.mData.mY == y;
-    });
+    auto it = exteriorCells.find(getExteriorKey(x, y));
 
-    if (it == cells.end())
+    if (it == exteriorCells.end())
     {
         LOG_APPEND(TimedLog::LOG_INFO, "- Attempt to get Cell at %i, %i failed!", x, y);
         return nullptr;
     }
 
-    return *it;
+    return it->second;
 }
 
-Cell *CellController::getCellByName(std::string cellName)
+Cell *CellController::getCellByName(const std::string &cellName)
 {
-    auto it = find_if(cells.begin(), cells.end(), [cellName](const Cell *c)
-    {
-        return c->cell.mName == cellName;
-    });
+    auto it = interiorCells.find(cellName);
 
-    if (it == cells.end())
+    if (it == interiorCells.end())
     {
         LOG_APPEND(TimedLog::LOG_INFO, "- Attempt to get Cell at %s failed!", cellName.c_str());
         return nullptr;
     }
 
-    return *it;
+    return it->second;
 }
 
 Cell *CellController::addCell(ESM::Cell cellData)
 {
-    LOG_APPEND(TimedLog::LOG_INFO, "- Loaded cells: %d", cells.size());
-    auto it = find_if(cells.begin(), cells.end(), [cellData](const Cell *c) {
-        // Currently we cannot compare because plugin lists can be loaded in different order
-        //return c->cell.sRecordId == cellData.sRecordId;
-        if (c->cell.isExterior() && cellData.isExterior())
-        {
-            if (c->cell.mData.mX == cellData.mData.mX && c->cell.mData.mY == cellData.mData.mY)
-                return true;
-        }
-        else if (c->cell.mName == cellData.mName)
-            return true;
+    LOG_APPEND(TimedLog::LOG_INFO, "- Loaded cells: %d", exteriorCells.size() + interiorCells.size());
 
-        return false;
-    });
+    // Currently we cannot compare record IDs because plugin lists can be loaded in different order
+    Cell *&cell = cellData.isExterior() ? exteriorCells[getExteriorKey(cellData.mData.mX, cellData.mData.mY)] :
+        interiorCells[cellData.mName];
 
-    Cell *cell;
-    if (it == cells.end())
+    if (cell == nullptr)
     {
         LOG_APPEND(TimedLog::LOG_INFO, "- Adding %s to CellController", cellData.getShortDescription().c_str());
 
         cell = new Cell(cellData);
-        cells.push_back(cell);
     }
     else
-    {
         LOG_APPEND(TimedLog::LOG_INFO, "- Found %s in CellController", cellData.getShortDescription().c_str());
-        cell = *it;
-    }
 
     return cell;
 }
@@ -117,18 +100,35 @@ void CellController::removeCell(Cell *cell)
     if (cell == nullptr)
         return;
 
-    for (auto it = cells.begin(); it != cells.end();)
+    bool wasErased = false;
+
+    if (cell->cell.isExterior())
     {
-        if (*it != nullptr && *it == cell)
+        auto it = exteriorCells.find(getExteriorKey(cell->cell.mData.mX, cell->cell.mData.mY));
+        if (it != exteriorCells.end() && it->second == cell)
         {
-            Script::Call<Script::CallbackIdentity("OnCellDeletion")>(cell->getShortDescription().c_str());
-            LOG_APPEND(TimedLog::LOG_INFO, "- Removing %s from CellController", cell->getShortDescription().c_str());
-
-            delete *it;
-            it = cells.erase(it);
+            exteriorCells.erase(it);
+            wasErased = true;
+        }
+    }
+    else
+    {
+        auto it = interiorCells.find(cell->cell.mName);
+        if (it != interiorCells.end() && it->second == cell)
+        {
+            interiorCells.erase(it);
+            wasErased = true;
         }
-        else
-            ++it;
+    }
+
+    if (wasErased)
+    {
+        cellsWithQueuedPositions.erase(cell);
+
+        Script::Call<Script::CallbackIdentity("OnCellDeletion")>(cell->getShortDescription().c_str());
+        LOG_APPEND(TimedLog::LOG_INFO, "- Removing %s from CellController", cell->getShortDescription().c_str());
+
+        delete cell;
     }
 }
 
@@ -189,3 +189,22 @@ void CellController::update(Player *player)
         removeCell(cell);
     }
 }
+
+void CellController::queueActorPositions(Cell *cell, const mwmp::BaseActorList *actorList)
+{
+    cell->queueActorPositions(actorList);
+    cellsWithQueuedPositions.insert(cell);
+}
+
+void CellController::sendQueuedActorPositions()
+{
+    for (auto &&cell : cellsWithQueuedPositions)
+        cell->sendQueuedActorPositions();
+
+    cellsWithQueuedPositions.clear();
+}
+
+uint64_t CellController::getExteriorKey(int x, int y)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+}
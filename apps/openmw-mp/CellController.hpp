@@ -1,9 +1,13 @@
 #ifndef OPENMW_SERVERCELLCONTROLLER_HPP
 #define OPENMW_SERVERCELLCONTROLLER_HPP
 
+#include <cstdint>
 #include <deque>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <components/esm/records.hpp>
+#include <components/misc/stringops.hpp>
 #include <components/openmw-mp/Base/BaseObject.hpp>
 #include <components/openmw-mp/Packets/Actor/ActorPacket.hpp>
 #include <components/openmw-mp/Packets/Object/ObjectPacket.hpp>
@@ -34,13 +38,24 @@ public:
 
     Cell *getCell(ESM::Cell *esmCell);
     Cell *getCellByXY(int x, int y);
-    Cell *getCellByName(std::string cellName);
+    Cell *getCellByName(const std::string &cellName);
 
     void update(Player *player);
 
+    void queueActorPositions(Cell *cell, const mwmp::BaseActorList *actorList);
+    void sendQueuedActorPositions();
+
 private:
+    static uint64_t getExteriorKey(int x, int y);
+
     static CellController *sThis;
-    TContainer cells;
+
+    // Exterior cells are hashed by their grid coordinates and interior cells by their
+    // case-insensitive names, so looking up a cell doesn't depend on how many are loaded
+    std::unordered_map<uint64_t, Cell*> exteriorCells;
+    std::unordered_map<std::string, Cell*, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual> interiorCells;
+
+    std::unordered_set<Cell*> cellsWithQueuedPositions;
 };
 
 #endif //OPENMW_SERVERCELLCONTROLLER_HPP
@@ -34,6 +34,18 @@ static bool dataFileEnforcementState = true;
 static bool scriptErrorIgnoringState = false;
 bool killLoop = false;
 
+// Send what the batcher holds for the destination of a packet that is about to be sent right away
+// on the same ordering channel, so packets on each channel keep the order they were sent in
+static void flushBatchesBeforeSend(const RakNet::AddressOrGUID &destination, bool broadcast, int8_t orderChannel)
+{
+    PacketBatcher *packetBatcher = Networking::getPtr()->getPacketBatcher();
+
+    if (broadcast || destination.rakNetGuid == RakNet::UNASSIGNED_RAKNET_GUID)
+        packetBatcher->flush(orderChannel);
+    else
+        packetBatcher->flush(destination.rakNetGuid, orderChannel);
+}
+
 Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
 {
     sThis = this;
@@ -48,6 +60,20 @@ Networking::Networking(RakNet::RakPeerInterface *peer) : mclient(nullptr)
     objectPacketController = new ObjectPacketController(peer);
     worldstatePacketController = new WorldstatePacketController(peer);
 
+    dispatchTable.addController(PacketDispatchTable::Category::System, *systemPacketController);
+    dispatchTable.addController(PacketDispatchTable::Category::Player, *playerPacketController);
+    dispatchTable.addController(PacketDispatchTable::Category::Actor, *actorPacketController);
+    dispatchTable.addController(PacketDispatchTable::Category::Object, *objectPacketController);
+    dispatchTable.addController(PacketDispatchTable::Category::Worldstate, *worldstatePacketController);
+
+    packetBatcher = new PacketBatcher(peer);
+    BasePacket::setBeforeSendCallback(&flushBatchesBeforeSend);
+    tickRate = 60;
+    startTime = std::chrono::steady_clock::now();
+
+    packetDecoder = nullptr;
+    decoderThreads = 0;
+
     // Set send stream
     systemPacketController->SetStream(0, &bsOut);
     playerPacketController->SetStream(0, &bsOut);
@@ -77,6 +103,9 @@ Networking::~Networking()
     delete actorPacketController;
     delete objectPacketController;
     delete worldstatePacketController;
+
+    BasePacket::setBeforeSendCallback(nullptr);
+    delete packetBatcher;
 }
 
 void Networking::setServerPassword(std::string password) noexcept
@@ -132,6 +161,17 @@ void Networking::processSystemPacket(RakNet::Packet *packet)
         player->setHandshake();
         return;
     }
+    else if (packet->data[0] == ID_SYSTEM_RECORD_ID_RESET)
+    {
+        if (!player->isHandshaked())
+            return;
+
+        myPacket->setSystem(&baseSystem);
+        myPacket->Read();
+
+        if (myPacket->isPacketValid())
+            player->getRecordIdState()->resetWrite(baseSystem.recordIdEpoch);
+    }
 }
 
 void Networking::processPlayerPacket(RakNet::Packet *packet)
@@ -154,7 +194,8 @@ void Networking::processPlayerPacket(RakNet::Packet *packet)
         return;
     }
 
-    if (packet->data[0] == ID_LOADED)
+    // A player only finishes loading once, so their load state never goes back
+    if (packet->data[0] == ID_LOADED && player->getLoadState() == Player::NOTLOADED)
     {
         player->setLoadState(Player::LOADED);
 
@@ -183,6 +224,9 @@ void Networking::processPlayerPacket(RakNet::Packet *packet)
     else if (player->getLoadState() == Player::LOADED)
     {
         player->setLoadState(Player::POSTLOADED);
+
+        // Every packet of theirs is read from now on, so their record ids can go through the tables
+        sendRecordIdReset(player);
         newPlayer(packet->guid);
         return;
     }
@@ -197,10 +241,17 @@ void Networking::processActorPacket(RakNet::Packet *packet)
 {
     Player *player = Players::getPlayer(packet->guid);
 
-    if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
+    if (!player->isReadingWorldPackets())
         return;
 
-    if (!ActorProcessor::Process(*packet, baseActorList))
+    bool isHandled;
+
+    if (packetDecoder != nullptr && packetDecoder->takeDecodedActorList(packet, baseActorList))
+        isHandled = ActorProcessor::Apply(*packet, baseActorList);
+    else
+        isHandled = ActorProcessor::Process(*packet, baseActorList);
+
+    if (!isHandled)
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ActorPacket with identifier %i has arrived", packet->data[0]);
 
 }
@@ -209,10 +260,17 @@ void Networking::processObjectPacket(RakNet::Packet *packet)
 {
     Player *player = Players::getPlayer(packet->guid);
 
-    if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
+    if (!player->isReadingWorldPackets())
         return;
 
-    if (!ObjectProcessor::Process(*packet, baseObjectList))
+    bool isHandled;
+
+    if (packetDecoder != nullptr && packetDecoder->takeDecodedObjectList(packet, baseObjectList))
+        isHandled = ObjectProcessor::Apply(*packet, baseObjectList);
+    else
+        isHandled = ObjectProcessor::Process(*packet, baseObjectList);
+
+    if (!isHandled)
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ObjectPacket with identifier %i has arrived", packet->data[0]);
 
 }
@@ -221,7 +279,11 @@ void Networking::processWorldstatePacket(RakNet::Packet *packet)
 {
     Player *player = Players::getPlayer(packet->guid);
 
-    if (!player->isHandshaked() || player->getLoadState() != Player::POSTLOADED)
+    if (!player->isHandshaked())
+        return;
+
+    // The records a player has cached are sent while it is still joining
+    if (player->getLoadState() != Player::POSTLOADED && packet->data[0] != ID_RECORD_CACHE)
         return;
 
     if (!WorldstateProcessor::Process(*packet, baseWorldstate))
@@ -294,8 +356,10 @@ bool Networking::preInit(RakNet::Packet *packet, RakNet::BitStream &bsIn)
         packetPreInit.setChecksums(&tmp);
         packetPreInit.Send(packet->systemAddress);
         Players::newPlayer(packet->guid); // create player if connection allowed
-        systemPacketController->SetStream(&bsIn, nullptr); // and request handshake
-        systemPacketController->GetPacket(ID_SYSTEM_HANDSHAKE)->RequestData(packet->guid);
+        // and request handshake
+        SystemPacket *handshakePacket = systemPacketController->GetPacket(ID_SYSTEM_HANDSHAKE);
+        handshakePacket->SetReadStream(&bsIn);
+        handshakePacket->RequestData(packet->guid);
         return true;
     }
 
@@ -304,33 +368,32 @@ bool Networking::preInit(RakNet::Packet *packet, RakNet::BitStream &bsIn)
 
 void Networking::update(RakNet::Packet *packet, RakNet::BitStream &bsIn)
 {
-    if (systemPacketController->ContainsPacket(packet->data[0]))
-    {
-        systemPacketController->SetStream(&bsIn, nullptr);
-        processSystemPacket(packet);
-    }
-    else if (playerPacketController->ContainsPacket(packet->data[0]))
-    {
-        playerPacketController->SetStream(&bsIn, nullptr);
-        processPlayerPacket(packet);
-    }
-    else if (actorPacketController->ContainsPacket(packet->data[0]))
-    {
-        actorPacketController->SetStream(&bsIn, 0);
-        processActorPacket(packet);
-    }
-    else if (objectPacketController->ContainsPacket(packet->data[0]))
-    {
-        objectPacketController->SetStream(&bsIn, 0);
-        processObjectPacket(packet);
-    }
-    else if (worldstatePacketController->ContainsPacket(packet->data[0]))
+    const PacketDispatchTable::Entry &entry = dispatchTable.get(packet->data[0]);
+
+    // Only the packet being processed needs to read from this stream
+    if (entry.packet != nullptr)
+        entry.packet->SetReadStream(&bsIn);
+
+    switch (entry.category)
     {
-        worldstatePacketController->SetStream(&bsIn, 0);
-        processWorldstatePacket(packet);
+        case PacketDispatchTable::Category::System:
+            processSystemPacket(packet);
+            break;
+        case PacketDispatchTable::Category::Player:
+            processPlayerPacket(packet);
+            break;
+        case PacketDispatchTable::Category::Actor:
+            processActorPacket(packet);
+            break;
+        case PacketDispatchTable::Category::Object:
+            processObjectPacket(packet);
+            break;
+        case PacketDispatchTable::Category::Worldstate:
+            processWorldstatePacket(packet);
+            break;
+        default:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled RakNet packet with identifier %i has arrived", packet->data[0]);
     }
-    else
-        LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled RakNet packet with identifier %i has arrived", packet->data[0]);
 }
 
 void Networking::newPlayer(RakNet::RakNetGUID guid)
@@ -357,6 +420,9 @@ void Networking::newPlayer(RakNet::RakNetGUID guid)
         // If we are iterating over a player who has inputted their name, proceed
         else if (pl->second->getLoadState() == Player::POSTLOADED)
         {
+            // The new player snaps to where the others are instead of interpolating toward them
+            pl->second->positionTimestamp = 0;
+
             playerPacketController->GetPacket(ID_PLAYER_BASEINFO)->setPlayer(pl->second);
             playerPacketController->GetPacket(ID_PLAYER_STATS_DYNAMIC)->setPlayer(pl->second);
             playerPacketController->GetPacket(ID_PLAYER_ATTRIBUTE)->setPlayer(pl->second);
@@ -379,6 +445,16 @@ void Networking::newPlayer(RakNet::RakNetGUID guid)
 
 }
 
+void Networking::sendRecordIdReset(Player *player)
+{
+    baseSystem.guid = player->guid;
+    baseSystem.recordIdEpoch = player->getRecordIdState()->resetRead();
+
+    SystemPacket *myPacket = systemPacketController->GetPacket(ID_SYSTEM_RECORD_ID_RESET);
+    myPacket->setSystem(&baseSystem);
+    myPacket->Send(false);
+}
+
 void Networking::disconnectPlayer(RakNet::RakNetGUID guid)
 {
     Player *player = Players::getPlayer(guid);
@@ -495,10 +571,69 @@ void signalHandler(int signum)
     }
 }
 
+void Networking::processPacket(RakNet::Packet *packet)
+{
+    if (getMasterClient()->Process(packet))
+        return;
+
+    switch (packet->data[0])
+    {
+        case ID_REMOTE_DISCONNECTION_NOTIFICATION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has disconnected", packet->systemAddress.ToString());
+            break;
+        case ID_REMOTE_CONNECTION_LOST:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
+            break;
+        case ID_REMOTE_NEW_INCOMING_CONNECTION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has connected", packet->systemAddress.ToString());
+            break;
+        case ID_CONNECTION_REQUEST_ACCEPTED:    // client to server
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Our connection request has been accepted");
+            break;
+        }
+        case ID_NEW_INCOMING_CONNECTION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "A connection is incoming from %s", packet->systemAddress.ToString());
+            break;
+        case ID_NO_FREE_INCOMING_CONNECTIONS:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "The server is full");
+            break;
+        case ID_DISCONNECTION_NOTIFICATION:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN,  "Client at %s has disconnected", packet->systemAddress.ToString());
+            disconnectPlayer(packet->guid);
+            break;
+        case ID_CONNECTION_LOST:
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
+            disconnectPlayer(packet->guid);
+            break;
+        case ID_SND_RECEIPT_ACKED:
+        case ID_CONNECTED_PING:
+        case ID_UNCONNECTED_PING:
+            break;
+        default:
+        {
+            RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
+            bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+
+
+            if (Players::doesPlayerExist(packet->guid))
+                update(packet, bsIn);
+            else
+                preInit(packet, bsIn);
+            break;
+        }
+    }
+}
+
 int Networking::mainLoop()
 {
     RakNet::Packet *packet;
 
+    packetDecoder = new PacketDecoder(peer, decoderThreads);
+
+    const std::chrono::steady_clock::duration tickDuration = std::chrono::microseconds(1000000 / tickRate);
+    auto nextTick = std::chrono::steady_clock::now();
+
 #ifndef _WIN32
     struct sigaction sigIntHandler;
     
@@ -515,67 +650,126 @@ int Networking::mainLoop()
 #endif
         if (kbhit() && getch() == '\n')
             break;
-        for (packet=peer->Receive(); packet; peer->DeallocatePacket(packet), packet=peer->Receive())
+        // Take in every packet that has arrived, so actor and object packets from players who are
+        // already connected can be decoded in parallel before any of them is processed
+        //
+        // Only packets that processActorPacket and processObjectPacket go on to use are decoded ahead,
+        // since decoding reads position deltas and record ids. A player's load state only moves
+        // forward, so a packet that isn't decoded ahead goes through the same check when it is
+        // processed, and one that is can only be dropped afterwards if the player is kicked
+        for (packet = peer->Receive(); packet; packet = peer->Receive())
         {
-            if (getMasterClient()->Process(packet))
-                continue;
+            receivedPackets.push_back(packet);
 
-            switch (packet->data[0])
-            {
-                case ID_REMOTE_DISCONNECTION_NOTIFICATION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has disconnected", packet->systemAddress.ToString());
-                    break;
-                case ID_REMOTE_CONNECTION_LOST:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
-                    break;
-                case ID_REMOTE_NEW_INCOMING_CONNECTION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has connected", packet->systemAddress.ToString());
-                    break;
-                case ID_CONNECTION_REQUEST_ACCEPTED:    // client to server
-                {
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Our connection request has been accepted");
-                    break;
-                }
-                case ID_NEW_INCOMING_CONNECTION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "A connection is incoming from %s", packet->systemAddress.ToString());
-                    break;
-                case ID_NO_FREE_INCOMING_CONNECTIONS:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "The server is full");
-                    break;
-                case ID_DISCONNECTION_NOTIFICATION:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN,  "Client at %s has disconnected", packet->systemAddress.ToString());
-                    disconnectPlayer(packet->guid);
-                    break;
-                case ID_CONNECTION_LOST:
-                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Client at %s has lost connection", packet->systemAddress.ToString());
-                    disconnectPlayer(packet->guid);
-                    break;
-                case ID_SND_RECEIPT_ACKED:
-                case ID_CONNECTED_PING:
-                case ID_UNCONNECTED_PING:
-                    break;
-                default:
-                {
-                    RakNet::BitStream bsIn(&packet->data[1], packet->length, false);
-                    bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+            Player *player = Players::getPlayer(packet->guid);
 
+            if (player != nullptr && player->isReadingWorldPackets())
+                packetDecoder->queue(packet, player->getPositionDeltaState(), player->getRecordIdState());
+        }
 
-                    if (Players::doesPlayerExist(packet->guid))
-                        update(packet, bsIn);
-                    else
-                        preInit(packet, bsIn);
-                    break;
-                }
+        packetDecoder->decodeQueued();
+
+        for (RakNet::Packet *receivedPacket : receivedPackets)
+        {
+            processPacket(receivedPacket);
+
+            // A packet that couldn't be read through the record id tables means ours no longer
+            // match the player's, so both start over
+            Player *player = Players::getPlayer(receivedPacket->guid);
+
+            if (player != nullptr && player->getRecordIdState()->isDesynced())
+            {
+                LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Record ids from %s are out of sync, resetting them",
+                    receivedPacket->systemAddress.ToString());
+                sendRecordIdReset(player);
             }
+
+            packetDecoder->release(receivedPacket);
+            peer->DeallocatePacket(receivedPacket);
         }
+
+        receivedPackets.clear();
+
+        sendQueuedPlayerPositions();
+        CellController::get()->sendQueuedActorPositions();
+
         TimerAPI::Tick();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        packetBatcher->flush();
+
+        // Sleep until the next tick, without trying to catch up on ticks we were too slow for
+        nextTick += tickDuration;
+        const auto now = std::chrono::steady_clock::now();
+
+        if (nextTick < now)
+            nextTick = now;
+
+        std::this_thread::sleep_until(nextTick);
     }
 
+    for (RakNet::Packet *receivedPacket : receivedPackets)
+        peer->DeallocatePacket(receivedPacket);
+
+    receivedPackets.clear();
+
+    delete packetDecoder;
+    packetDecoder = nullptr;
+
     TimerAPI::Terminate();
     return exitCode;
 }
 
+void Networking::setTickRate(int rate)
+{
+    tickRate = rate;
+}
+
+void Networking::setDecoderThreads(int threads)
+{
+    decoderThreads = threads;
+}
+
+PacketBatcher *Networking::getPacketBatcher()
+{
+    return packetBatcher;
+}
+
+uint32_t Networking::getPositionTimestamp() const
+{
+    const auto elapsed = std::chrono::steady_clock::now() - startTime;
+    const uint32_t timestamp = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+
+    return timestamp != 0 ? timestamp : 1;
+}
+
+void Networking::queuePlayerPosition(Player *player)
+{
+    queuedPlayerPositions.insert(player->guid.g);
+}
+
+void Networking::sendQueuedPlayerPositions()
+{
+    if (queuedPlayerPositions.empty())
+        return;
+
+    PlayerPacket *packet = playerPacketController->GetPacket(ID_PLAYER_POSITION);
+    const uint32_t timestamp = getPositionTimestamp();
+
+    for (auto &&guid : queuedPlayerPositions)
+    {
+        // The player may have disconnected since their position was queued
+        Player *player = Players::getPlayer(RakNet::RakNetGUID(guid));
+
+        if (player != nullptr)
+        {
+            player->positionTimestamp = timestamp;
+            player->sendToLoaded(packet);
+        }
+    }
+
+    queuedPlayerPositions.clear();
+}
+
 void Networking::kickPlayer(RakNet::RakNetGUID guid, bool sendNotification)
 {
     peer->CloseConnection(guid, sendNotification);
@@ -6,7 +6,13 @@
 #include <components/openmw-mp/Controllers/ActorPacketController.hpp>
 #include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
 #include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
+#include <components/openmw-mp/Controllers/PacketDispatchTable.hpp>
 #include <components/openmw-mp/Packets/PacketPreInit.hpp>
+#include <chrono>
+#include <cstdint>
+#include <unordered_set>
+#include "PacketBatcher.hpp"
+#include "PacketDecoder.hpp"
 #include "Player.hpp"
 
 class MasterClient;
@@ -19,6 +25,9 @@ namespace  mwmp
         ~Networking();
 
         void newPlayer(RakNet::RakNetGUID guid);
+        // Start over with empty record id tables for the packets a player sends us, and ask them to
+        // do the same
+        void sendRecordIdReset(Player *player);
         void disconnectPlayer(RakNet::RakNetGUID guid);
         void kickPlayer(RakNet::RakNetGUID guid, bool sendNotification = true);
         
@@ -40,6 +49,20 @@ namespace  mwmp
 
         int mainLoop();
 
+        void setTickRate(int rate);
+        // Number of threads that decode actor and object packets ahead of the main thread, where
+        // 0 decodes them on the main thread as they are processed
+        void setDecoderThreads(int threads);
+        PacketBatcher *getPacketBatcher();
+
+        // The server time in milliseconds that positions sent out now are timestamped with, which
+        // clients use to interpolate between them, and which is never 0 because that means untimed
+        uint32_t getPositionTimestamp() const;
+
+        // Player positions received during a tick are only sent to other players at its end,
+        // so a newer position from the same player replaces the one before it
+        void queuePlayerPosition(Player *player);
+
         void stopServer(int code);
 
         SystemPacketController *getSystemPacketController() const;
@@ -75,6 +98,9 @@ namespace  mwmp
         PacketPreInit::PluginContainer &getSamples();
     private:
         bool preInit(RakNet::Packet *packet, RakNet::BitStream &bsIn);
+        void processPacket(RakNet::Packet *packet);
+        void sendQueuedPlayerPositions();
+
         std::string serverPassword;
         static Networking *sThis;
 
@@ -93,6 +119,16 @@ namespace  mwmp
         ActorPacketController *actorPacketController;
         ObjectPacketController *objectPacketController;
         WorldstatePacketController *worldstatePacketController;
+        PacketDispatchTable dispatchTable;
+
+        PacketBatcher *packetBatcher;
+        std::unordered_set<uint64_t> queuedPlayerPositions;
+        int tickRate;
+        std::chrono::steady_clock::time_point startTime;
+
+        PacketDecoder *packetDecoder;
+        int decoderThreads;
+        std::vector<RakNet::Packet *> receivedPackets;
 
         bool running;
         int exitCode;
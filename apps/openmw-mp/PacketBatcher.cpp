@@ -0,0 +1,105 @@
+#include "PacketBatcher.hpp"
+
+#include <components/openmw-mp/NetworkMessages.hpp>
+
+PacketBatcher::PacketBatcher(RakNet::RakPeerInterface *peer) : peer(peer)
+{
+
+}
+
+void PacketBatcher::queue(const RakNet::RakNetGUID &recipient, const mwmp::SerializedPacketPtr &serializedPacket)
+{
+    std::vector<Batch> &recipientBatches = batches[recipient.g];
+
+    // Packets are only batched together with others using the same ordering channel and reliability,
+    // so the order in which each channel's packets arrive stays the same
+    for (auto &&batch : recipientBatches)
+    {
+        if (batch.orderChannel == serializedPacket->orderChannel && batch.reliability == serializedPacket->reliability)
+        {
+            if (serializedPacket->priority < batch.priority)
+                batch.priority = serializedPacket->priority;
+
+            batch.packets.push_back(serializedPacket);
+            return;
+        }
+    }
+
+    Batch batch;
+    batch.orderChannel = serializedPacket->orderChannel;
+    batch.reliability = serializedPacket->reliability;
+    batch.priority = serializedPacket->priority;
+    batch.packets.push_back(serializedPacket);
+    recipientBatches.push_back(std::move(batch));
+}
+
+void PacketBatcher::flush()
+{
+    for (auto &&recipientBatches : batches)
+    {
+        RakNet::RakNetGUID recipient(recipientBatches.first);
+
+        for (auto &&batch : recipientBatches.second)
+            send(recipient, batch);
+    }
+
+    batches.clear();
+}
+
+void PacketBatcher::flush(const RakNet::RakNetGUID &recipient, int8_t orderChannel)
+{
+    auto it = batches.find(recipient.g);
+
+    if (it != batches.end())
+        flush(recipient, it->second, orderChannel);
+}
+
+void PacketBatcher::flush(int8_t orderChannel)
+{
+    for (auto &&recipientBatches : batches)
+        flush(RakNet::RakNetGUID(recipientBatches.first), recipientBatches.second, orderChannel);
+}
+
+void PacketBatcher::flush(const RakNet::RakNetGUID &recipient, std::vector<Batch> &recipientBatches, int8_t orderChannel)
+{
+    // Every reliability is flushed, since RakNet orders some of them against each other
+    for (auto it = recipientBatches.begin(); it != recipientBatches.end();)
+    {
+        if (it->orderChannel == orderChannel)
+        {
+            send(recipient, *it);
+            it = recipientBatches.erase(it);
+        }
+        else
+            ++it;
+    }
+}
+
+void PacketBatcher::send(const RakNet::RakNetGUID &recipient, const Batch &batch)
+{
+    // A single packet doesn't need to be wrapped in a batch
+    if (batch.packets.size() == 1)
+    {
+        const mwmp::SerializedPacket &serializedPacket = *batch.packets.front();
+        peer->Send(reinterpret_cast<const char *>(serializedPacket.data.data()), (int) serializedPacket.data.size(),
+            batch.priority, batch.reliability, batch.orderChannel, recipient, false);
+        return;
+    }
+
+    // Every packet in the batch is prefixed with its length as a little-endian 32-bit integer
+    buffer.clear();
+    buffer.push_back((unsigned char) ID_PACKET_BATCH);
+
+    for (auto &&serializedPacket : batch.packets)
+    {
+        uint32_t length = (uint32_t) serializedPacket->data.size();
+
+        for (int i = 0; i < 4; i++)
+            buffer.push_back((unsigned char) (length >> (8 * i)));
+
+        buffer.insert(buffer.end(), serializedPacket->data.begin(), serializedPacket->data.end());
+    }
+
+    peer->Send(reinterpret_cast<const char *>(buffer.data()), (int) buffer.size(), batch.priority, batch.reliability,
+        batch.orderChannel, recipient, false);
+}
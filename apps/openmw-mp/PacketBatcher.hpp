@@ -0,0 +1,47 @@
+#ifndef OPENMW_PACKETBATCHER_HPP
+#define OPENMW_PACKETBATCHER_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <RakPeerInterface.h>
+
+#include <components/openmw-mp/Packets/BasePacket.hpp>
+
+/*
+    Collects the packets sent to every recipient over the course of a server tick, so that
+    they can be sent as a single ID_PACKET_BATCH message per recipient and ordering channel
+*/
+class PacketBatcher
+{
+public:
+    PacketBatcher(RakNet::RakPeerInterface *peer);
+
+    void queue(const RakNet::RakNetGUID &recipient, const mwmp::SerializedPacketPtr &serializedPacket);
+    void flush();
+
+    // Send what is queued for a recipient on an ordering channel right away, so a packet sent to
+    // them directly on that channel afterwards doesn't arrive before it
+    void flush(const RakNet::RakNetGUID &recipient, int8_t orderChannel);
+
+    // The same for every recipient, for packets sent to all of them
+    void flush(int8_t orderChannel);
+
+private:
+    struct Batch
+    {
+        int8_t orderChannel;
+        PacketReliability reliability;
+        PacketPriority priority;
+        std::vector<mwmp::SerializedPacketPtr> packets;
+    };
+
+    void send(const RakNet::RakNetGUID &recipient, const Batch &batch);
+    void flush(const RakNet::RakNetGUID &recipient, std::vector<Batch> &recipientBatches, int8_t orderChannel);
+
+    RakNet::RakPeerInterface *peer;
+    std::unordered_map<uint64_t, std::vector<Batch>> batches;
+    std::vector<unsigned char> buffer;
+};
+
+#endif //OPENMW_PACKETBATCHER_HPP
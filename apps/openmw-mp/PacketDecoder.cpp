@@ -0,0 +1,182 @@
+#include "PacketDecoder.hpp"
+
+#include <components/openmw-mp/TimedLog.hpp>
+
+#include "processors/ActorProcessor.hpp"
+#include "processors/ObjectProcessor.hpp"
+
+#include <utility>
+
+PacketDecoder::Worker::Worker(RakNet::RakPeerInterface *peer) : actorPacketController(peer),
+    objectPacketController(peer), jobs(4096), isFull(false)
+{
+}
+
+PacketDecoder::PacketDecoder(RakNet::RakPeerInterface *peer, unsigned int threadCount) : queuedJobs(0),
+    releasedJobs(0), pendingJobs(0), isStopping(false)
+{
+    for (unsigned int i = 0; i < threadCount; ++i)
+        workers.emplace_back(new Worker(peer));
+
+    for (auto &worker : workers)
+        worker->thread = std::thread(&PacketDecoder::run, this, std::ref(*worker));
+
+    if (threadCount > 0)
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Decoding actor and object packets on %u threads", threadCount);
+}
+
+PacketDecoder::~PacketDecoder()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        isStopping = true;
+    }
+
+    wakeCondition.notify_all();
+
+    for (auto &worker : workers)
+        worker->thread.join();
+}
+
+bool PacketDecoder::queue(RakNet::Packet *packet, mwmp::PositionDeltaState *deltaState,
+    mwmp::RecordIdState *recordIdState)
+{
+    if (workers.empty() || packet->length < 1 + RakNet::RakNetGUID::size())
+        return false;
+
+    const RakNet::MessageID id = packet->data[0];
+    const bool isActorPacket = workers.front()->actorPacketController.ContainsPacket(id);
+
+    if (!isActorPacket && !workers.front()->objectPacketController.ContainsPacket(id))
+        return false;
+
+    Worker &worker = *workers[packet->guid.g % workers.size()];
+
+    if (worker.isFull)
+        return false;
+
+    if (queuedJobs == jobs.size())
+        jobs.emplace_back(new Job());
+
+    Job *job = jobs[queuedJobs].get();
+    job->packet = packet;
+    job->deltaState = deltaState;
+    job->recordIdState = recordIdState;
+    job->isActorPacket = isActorPacket;
+    job->isDecoded = false;
+
+    pendingJobs.fetch_add(1, std::memory_order_relaxed);
+
+    if (!worker.jobs.push(job))
+    {
+        pendingJobs.fetch_sub(1, std::memory_order_relaxed);
+        worker.isFull = true;
+        return false;
+    }
+
+    queuedJobs++;
+    return true;
+}
+
+void PacketDecoder::decodeQueued()
+{
+    if (queuedJobs == 0)
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    wakeCondition.notify_all();
+    doneCondition.wait(lock, [this] { return pendingJobs.load(std::memory_order_acquire) == 0; });
+}
+
+PacketDecoder::Job *PacketDecoder::getJob(RakNet::Packet *packet)
+{
+    if (releasedJobs < queuedJobs && jobs[releasedJobs]->packet == packet)
+        return jobs[releasedJobs].get();
+
+    return nullptr;
+}
+
+bool PacketDecoder::takeDecodedActorList(RakNet::Packet *packet, mwmp::BaseActorList &actorList)
+{
+    Job *job = getJob(packet);
+
+    if (job == nullptr || !job->isDecoded || !job->isActorPacket)
+        return false;
+
+    std::swap(actorList, job->actorList);
+    return true;
+}
+
+bool PacketDecoder::takeDecodedObjectList(RakNet::Packet *packet, mwmp::BaseObjectList &objectList)
+{
+    Job *job = getJob(packet);
+
+    if (job == nullptr || !job->isDecoded || job->isActorPacket)
+        return false;
+
+    std::swap(objectList, job->objectList);
+    return true;
+}
+
+void PacketDecoder::release(RakNet::Packet *packet)
+{
+    if (getJob(packet) != nullptr)
+        releasedJobs++;
+
+    // Start over once every packet of the tick has been processed
+    if (releasedJobs == queuedJobs)
+    {
+        queuedJobs = 0;
+        releasedJobs = 0;
+
+        for (auto &worker : workers)
+            worker->isFull = false;
+    }
+}
+
+void PacketDecoder::run(Worker &worker)
+{
+    while (true)
+    {
+        Job *job;
+
+        while (worker.jobs.pop(job))
+        {
+            decode(worker, *job);
+
+            if (pendingJobs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                doneCondition.notify_one();
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        wakeCondition.wait(lock, [this, &worker] { return isStopping || !worker.jobs.empty(); });
+
+        if (isStopping)
+            return;
+    }
+}
+
+void PacketDecoder::decode(Worker &worker, Job &job)
+{
+    RakNet::Packet &packet = *job.packet;
+
+    RakNet::BitStream bsIn(&packet.data[1], packet.length, false);
+    bsIn.IgnoreBytes((unsigned int) RakNet::RakNetGUID::size()); // Ignore GUID from received packet
+
+    if (job.isActorPacket)
+    {
+        mwmp::ActorPacket *myPacket = worker.actorPacketController.GetPacket(packet.data[0]);
+        myPacket->SetReadStream(&bsIn);
+        job.isDecoded = mwmp::ActorProcessor::Decode(packet, *myPacket, job.deltaState, job.actorList);
+    }
+    else
+    {
+        mwmp::ObjectPacket *myPacket = worker.objectPacketController.GetPacket(packet.data[0]);
+        myPacket->SetReadStream(&bsIn);
+        job.isDecoded = mwmp::ObjectProcessor::Decode(packet, *myPacket, job.recordIdState, job.objectList);
+    }
+}
@@ -0,0 +1,89 @@
+#ifndef OPENMW_PACKETDECODER_HPP
+#define OPENMW_PACKETDECODER_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <RakPeerInterface.h>
+
+#include <components/openmw-mp/Base/BaseActor.hpp>
+#include <components/openmw-mp/Base/BaseObject.hpp>
+#include <components/openmw-mp/Controllers/ActorPacketController.hpp>
+#include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
+#include <components/openmw-mp/Packets/PositionDeltaState.hpp>
+#include <components/openmw-mp/Packets/RecordIdState.hpp>
+
+#include "SpscQueue.hpp"
+
+/*
+    Decodes the actor and object packets received during a server tick on worker threads
+
+    Every packet of a tick is queued before any of them is processed, after which decodeQueued waits
+    for the workers to finish, so the main thread never runs at the same time as them and still
+    processes packets in the order they arrived. Each player's packets always go to the same worker,
+    because reading their position updates and record ids depends on the ones before them
+*/
+class PacketDecoder
+{
+public:
+    PacketDecoder(RakNet::RakPeerInterface *peer, unsigned int threadCount);
+    ~PacketDecoder();
+
+    // Queue a packet for decoding if it is an actor or object packet, returning whether it was queued
+    bool queue(RakNet::Packet *packet, mwmp::PositionDeltaState *deltaState, mwmp::RecordIdState *recordIdState);
+    // Decode every queued packet, returning once all of them are done
+    void decodeQueued();
+
+    // Swap the decoded contents of a packet into the given list, if it was decoded
+    bool takeDecodedActorList(RakNet::Packet *packet, mwmp::BaseActorList &actorList);
+    bool takeDecodedObjectList(RakNet::Packet *packet, mwmp::BaseObjectList &objectList);
+
+    // Packets have to be released in the order they were received once they have been processed,
+    // which lets the decoded contents of each one be found without searching for them
+    void release(RakNet::Packet *packet);
+
+private:
+    struct Job
+    {
+        RakNet::Packet *packet;
+        mwmp::PositionDeltaState *deltaState;
+        mwmp::RecordIdState *recordIdState;
+        bool isActorPacket;
+        bool isDecoded;
+        mwmp::BaseActorList actorList;
+        mwmp::BaseObjectList objectList;
+    };
+
+    struct Worker
+    {
+        Worker(RakNet::RakPeerInterface *peer);
+
+        mwmp::ActorPacketController actorPacketController;
+        mwmp::ObjectPacketController objectPacketController;
+        SpscQueue<Job *> jobs;
+        // Set once a job could not be queued, so later packets are not decoded ahead of it
+        bool isFull;
+        std::thread thread;
+    };
+
+    void run(Worker &worker);
+    void decode(Worker &worker, Job &job);
+    Job *getJob(RakNet::Packet *packet);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::unique_ptr<Job>> jobs;
+    std::size_t queuedJobs;
+    std::size_t releasedJobs;
+
+    std::atomic<std::size_t> pendingJobs;
+    bool isStopping;
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+};
+
+#endif //OPENMW_PACKETDECODER_HPP
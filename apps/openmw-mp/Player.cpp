@@ -1,3 +1,5 @@
+#include <components/openmw-mp/Utils.hpp>
+
 #include "Player.hpp"
 #include "Networking.hpp"
 
@@ -116,6 +118,11 @@ int Player::getLoadState()
     return loadState;
 }
 
+bool Player::isReadingWorldPackets()
+{
+    return isHandshaked() && loadState == POSTLOADED;
+}
+
 Player *Players::getPlayer(unsigned short id)
 {
     auto it = slots.find(id);
@@ -129,48 +136,102 @@ CellController::TContainer *Player::getCells()
     return &cells;
 }
 
-void Player::sendToLoaded(mwmp::PlayerPacket *myPacket)
+mwmp::PositionDeltaState *Player::getPositionDeltaState()
+{
+    return &positionDeltaState;
+}
+
+mwmp::RecordIdState *Player::getRecordIdState()
+{
+    return &recordIdState;
+}
+
+std::unordered_set<uint64_t> *Player::getKnownRecords()
 {
-    std::list <Player*> plList;
+    return &knownRecords;
+}
+
+const mwmp::MapTile &Player::addListedMapTile(const mwmp::MapTile &mapTile)
+{
+    mwmp::MapTile &listedTile = listedMapTiles[std::make_pair(mapTile.x, mapTile.y)];
+    listedTile = mapTile;
+    listedTile.hash = Utils::hashBytes(mapTile.imageData.data(), mapTile.imageData.size());
+    return listedTile;
+}
 
-    for (auto cell : cells)
-        for (auto pl : *cell)
-            plList.push_back(pl);
+bool Player::takeListedMapTile(int x, int y, mwmp::MapTile &mapTile)
+{
+    auto it = listedMapTiles.find(std::make_pair(x, y));
 
-    plList.sort();
-    plList.unique();
+    if (it == listedMapTiles.end())
+        return false;
 
-    for (auto pl : plList)
-    {
-        if (pl == this) continue;
-        myPacket->setPlayer(this);
-        myPacket->Send(pl->guid);
-    }
+    mapTile = std::move(it->second);
+    listedMapTiles.erase(it);
+    return true;
 }
 
-void Player::forEachLoaded(std::function<void(Player *pl, Player *other)> func)
+void Player::removeCachedMapTile(const mwmp::MapTile &mapTile)
+{
+    auto it = listedMapTiles.find(std::make_pair(mapTile.x, mapTile.y));
+
+    // Keep the tile if it has been listed again with different image data since, because the player
+    // will still be asking for that
+    if (it != listedMapTiles.end() && it->second.hash == mapTile.hash)
+        listedMapTiles.erase(it);
+}
+
+void Player::sendToLoaded(mwmp::PlayerPacket *myPacket)
 {
-    std::list <Player*> plList;
+    myPacket->setPlayer(this);
+
+    PacketBatcher *packetBatcher = mwmp::Networking::getPtr()->getPacketBatcher();
 
-    for (auto cell : cells)
+    // Only serialize the packet once, and only if it has at least one eligible recipient
+    mwmp::SerializedPacketPtr serializedPacket;
+
+    for (auto &&loadedPlayer : loadedPlayers)
     {
-        for (auto pl : *cell)
+        if (myPacket->usesDeltaState())
         {
-            if (pl != nullptr && !pl->npc.mName.empty())
-                plList.push_back(pl);
+            myPacket->setDeltaState(loadedPlayer.first->getPositionDeltaState());
+            packetBatcher->queue(loadedPlayer.first->guid, myPacket->Serialize());
+            myPacket->setDeltaState(nullptr);
+            continue;
         }
-    }
 
-    plList.sort();
-    plList.unique();
+        if (!serializedPacket)
+            serializedPacket = myPacket->Serialize();
+
+        // Send the packet at the end of the tick
+        packetBatcher->queue(loadedPlayer.first->guid, serializedPacket);
+    }
+}
 
-    for (auto pl : plList)
+void Player::forEachLoaded(std::function<void(Player *pl, Player *other)> func)
+{
+    for (auto &&loadedPlayer : loadedPlayers)
     {
-        if (pl == this) continue;
-        func(this, pl);
+        Player *pl = loadedPlayer.first;
+
+        if (pl != nullptr && !pl->npc.mName.empty())
+            func(this, pl);
     }
 }
 
+void Player::addLoadedPlayer(Player *other)
+{
+    loadedPlayers[other]++;
+}
+
+void Player::removeLoadedPlayer(Player *other)
+{
+    auto it = loadedPlayers.find(other);
+
+    if (it != loadedPlayers.end() && --it->second == 0)
+        loadedPlayers.erase(it);
+}
+
 bool Players::doesPlayerExist(RakNet::RakNetGUID guid)
 {
     return players.find(guid) != players.end();
@@ -4,6 +4,8 @@
 #include <map>
 #include <string>
 #include <chrono>
+#include <unordered_map>
+#include <unordered_set>
 #include <RakNetTypes.h>
 
 #include <components/esm/npcstats.hpp>
@@ -13,6 +15,9 @@
 
 #include <components/openmw-mp/TimedLog.hpp>
 #include <components/openmw-mp/Base/BasePlayer.hpp>
+#include <components/openmw-mp/Base/BaseWorldstate.hpp>
+#include <components/openmw-mp/Packets/PositionDeltaState.hpp>
+#include <components/openmw-mp/Packets/RecordIdState.hpp>
 #include <components/openmw-mp/Packets/Player/PlayerPacket.hpp>
 #include "Cell.hpp"
 #include "CellController.hpp"
@@ -61,16 +66,43 @@ public:
 
     void setLoadState(int state);
     int getLoadState();
+    // Whether the player's actor and object packets are read and processed, which only they are
+    // once the handshake is done and they have finished loading
+    bool isReadingWorldPackets();
 
     virtual ~Player();
 
     CellController::TContainer *getCells();
+    mwmp::PositionDeltaState *getPositionDeltaState();
+    mwmp::RecordIdState *getRecordIdState();
+
+    // Map tiles are only listed to the player at first, and kept here until it either asks for their
+    // image data or lets us know it has them cached
+    const mwmp::MapTile &addListedMapTile(const mwmp::MapTile &mapTile);
+    bool takeListedMapTile(int x, int y, mwmp::MapTile &mapTile);
+    void removeCachedMapTile(const mwmp::MapTile &mapTile);
+
+    // The hashes of the dynamic records the player has cached, so only their hashes have to be sent
+    std::unordered_set<uint64_t> *getKnownRecords();
+
     void sendToLoaded(mwmp::PlayerPacket *myPacket);
 
     void forEachLoaded(std::function<void(Player *pl, Player *other)> func);
 
 private:
+    void addLoadedPlayer(Player *other);
+    void removeLoadedPlayer(Player *other);
+
     CellController::TContainer cells;
+
+    // The other players sharing at least one cell with this one, mapped to the number of cells
+    // they share, kept up to date by Cell::addPlayer() and Cell::removePlayer()
+    std::unordered_map<Player*, unsigned int> loadedPlayers;
+
+    mwmp::PositionDeltaState positionDeltaState;
+    mwmp::RecordIdState recordIdState;
+    std::map<std::pair<int, int>, mwmp::MapTile> listedMapTiles;
+    std::unordered_set<uint64_t> knownRecords;
     int loadState;
     int handshakeCounter;
 
@@ -1,7 +1,5 @@
 #include "TimerAPI.hpp"
 
-#include <chrono>
-
 #include <iostream>
 using namespace mwmp;
 
@@ -21,181 +19,134 @@ Timer::Timer(lua_State *lua, ScriptFuncLua callback, long msec, const std::strin
 }
 #endif
 
-void Timer::Tick()
-{
-    if (isEnded)
-        return;
-
-    const auto duration = std::chrono::system_clock::now().time_since_epoch();
-    const auto time = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-
-    if (time - startTime >= targetMsec)
-    {
-        isEnded = true;
-        Call(args);
-    }
-}
-
 bool Timer::IsEnded()
 {
     return isEnded;
 }
 
-void Timer::Stop()
-{
-    isEnded = true;
-}
+std::vector<Timer* > TimerAPI::timers;
+std::vector<int> TimerAPI::freeTimerIds;
+TimerQueue TimerAPI::queue;
+std::vector<int> TimerAPI::expiredTimerIds;
 
-void Timer::Restart(int msec)
+int TimerAPI::AddTimer(Timer *timer)
 {
-    targetMsec = msec;
-    Start();
+    if (!freeTimerIds.empty())
+    {
+        int id = freeTimerIds.back();
+        freeTimerIds.pop_back();
+        timers[id] = timer;
+        return id;
+    }
+
+    timers.push_back(timer);
+    return static_cast<int>(timers.size()) - 1;
 }
 
-void Timer::Start()
+Timer *TimerAPI::GetTimer(int timerid)
 {
-    isEnded = false;
+    if (timerid < 0 || static_cast<std::size_t>(timerid) >= timers.size() || timers[timerid] == nullptr)
+    {
+        std::cerr << "Timer " << timerid << " not found!" << std::endl;
+        return nullptr;
+    }
 
-    const auto duration = std::chrono::system_clock::now().time_since_epoch();
-    const auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(duration).count();
-    startTime = msec;
+    return timers[timerid];
 }
 
-int TimerAPI::pointer = 0;
-std::unordered_map<int, Timer* > TimerAPI::timers;
-
 #if defined(ENABLE_LUA)
 int TimerAPI::CreateTimerLua(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, std::vector<boost::any> args)
 {
-    int id = -1;
-
-    for (auto timer : timers)
-    {
-        if (timer.second != nullptr)
-            continue;
-        timer.second = new Timer(lua, callback, msec, def, args);
-        id = timer.first;
-    }
-
-    if (id == -1)
-    {
-        timers[pointer] = new Timer(lua, callback, msec, def, args);
-        id = pointer;
-        pointer++;
-    }
-
-    return id;
+    return AddTimer(new Timer(lua, callback, msec, def, args));
 }
 #endif
 
 
 int TimerAPI::CreateTimer(ScriptFunc callback, long msec, const std::string &def, std::vector<boost::any> args)
 {
-    int id = -1;
-
-    for (auto timer : timers)
-    {
-        if (timer.second != nullptr)
-            continue;
-        timer.second = new Timer(callback, msec, def, args);
-        id = timer.first;
-    }
-
-    if (id == -1)
-    {
-        timers[pointer] = new Timer(callback, msec, def, args);
-        id = pointer;
-        pointer++;
-    }
-
-    return id;
+    return AddTimer(new Timer(callback, msec, def, args));
 }
 
 void TimerAPI::FreeTimer(int timerid)
 {
+    Timer *timer = GetTimer(timerid);
 
-    try
-    {
-        if (timers.at(timerid) != nullptr)
-        {
-            delete timers[timerid];
-            timers[timerid] = nullptr;
-        }
-    }
-    catch(...)
-    {
-        std::cerr << "Timer " << timerid << " not found!" << std::endl;
-    }
+    if (timer == nullptr)
+        return;
+
+    queue.cancel(timerid);
+    delete timer;
+    timers[timerid] = nullptr;
+    freeTimerIds.push_back(timerid);
 }
 
 void TimerAPI::ResetTimer(int timerid, long msec)
 {
-    try
-    {
-        timers.at(timerid)->Restart(msec);
-    }
-    catch(...)
-    {
-        std::cerr << "Timer " << timerid << " not found!" << std::endl;
-    }
+    Timer *timer = GetTimer(timerid);
+
+    if (timer == nullptr)
+        return;
+
+    timer->targetMsec = msec;
+    StartTimer(timerid);
 }
 
 void TimerAPI::StartTimer(int timerid)
 {
-    try
-    {
-        Timer *timer = timers.at(timerid);
-        if (timer == nullptr)
-            throw 1;
-        timer->Start();
-    }
-    catch(...)
-    {
-        std::cerr << "Timer " << timerid << " not found!" << std::endl;
-    }
+    Timer *timer = GetTimer(timerid);
+
+    if (timer == nullptr)
+        return;
+
+    timer->isEnded = false;
+    queue.schedule(timerid, TimerQueue::Clock::now() + std::chrono::milliseconds(timer->targetMsec));
 }
 
 void TimerAPI::StopTimer(int timerid)
 {
-    try
-    {
-        timers.at(timerid)->Stop();
-    }
-    catch(...)
-    {
-        std::cerr << "Timer " << timerid << " not found!" << std::endl;
-    }
+    Timer *timer = GetTimer(timerid);
+
+    if (timer == nullptr)
+        return;
+
+    timer->isEnded = true;
+    queue.cancel(timerid);
 }
 
 bool TimerAPI::IsTimerElapsed(int timerid)
 {
-    bool ret = false;
-    try
-    {
-        ret = timers.at(timerid)->IsEnded();
-    }
-    catch(...)
-    {
-        std::cerr << "Timer " << timerid << " not found!" << std::endl;
-    }
-    return ret;
+    Timer *timer = GetTimer(timerid);
+
+    if (timer == nullptr)
+        return false;
+
+    return timer->IsEnded();
 }
 
 void TimerAPI::Terminate()
 {
-    for (auto timer : timers)
-    {
-        if (timer.second != nullptr)
-            delete timer.second;
-        timer.second = nullptr;
-    }
+    for (Timer *timer : timers)
+        delete timer;
+
+    timers.clear();
+    freeTimerIds.clear();
+    queue.clear();
 }
 
 void TimerAPI::Tick()
 {
-    for (auto timer : timers)
+    expiredTimerIds.clear();
+    queue.popExpired(TimerQueue::Clock::now(), expiredTimerIds);
+
+    for (int timerid : expiredTimerIds)
     {
-        if (timer.second != nullptr)
-            timer.second->Tick();
+        Timer *timer = timers[timerid];
+
+        // An earlier callback in this tick may have stopped, restarted or freed this timer
+        if (timer == nullptr || timer->isEnded || queue.isScheduled(timerid))
+            continue;
+
+        timer->isEnded = true;
+        timer->Call(timer->args);
     }
 }
@@ -2,6 +2,9 @@
 #define OPENMW_TIMERAPI_HPP
 
 #include <string>
+#include <vector>
+
+#include <components/openmw-mp/TimerQueue.hpp>
 
 #include <Script/Script.hpp>
 #include <Script/ScriptFunction.hpp>
@@ -21,14 +24,9 @@ namespace mwmp
 #if defined(ENABLE_LUA)
         Timer(lua_State *lua, ScriptFuncLua callback, long msec, const std::string& def, std::vector<boost::any> args);
 #endif
-        void Tick();
-
         bool IsEnded();
-        void Stop();
-        void Start();
-        void Restart(int msec);
     private:
-        double startTime, targetMsec;
+        long targetMsec;
         std::string publ, arg_types;
         std::vector<boost::any> args;
         Script *scr;
@@ -52,8 +50,14 @@ namespace mwmp
 
         static void Tick();
     private:
-        static std::unordered_map<int, Timer* > timers;
-        static int pointer;
+        static int AddTimer(Timer *timer);
+        static Timer *GetTimer(int timerid);
+
+        static std::vector<Timer* > timers;
+        // Ids of freed timers, handed out again before new ones are allocated
+        static std::vector<int> freeTimerIds;
+        static TimerQueue queue;
+        static std::vector<int> expiredTimerIds;
     };
 }
 
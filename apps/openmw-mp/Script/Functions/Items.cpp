@@ -254,7 +254,11 @@ void ItemFunctions::SendInventoryChanges(unsigned short pid, bool sendToOtherPla
     packet->setPlayer(player);
 
     if (!skipAttachedPlayer)
+    {
+        packet->setRecordIdState(player->getRecordIdState());
         packet->Send(false);
+        packet->setRecordIdState(nullptr);
+    }
     if (sendToOtherPlayers)
         packet->Send(true);
 }
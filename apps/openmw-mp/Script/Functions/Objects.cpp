@@ -894,7 +894,17 @@ void ObjectFunctions::SendContainer(bool sendToOtherPlayers, bool skipAttachedPl
     packet->setObjectList(&writeObjectList);
 
     if (!skipAttachedPlayer)
+    {
+        // Only the packet going to a single player can use its record ids, while the one
+        // going to everyone else keeps them as full strings
+        Player *player = Players::getPlayer(writeObjectList.guid);
+
+        if (player != nullptr)
+            packet->setRecordIdState(player->getRecordIdState());
+
         packet->Send(false);
+        packet->setRecordIdState(nullptr);
+    }
     if (sendToOtherPlayers)
         packet->Send(true);
 }
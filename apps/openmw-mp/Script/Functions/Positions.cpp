@@ -104,6 +104,10 @@ void PositionFunctions::SendPos(unsigned short pid) noexcept
     Player *player;
     GET_PLAYER(pid, player, );
 
+    // Positions set by scripts carry no server time, so clients snap to them instead of
+    // interpolating toward them
+    player->positionTimestamp = 0;
+
     mwmp::PlayerPacket *packet = mwmp::Networking::get().getPlayerPacketController()->GetPacket(ID_PLAYER_POSITION);
     packet->setPlayer(player);
 
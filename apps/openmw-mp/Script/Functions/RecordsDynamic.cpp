@@ -1,5 +1,6 @@
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <components/openmw-mp/Base/BaseWorldstate.hpp>
+#include <components/openmw-mp/Packets/Worldstate/PacketRecordDynamic.hpp>
 
 #include <apps/openmw-mp/Networking.hpp>
 #include <apps/openmw-mp/Player.hpp>
@@ -1939,11 +1940,17 @@ void RecordsDynamicFunctions::SendRecordDynamic(unsigned short pid, bool sendToO
 
     WorldstateFunctions::writeWorldstate.guid = player->guid;
 
-    mwmp::WorldstatePacket *packet = mwmp::Networking::get().getWorldstatePacketController()->GetPacket(ID_RECORD_DYNAMIC);
+    mwmp::PacketRecordDynamic *packet = static_cast<mwmp::PacketRecordDynamic *>(
+        mwmp::Networking::get().getWorldstatePacketController()->GetPacket(ID_RECORD_DYNAMIC));
     packet->setWorldstate(&WorldstateFunctions::writeWorldstate);
 
     if (!skipAttachedPlayer)
+    {
+        // Records the player already has cached are only sent as their hashes
+        packet->setKnownRecords(player->getKnownRecords());
         packet->Send(false);
+        packet->setKnownRecords(nullptr);
+    }
     if (sendToOtherPlayers)
         packet->Send(true);
 }
@@ -374,12 +374,34 @@ void WorldstateFunctions::SendWorldMap(unsigned short pid, bool sendToOtherPlaye
     writeWorldstate.guid = player->guid;
 
     mwmp::WorldstatePacket *packet = mwmp::Networking::get().getWorldstatePacketController()->GetPacket(ID_WORLD_MAP);
-    packet->setWorldstate(&writeWorldstate);
 
     if (!skipAttachedPlayer)
+    {
+        // Only send the attached player a list of the tiles and the hashes of their image data,
+        // so it can ask for the image data of the ones it doesn't have cached a chunk at a time
+        mwmp::BaseWorldstate tileList;
+        tileList.guid = player->guid;
+        tileList.mapTilesAction = mwmp::BaseWorldstate::MAP_TILES_LIST;
+
+        for (const auto &mapTile : writeWorldstate.mapTiles)
+        {
+            mwmp::MapTile listedTile;
+            listedTile.x = mapTile.x;
+            listedTile.y = mapTile.y;
+            listedTile.hash = player->addListedMapTile(mapTile).hash;
+            tileList.mapTiles.push_back(listedTile);
+        }
+
+        packet->setWorldstate(&tileList);
         packet->Send(false);
+    }
+
     if (sendToOtherPlayers)
+    {
+        writeWorldstate.mapTilesAction = mwmp::BaseWorldstate::MAP_TILES_SET;
+        packet->setWorldstate(&writeWorldstate);
         packet->Send(true);
+    }
 }
 
 void WorldstateFunctions::SendWorldTime(unsigned short pid, bool sendToOtherPlayers, bool skipAttachedPlayer) noexcept
@@ -1,6 +1,7 @@
+#include <cstring>
 #include <iostream>
+#include <stdexcept>
 #include "LangLua.hpp"
-#include <Script/Script.hpp>
 #include <Script/Types.hpp>
 
 std::set<std::string> LangLua::packagePath;
@@ -53,162 +54,64 @@ LangLua::~LangLua()
 
 }
 
-template<unsigned int I, unsigned int F>
-struct Lua_dispatch_ {
-    template<typename R, typename... Args>
-    inline static R Lua_dispatch(lua_State*&& lua, Args&&... args) noexcept {
-        constexpr ScriptFunctionData const& F_ = ScriptFunctions::functions[F];
-        auto arg = luabridge::Stack<typename CharType<F_.func.types[I - 1]>::type>::get(lua, I);
-        return Lua_dispatch_<I - 1, F>::template Lua_dispatch<R>(
-                std::forward<lua_State*>(lua),
-                arg,
-                std::forward<Args>(args)...);
-    }
-};
-
-template<unsigned int F>
-struct Lua_dispatch_<0, F> {
-    template<typename R, typename... Args>
-    inline static R Lua_dispatch(lua_State*&&, Args&&... args) noexcept {
-        constexpr ScriptFunctionData const& F_ = ScriptFunctions::functions[F];
-        return reinterpret_cast<FunctionEllipsis<R>>(F_.func.addr)(std::forward<Args>(args)...);
-    }
-};
-
-template<unsigned int I>
-static typename std::enable_if<ScriptFunctions::functions[I].func.ret == 'v', int>::type wrapper(lua_State* lua) noexcept {
-    Lua_dispatch_<ScriptFunctions::functions[I].func.numargs, I>::template Lua_dispatch<void>(std::forward<lua_State*>(lua));
+int LangLua::FreeProgram()
+{
+    lua_close(lua);
     return 0;
 }
 
-template<unsigned int I>
-static typename std::enable_if<ScriptFunctions::functions[I].func.ret != 'v', int>::type wrapper(lua_State* lua) noexcept {
-    auto ret = Lua_dispatch_<ScriptFunctions::functions[I].func.numargs, I>::template Lua_dispatch<
-            typename CharType<ScriptFunctions::functions[I].func.ret>::type>(std::forward<lua_State*>(lua));
-    luabridge::Stack <typename CharType<ScriptFunctions::functions[I].func.ret>::type>::push (lua, ret);
-    return 1;
-}
-
-template<unsigned int I>
-struct F_
-{
-    static constexpr LuaFuctionData F{ScriptFunctions::functions[I].name, wrapper<I>};
-};
-
-
-template<> struct F_<0> { static constexpr LuaFuctionData F{"CreateTimer", LangLua::CreateTimer}; };
-template<> struct F_<1> { static constexpr LuaFuctionData F{"CreateTimerEx", LangLua::CreateTimerEx}; };
-template<> struct F_<2> { static constexpr LuaFuctionData F{"MakePublic", LangLua::MakePublic}; };
-template<> struct F_<3> { static constexpr LuaFuctionData F{"CallPublic", LangLua::CallPublic}; };
-
-#ifdef __arm__
-template<std::size_t... Is>
-struct indices {};
-template<std::size_t N, std::size_t... Is>
-struct build_indices : build_indices<N-1, N-1, Is...> {};
-template<std::size_t... Is>
-struct build_indices<0, Is...> : indices<Is...> {};
-template<std::size_t N>
-using IndicesFor = build_indices<N>;
-
-template<size_t... Indices>
-LuaFuctionData *functions(indices<Indices...>)
+bool LangLua::IsCallbackPresent(const char *name)
 {
-
-    static LuaFuctionData functions_[sizeof...(Indices)]{
-            F_<Indices>::F...
-    };
-
-    static_assert(
-            sizeof(functions_) / sizeof(functions_[0]) ==
-            sizeof(ScriptFunctions::functions) / sizeof(ScriptFunctions::functions[0]),
-            "Not all functions have been mapped to Lua");
-
-    return functions_;
+    return luabridge::getGlobal(lua, name).isFunction();
 }
-#else
-template<unsigned int I>
-struct C
-{
-    constexpr static void Fn(LuaFuctionData *functions_)
-    {
-        functions_[I] = F_<I>::F;
-        C<I - 1>::Fn(functions_);
-    }
-};
 
-template<>
-struct C<0>
+boost::any LangLua::Call(const char *name, const char *argl, int buf, ...)
 {
-    constexpr static void Fn(LuaFuctionData *functions_)
-    {
-        functions_[0] = F_<0>::F;
-    }
-};
+    va_list vargs;
+    va_start(vargs, buf);
 
-template<size_t LastI>
-LuaFuctionData *functions()
-{
+    int n_args = (int)(strlen(argl));
 
-    static LuaFuctionData functions_[LastI];
-    C<LastI - 1>::Fn(functions_);
+    lua_getglobal(lua, name);
+    PushArguments(argl, vargs);
 
-    static_assert(
-        sizeof(functions_) / sizeof(functions_[0]) ==
-        sizeof(ScriptFunctions::functions) / sizeof(ScriptFunctions::functions[0]),
-        "Not all functions have been mapped to Lua");
+    va_end(vargs);
 
-    return functions_;
+    luabridge::LuaException::pcall(lua, n_args, 1);
+    return boost::any(luabridge::LuaRef::fromStack(lua, -1));
 }
-#endif
 
-void LangLua::LoadProgram(const char *filename)
+void LangLua::CallCallback(unsigned int callbackId, const char *name, const char *argl, ...)
 {
-    int err = 0;
-
-    if ((err =luaL_loadfile(lua, filename)) != 0)
-        throw std::runtime_error("Lua script " + std::string(filename) + " error (" + std::to_string(err) + "): \"" +
-                            std::string(lua_tostring(lua, -1)) + "\"");
+    auto it = callbackRefs.find(callbackId);
+    const int ref = it != callbackRefs.end() ? it->second : ResolveCallback(callbackId, name);
 
-    constexpr auto functions_n = sizeof(ScriptFunctions::functions) / sizeof(ScriptFunctions::functions[0]);
+    if (ref == LUA_NOREF)
+        lua_getglobal(lua, name);
+    else
+        lua_rawgeti(lua, LUA_REGISTRYINDEX, ref);
 
-#ifdef __arm__
-    LuaFuctionData *functions_ = functions(IndicesFor<functions_n>{});
-#else
-    LuaFuctionData *functions_ = functions<sizeof(ScriptFunctions::functions) / sizeof(ScriptFunctions::functions[0])>();
-#endif
-    luabridge::Namespace tes3mp = luabridge::getGlobalNamespace(lua).beginNamespace("tes3mp");
-
-    for (unsigned i = 0; i < functions_n; i++)
-        tes3mp.addCFunction(functions_[i].name, functions_[i].func);
+    // The script may have removed the callback since it was first looked up
+    if (!lua_isfunction(lua, -1))
+    {
+        lua_pop(lua, 1);
+        return;
+    }
 
-    tes3mp.endNamespace();
+    va_list vargs;
+    va_start(vargs, argl);
 
-    if ((err = lua_pcall(lua, 0, 0, 0)) != 0) // Run once script for load in memory.
-        throw std::runtime_error("Lua script " + std::string(filename) + " error (" + std::to_string(err) + "): \"" +
-                            std::string(lua_tostring(lua, -1)) + "\"");
-}
+    PushArguments(argl, vargs);
 
-int LangLua::FreeProgram()
-{
-    lua_close(lua);
-    return 0;
-}
+    va_end(vargs);
 
-bool LangLua::IsCallbackPresent(const char *name)
-{
-    return luabridge::getGlobal(lua, name).isFunction();
+    luabridge::LuaException::pcall(lua, (int)(strlen(argl)), 0);
 }
 
-boost::any LangLua::Call(const char *name, const char *argl, int buf, ...)
+void LangLua::PushArguments(const char *argl, va_list vargs)
 {
-    va_list vargs;
-    va_start(vargs, buf);
-
     int n_args = (int)(strlen(argl));
 
-    lua_getglobal(lua, name);
-
     for (int index = 0; index < n_args; index++)
     {
         switch (argl[index])
@@ -249,11 +152,6 @@ boost::any LangLua::Call(const char *name, const char *argl, int buf, ...)
                 throw std::runtime_error("C++ call: Unknown argument identifier " + argl[index]);
         }
     }
-
-    va_end(vargs);
-
-    luabridge::LuaException::pcall(lua, n_args, 1);
-    return boost::any(luabridge::LuaRef::fromStack(lua, -1));
 }
 
 boost::any LangLua::Call(const char *name, const char *argl, const std::vector<boost::any> &args)
@@ -306,6 +204,98 @@ boost::any LangLua::Call(const char *name, const char *argl, const std::vector<b
     return boost::any(luabridge::LuaRef::fromStack(lua, -1));
 }
 
+/*
+    Callbacks are kept as registry references so calling them does not look them up by name each time
+
+    To notice a script assigning a new function to a callback's global, the callback is moved out of the
+    globals table into a shadow table that the globals table reads through its __index metamethod;
+    assigning to it then goes through __newindex, which updates the reference
+*/
+bool LangLua::WatchGlobals()
+{
+    if (globalsWatchState != WATCH_NONE)
+        return globalsWatchState == WATCH_ACTIVE;
+
+    // Leave globals tables that scripts have given their own metatable alone
+    if (lua_getmetatable(lua, LUA_GLOBALSINDEX))
+    {
+        lua_pop(lua, 1);
+        globalsWatchState = WATCH_UNAVAILABLE;
+        return false;
+    }
+
+    lua_createtable(lua, 0, 2);
+    lua_newtable(lua);
+
+    lua_pushvalue(lua, -1);
+    lua_setfield(lua, -3, "__index");
+
+    lua_pushlightuserdata(lua, this);
+    lua_insert(lua, -2);
+    lua_pushcclosure(lua, SetGlobal, 2);
+    lua_setfield(lua, -2, "__newindex");
+
+    lua_setmetatable(lua, LUA_GLOBALSINDEX);
+
+    globalsWatchState = WATCH_ACTIVE;
+    return true;
+}
+
+int LangLua::ResolveCallback(unsigned int callbackId, const char *name)
+{
+    if (!WatchGlobals())
+    {
+        callbackRefs[callbackId] = LUA_NOREF;
+        return LUA_NOREF;
+    }
+
+    lua_getglobal(lua, name);
+
+    // Move the function into the shadow table
+    lua_getmetatable(lua, LUA_GLOBALSINDEX);
+    lua_getfield(lua, -1, "__index");
+    lua_pushvalue(lua, -3);
+    lua_setfield(lua, -2, name);
+    lua_pop(lua, 2);
+
+    lua_pushnil(lua);
+    lua_setfield(lua, LUA_GLOBALSINDEX, name);
+
+    const int ref = luaL_ref(lua, LUA_REGISTRYINDEX);
+
+    callbackRefs[callbackId] = ref;
+    watchedCallbacks[name] = callbackId;
+
+    return ref;
+}
+
+int LangLua::SetGlobal(lua_State *lua)
+{
+    LangLua *langLua = static_cast<LangLua *>(lua_touserdata(lua, lua_upvalueindex(1)));
+
+    if (lua_type(lua, 2) == LUA_TSTRING)
+    {
+        auto it = langLua->watchedCallbacks.find(lua_tostring(lua, 2));
+
+        if (it != langLua->watchedCallbacks.end())
+        {
+            lua_pushvalue(lua, 2);
+            lua_pushvalue(lua, 3);
+            lua_rawset(lua, lua_upvalueindex(2));
+
+            int &ref = langLua->callbackRefs[it->second];
+            luaL_unref(lua, LUA_REGISTRYINDEX, ref);
+            lua_pushvalue(lua, 3);
+            ref = luaL_ref(lua, LUA_REGISTRYINDEX);
+
+            return 0;
+        }
+    }
+
+    lua_rawset(lua, 1);
+    return 0;
+}
+
 void LangLua::AddPackagePath(const std::string& path)
 {
     packagePath.emplace(path);
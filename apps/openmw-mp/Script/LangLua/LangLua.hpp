@@ -6,6 +6,9 @@
 #include <extern/LuaBridge/LuaBridge.h>
 #include <LuaBridge.h>
 #include <set>
+#include <string>
+#include <unordered_map>
+#include <cstdarg>
 
 #include <boost/any.hpp>
 #include "../ScriptFunction.hpp"
@@ -36,12 +39,33 @@ public:
     static int CreateTimer(lua_State *lua) noexcept;
     static int CreateTimerEx(lua_State *lua);
 
+    static int GetObjectList(lua_State *lua);
+    static int GetObjectListColumns(lua_State *lua);
+    static int GetContainerItems(lua_State *lua);
+    static int GetActorList(lua_State *lua);
+    static int GetActorListColumns(lua_State *lua);
+    static int AddObjects(lua_State *lua);
+    static int AddActors(lua_State *lua);
+
     virtual void LoadProgram(const char *filename) override;
     virtual int FreeProgram() override;
     virtual bool IsCallbackPresent(const char *name) override;
     virtual boost::any Call(const char *name, const char *argl, int buf, ...) override;
     virtual boost::any Call(const char *name, const char *argl, const std::vector<boost::any> &args) override;
+    virtual void CallCallback(unsigned int callbackId, const char *name, const char *argl, ...) override;
 private:
+    void PushArguments(const char *argl, va_list vargs);
+
+    bool WatchGlobals();
+    int ResolveCallback(unsigned int callbackId, const char *name);
+    static int SetGlobal(lua_State *lua);
+
+    // Registry references to callback functions, keyed by callback identity; LUA_NOREF means the callback
+    // is looked up by name on every call because the globals table could not be watched for changes
+    std::unordered_map<unsigned int, int> callbackRefs;
+    std::unordered_map<std::string, unsigned int> watchedCallbacks;
+    enum { WATCH_NONE, WATCH_ACTIVE, WATCH_UNAVAILABLE } globalsWatchState = WATCH_NONE;
+
     static std::set<std::string> packageCPath;
     static std::set<std::string> packagePath;
 };
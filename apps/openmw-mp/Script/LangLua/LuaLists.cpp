@@ -0,0 +1,475 @@
+#include "LangLua.hpp"
+
+#include <algorithm>
+
+#include <components/openmw-mp/Base/BaseActor.hpp>
+#include <components/openmw-mp/Base/BaseObject.hpp>
+
+#include <apps/openmw-mp/Player.hpp>
+
+/*
+    Bulk accessors for the object and actor lists used by the Objects and Actors script functions
+
+    Scripts that go through the per-field functions cross into C++ once for every field of every
+    object, so these let them read or write a whole list with a single call instead, either as one
+    table per entry or as one array per field
+*/
+
+extern mwmp::BaseObjectList *readObjectList;
+extern mwmp::BaseObjectList writeObjectList;
+
+extern mwmp::BaseActorList *readActorList;
+extern mwmp::BaseActorList writeActorList;
+
+namespace
+{
+    template<typename T>
+    struct LuaField
+    {
+        const char *name;
+        void (*push)(lua_State *lua, const T &value);
+        // Left empty for fields that can only be read
+        void (*set)(lua_State *lua, int index, T &value);
+    };
+
+    const LuaField<mwmp::BaseObject> objectFields[] = {
+        { "refId",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushstring(lua, object.refId.c_str()); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.refId = luaL_checkstring(lua, index); } },
+        { "refNum",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushinteger(lua, object.refNum); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.refNum = luaL_checkinteger(lua, index); } },
+        { "mpNum",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushinteger(lua, object.mpNum); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.mpNum = luaL_checkinteger(lua, index); } },
+        { "count",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushinteger(lua, object.count); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.count = luaL_checkinteger(lua, index); } },
+        { "charge",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushinteger(lua, object.charge); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.charge = luaL_checkinteger(lua, index); } },
+        { "enchantmentCharge",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushnumber(lua, object.enchantmentCharge); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.enchantmentCharge = luaL_checknumber(lua, index); } },
+        { "soul",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushstring(lua, object.soul.c_str()); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.soul = luaL_checkstring(lua, index); } },
+        { "goldValue",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushinteger(lua, object.goldValue); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.goldValue = luaL_checkinteger(lua, index); } },
+        { "scale",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushnumber(lua, object.scale); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.scale = luaL_checknumber(lua, index); } },
+        { "state",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushboolean(lua, object.objectState); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.objectState = lua_toboolean(lua, index); } },
+        { "lockLevel",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushinteger(lua, object.lockLevel); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.lockLevel = luaL_checkinteger(lua, index); } },
+        { "doorState",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushinteger(lua, object.doorState); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.doorState = luaL_checkinteger(lua, index); } },
+        { "goldPool",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushinteger(lua, object.goldPool); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.goldPool = luaL_checkinteger(lua, index); } },
+        { "lastGoldRestockHour",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushnumber(lua, object.lastGoldRestockHour); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.lastGoldRestockHour = luaL_checknumber(lua, index); } },
+        { "lastGoldRestockDay",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushinteger(lua, object.lastGoldRestockDay); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.lastGoldRestockDay = luaL_checkinteger(lua, index); } },
+        { "droppedByPlayer",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushboolean(lua, object.droppedByPlayer); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.droppedByPlayer = lua_toboolean(lua, index); } },
+        { "posX",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushnumber(lua, object.position.pos[0]); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.position.pos[0] = luaL_checknumber(lua, index); } },
+        { "posY",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushnumber(lua, object.position.pos[1]); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.position.pos[1] = luaL_checknumber(lua, index); } },
+        { "posZ",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushnumber(lua, object.position.pos[2]); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.position.pos[2] = luaL_checknumber(lua, index); } },
+        { "rotX",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushnumber(lua, object.position.rot[0]); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.position.rot[0] = luaL_checknumber(lua, index); } },
+        { "rotY",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushnumber(lua, object.position.rot[1]); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.position.rot[1] = luaL_checknumber(lua, index); } },
+        { "rotZ",
+            [](lua_State *lua, const mwmp::BaseObject &object) { lua_pushnumber(lua, object.position.rot[2]); },
+            [](lua_State *lua, int index, mwmp::BaseObject &object) { object.position.rot[2] = luaL_checknumber(lua, index); } },
+        { "pid",
+            [](lua_State *lua, const mwmp::BaseObject &object) {
+                Player *player = object.isPlayer ? Players::getPlayer(object.guid) : nullptr;
+                lua_pushinteger(lua, player != nullptr ? player->getId() : -1);
+            },
+            nullptr }
+    };
+
+    const LuaField<mwmp::ContainerItem> containerItemFields[] = {
+        { "refId",
+            [](lua_State *lua, const mwmp::ContainerItem &item) { lua_pushstring(lua, item.refId.c_str()); },
+            [](lua_State *lua, int index, mwmp::ContainerItem &item) { item.refId = luaL_checkstring(lua, index); } },
+        { "count",
+            [](lua_State *lua, const mwmp::ContainerItem &item) { lua_pushinteger(lua, item.count); },
+            [](lua_State *lua, int index, mwmp::ContainerItem &item) { item.count = luaL_checkinteger(lua, index); } },
+        { "charge",
+            [](lua_State *lua, const mwmp::ContainerItem &item) { lua_pushinteger(lua, item.charge); },
+            [](lua_State *lua, int index, mwmp::ContainerItem &item) { item.charge = luaL_checkinteger(lua, index); } },
+        { "enchantmentCharge",
+            [](lua_State *lua, const mwmp::ContainerItem &item) { lua_pushnumber(lua, item.enchantmentCharge); },
+            [](lua_State *lua, int index, mwmp::ContainerItem &item) { item.enchantmentCharge = luaL_checknumber(lua, index); } },
+        { "soul",
+            [](lua_State *lua, const mwmp::ContainerItem &item) { lua_pushstring(lua, item.soul.c_str()); },
+            [](lua_State *lua, int index, mwmp::ContainerItem &item) { item.soul = luaL_checkstring(lua, index); } },
+        { "actionCount",
+            [](lua_State *lua, const mwmp::ContainerItem &item) { lua_pushinteger(lua, item.actionCount); },
+            [](lua_State *lua, int index, mwmp::ContainerItem &item) { item.actionCount = luaL_checkinteger(lua, index); } }
+    };
+
+    const LuaField<mwmp::BaseActor> actorFields[] = {
+        { "refId",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushstring(lua, actor.refId.c_str()); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.refId = luaL_checkstring(lua, index); } },
+        { "refNum",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushinteger(lua, actor.refNum); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.refNum = luaL_checkinteger(lua, index); } },
+        { "mpNum",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushinteger(lua, actor.mpNum); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.mpNum = luaL_checkinteger(lua, index); } },
+        { "posX",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.position.pos[0]); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.position.pos[0] = luaL_checknumber(lua, index); } },
+        { "posY",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.position.pos[1]); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.position.pos[1] = luaL_checknumber(lua, index); } },
+        { "posZ",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.position.pos[2]); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.position.pos[2] = luaL_checknumber(lua, index); } },
+        { "rotX",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.position.rot[0]); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.position.rot[0] = luaL_checknumber(lua, index); } },
+        { "rotY",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.position.rot[1]); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.position.rot[1] = luaL_checknumber(lua, index); } },
+        { "rotZ",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.position.rot[2]); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.position.rot[2] = luaL_checknumber(lua, index); } },
+        { "healthBase",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.creatureStats.mDynamic[0].mBase); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.creatureStats.mDynamic[0].mBase = luaL_checknumber(lua, index); } },
+        { "healthCurrent",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.creatureStats.mDynamic[0].mCurrent); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.creatureStats.mDynamic[0].mCurrent = luaL_checknumber(lua, index); } },
+        { "healthModified",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.creatureStats.mDynamic[0].mMod); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.creatureStats.mDynamic[0].mMod = luaL_checknumber(lua, index); } },
+        { "magickaBase",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.creatureStats.mDynamic[1].mBase); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.creatureStats.mDynamic[1].mBase = luaL_checknumber(lua, index); } },
+        { "magickaCurrent",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.creatureStats.mDynamic[1].mCurrent); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.creatureStats.mDynamic[1].mCurrent = luaL_checknumber(lua, index); } },
+        { "magickaModified",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.creatureStats.mDynamic[1].mMod); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.creatureStats.mDynamic[1].mMod = luaL_checknumber(lua, index); } },
+        { "fatigueBase",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.creatureStats.mDynamic[2].mBase); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.creatureStats.mDynamic[2].mBase = luaL_checknumber(lua, index); } },
+        { "fatigueCurrent",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.creatureStats.mDynamic[2].mCurrent); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.creatureStats.mDynamic[2].mCurrent = luaL_checknumber(lua, index); } },
+        { "fatigueModified",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushnumber(lua, actor.creatureStats.mDynamic[2].mMod); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.creatureStats.mDynamic[2].mMod = luaL_checknumber(lua, index); } },
+        { "deathState",
+            [](lua_State *lua, const mwmp::BaseActor &actor) { lua_pushinteger(lua, actor.deathState); },
+            [](lua_State *lua, int index, mwmp::BaseActor &actor) { actor.deathState = luaL_checkinteger(lua, index); } }
+    };
+
+    // Use the table at the given stack index if there is one, or push a new one otherwise,
+    // and return the absolute stack index of the table being filled
+    int getTargetTable(lua_State *lua, int index, int arraySize, int recordSize)
+    {
+        if (lua_istable(lua, index))
+        {
+            lua_pushvalue(lua, index);
+            return lua_gettop(lua);
+        }
+
+        lua_createtable(lua, arraySize, recordSize);
+        return lua_gettop(lua);
+    }
+
+    // Remove entries left over in a reused array from an earlier, longer list
+    void truncateArray(lua_State *lua, int table, int size)
+    {
+        for (int i = size + 1;; ++i)
+        {
+            lua_rawgeti(lua, table, i);
+            const bool isNil = lua_isnil(lua, -1);
+            lua_pop(lua, 1);
+
+            if (isNil)
+                break;
+
+            lua_pushnil(lua);
+            lua_rawseti(lua, table, i);
+        }
+    }
+
+    // Push the table that holds the entry at the given array position of a reused table,
+    // creating it if the position was empty
+    template<typename T, std::size_t N>
+    void pushRowTable(lua_State *lua, int table, int position, const LuaField<T> (&)[N])
+    {
+        lua_rawgeti(lua, table, position);
+
+        if (!lua_istable(lua, -1))
+        {
+            lua_pop(lua, 1);
+            lua_createtable(lua, 0, N);
+            lua_pushvalue(lua, -1);
+            lua_rawseti(lua, table, position);
+        }
+    }
+
+    template<typename T, std::size_t N>
+    void setRowFields(lua_State *lua, int row, const T &value, const LuaField<T> (&fields)[N])
+    {
+        for (const LuaField<T> &field : fields)
+        {
+            field.push(lua, value);
+            lua_setfield(lua, row, field.name);
+        }
+    }
+
+    template<typename T, std::size_t N>
+    void readRowFields(lua_State *lua, int row, T &value, const LuaField<T> (&fields)[N])
+    {
+        for (const LuaField<T> &field : fields)
+        {
+            if (field.set == nullptr)
+                continue;
+
+            lua_getfield(lua, row, field.name);
+
+            if (!lua_isnil(lua, -1))
+                field.set(lua, lua_gettop(lua), value);
+
+            lua_pop(lua, 1);
+        }
+    }
+
+    template<typename T, std::size_t N>
+    int pushRows(lua_State *lua, int targetIndex, const T *values, int size, const LuaField<T> (&fields)[N])
+    {
+        const int table = getTargetTable(lua, targetIndex, size, 0);
+
+        for (int i = 0; i < size; ++i)
+        {
+            pushRowTable(lua, table, i + 1, fields);
+            setRowFields(lua, lua_gettop(lua), values[i], fields);
+            lua_pop(lua, 1);
+        }
+
+        truncateArray(lua, table, size);
+        return table;
+    }
+
+    // Fill one array per field, reusing only the columns already present in a passed table so
+    // scripts can ask for the fields they need, or every column for a new table
+    template<typename T, std::size_t N>
+    int pushColumns(lua_State *lua, int targetIndex, const T *values, int size, const LuaField<T> (&fields)[N])
+    {
+        const bool isReused = lua_istable(lua, targetIndex);
+        const int table = getTargetTable(lua, targetIndex, 0, N);
+
+        for (const LuaField<T> &field : fields)
+        {
+            lua_getfield(lua, table, field.name);
+
+            if (!lua_istable(lua, -1))
+            {
+                lua_pop(lua, 1);
+
+                if (isReused)
+                    continue;
+
+                lua_createtable(lua, size, 0);
+                lua_pushvalue(lua, -1);
+                lua_setfield(lua, table, field.name);
+            }
+
+            const int column = lua_gettop(lua);
+
+            for (int i = 0; i < size; ++i)
+            {
+                field.push(lua, values[i]);
+                lua_rawseti(lua, column, i + 1);
+            }
+
+            truncateArray(lua, column, size);
+            lua_pop(lua, 1);
+        }
+
+        return table;
+    }
+
+    int getObjectListSize()
+    {
+        if (readObjectList == nullptr)
+            return 0;
+
+        return static_cast<int>(std::min<std::size_t>(readObjectList->baseObjectCount, readObjectList->baseObjects.size()));
+    }
+
+    int getActorListSize()
+    {
+        if (readActorList == nullptr)
+            return 0;
+
+        return static_cast<int>(std::min<std::size_t>(readActorList->count, readActorList->baseActors.size()));
+    }
+
+    void pushContainerItems(lua_State *lua, int targetIndex, const mwmp::BaseObject &object)
+    {
+        const int size = static_cast<int>(std::min<std::size_t>(object.containerItemCount, object.containerItems.size()));
+        pushRows(lua, targetIndex, object.containerItems.data(), size, containerItemFields);
+    }
+
+    void readContainerItems(lua_State *lua, int items, mwmp::BaseObject &object)
+    {
+        const int size = static_cast<int>(lua_objlen(lua, items));
+
+        for (int i = 1; i <= size; ++i)
+        {
+            lua_rawgeti(lua, items, i);
+            luaL_checktype(lua, -1, LUA_TTABLE);
+
+            mwmp::ContainerItem item = {};
+            readRowFields(lua, lua_gettop(lua), item, containerItemFields);
+            object.containerItems.push_back(item);
+
+            lua_pop(lua, 1);
+        }
+    }
+}
+
+int LangLua::GetObjectList(lua_State *lua)
+{
+    const int size = getObjectListSize();
+    const int table = getTargetTable(lua, 1, size, 0);
+
+    for (int i = 0; i < size; ++i)
+    {
+        const mwmp::BaseObject &object = readObjectList->baseObjects[i];
+
+        pushRowTable(lua, table, i + 1, objectFields);
+        const int row = lua_gettop(lua);
+        setRowFields(lua, row, object, objectFields);
+
+        if (object.hasContainer)
+        {
+            lua_getfield(lua, row, "containerItems");
+            pushContainerItems(lua, lua_gettop(lua), object);
+            lua_setfield(lua, row, "containerItems");
+            lua_pop(lua, 1);
+        }
+        else
+        {
+            lua_pushnil(lua);
+            lua_setfield(lua, row, "containerItems");
+        }
+
+        lua_pop(lua, 1);
+    }
+
+    truncateArray(lua, table, size);
+    return 1;
+}
+
+int LangLua::GetObjectListColumns(lua_State *lua)
+{
+    const int size = getObjectListSize();
+    pushColumns(lua, 1, size > 0 ? readObjectList->baseObjects.data() : nullptr, size, objectFields);
+    return 1;
+}
+
+int LangLua::GetContainerItems(lua_State *lua)
+{
+    const int objectIndex = luaL_checkinteger(lua, 1);
+
+    if (objectIndex < 0 || objectIndex >= getObjectListSize())
+        return luaL_argerror(lua, 1, "object index out of range");
+
+    pushContainerItems(lua, 2, readObjectList->baseObjects[objectIndex]);
+    return 1;
+}
+
+int LangLua::GetActorList(lua_State *lua)
+{
+    const int size = getActorListSize();
+    pushRows(lua, 1, size > 0 ? readActorList->baseActors.data() : nullptr, size, actorFields);
+    return 1;
+}
+
+int LangLua::GetActorListColumns(lua_State *lua)
+{
+    const int size = getActorListSize();
+    pushColumns(lua, 1, size > 0 ? readActorList->baseActors.data() : nullptr, size, actorFields);
+    return 1;
+}
+
+int LangLua::AddObjects(lua_State *lua)
+{
+    luaL_checktype(lua, 1, LUA_TTABLE);
+    const int size = static_cast<int>(lua_objlen(lua, 1));
+
+    writeObjectList.baseObjects.reserve(writeObjectList.baseObjects.size() + size);
+
+    for (int i = 1; i <= size; ++i)
+    {
+        lua_rawgeti(lua, 1, i);
+        luaL_checktype(lua, -1, LUA_TTABLE);
+        const int row = lua_gettop(lua);
+
+        mwmp::BaseObject object = {};
+        readRowFields(lua, row, object, objectFields);
+
+        lua_getfield(lua, row, "containerItems");
+
+        if (lua_istable(lua, -1))
+            readContainerItems(lua, lua_gettop(lua), object);
+
+        lua_pop(lua, 2);
+
+        writeObjectList.baseObjects.push_back(std::move(object));
+    }
+
+    return 0;
+}
+
+int LangLua::AddActors(lua_State *lua)
+{
+    luaL_checktype(lua, 1, LUA_TTABLE);
+    const int size = static_cast<int>(lua_objlen(lua, 1));
+
+    writeActorList.baseActors.reserve(writeActorList.baseActors.size() + size);
+
+    for (int i = 1; i <= size; ++i)
+    {
+        lua_rawgeti(lua, 1, i);
+        luaL_checktype(lua, -1, LUA_TTABLE);
+
+        mwmp::BaseActor actor;
+        readRowFields(lua, lua_gettop(lua), actor, actorFields);
+
+        lua_pop(lua, 1);
+
+        writeActorList.baseActors.push_back(std::move(actor));
+    }
+
+    return 0;
+}
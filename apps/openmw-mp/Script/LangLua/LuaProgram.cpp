@@ -0,0 +1,153 @@
+#include "LangLua.hpp"
+#include <Script/Script.hpp>
+#include <Script/Types.hpp>
+
+/*
+    Loading a script and registering the server's script functions with it, kept apart from the rest of
+    LangLua so calling into scripts can be built without the script functions
+*/
+
+template<unsigned int I, unsigned int F>
+struct Lua_dispatch_ {
+    template<typename R, typename... Args>
+    inline static R Lua_dispatch(lua_State*&& lua, Args&&... args) noexcept {
+        constexpr ScriptFunctionData const& F_ = ScriptFunctions::functions[F];
+        auto arg = luabridge::Stack<typename CharType<F_.func.types[I - 1]>::type>::get(lua, I);
+        return Lua_dispatch_<I - 1, F>::template Lua_dispatch<R>(
+                std::forward<lua_State*>(lua),
+                arg,
+                std::forward<Args>(args)...);
+    }
+};
+
+template<unsigned int F>
+struct Lua_dispatch_<0, F> {
+    template<typename R, typename... Args>
+    inline static R Lua_dispatch(lua_State*&&, Args&&... args) noexcept {
+        constexpr ScriptFunctionData const& F_ = ScriptFunctions::functions[F];
+        return reinterpret_cast<FunctionEllipsis<R>>(F_.func.addr)(std::forward<Args>(args)...);
+    }
+};
+
+template<unsigned int I>
+static typename std::enable_if<ScriptFunctions::functions[I].func.ret == 'v', int>::type wrapper(lua_State* lua) noexcept {
+    Lua_dispatch_<ScriptFunctions::functions[I].func.numargs, I>::template Lua_dispatch<void>(std::forward<lua_State*>(lua));
+    return 0;
+}
+
+template<unsigned int I>
+static typename std::enable_if<ScriptFunctions::functions[I].func.ret != 'v', int>::type wrapper(lua_State* lua) noexcept {
+    auto ret = Lua_dispatch_<ScriptFunctions::functions[I].func.numargs, I>::template Lua_dispatch<
+            typename CharType<ScriptFunctions::functions[I].func.ret>::type>(std::forward<lua_State*>(lua));
+    luabridge::Stack <typename CharType<ScriptFunctions::functions[I].func.ret>::type>::push (lua, ret);
+    return 1;
+}
+
+template<unsigned int I>
+struct F_
+{
+    static constexpr LuaFuctionData F{ScriptFunctions::functions[I].name, wrapper<I>};
+};
+
+
+template<> struct F_<0> { static constexpr LuaFuctionData F{"CreateTimer", LangLua::CreateTimer}; };
+template<> struct F_<1> { static constexpr LuaFuctionData F{"CreateTimerEx", LangLua::CreateTimerEx}; };
+template<> struct F_<2> { static constexpr LuaFuctionData F{"MakePublic", LangLua::MakePublic}; };
+template<> struct F_<3> { static constexpr LuaFuctionData F{"CallPublic", LangLua::CallPublic}; };
+
+#ifdef __arm__
+template<std::size_t... Is>
+struct indices {};
+template<std::size_t N, std::size_t... Is>
+struct build_indices : build_indices<N-1, N-1, Is...> {};
+template<std::size_t... Is>
+struct build_indices<0, Is...> : indices<Is...> {};
+template<std::size_t N>
+using IndicesFor = build_indices<N>;
+
+template<size_t... Indices>
+LuaFuctionData *functions(indices<Indices...>)
+{
+
+    static LuaFuctionData functions_[sizeof...(Indices)]{
+            F_<Indices>::F...
+    };
+
+    static_assert(
+            sizeof(functions_) / sizeof(functions_[0]) ==
+            sizeof(ScriptFunctions::functions) / sizeof(ScriptFunctions::functions[0]),
+            "Not all functions have been mapped to Lua");
+
+    return functions_;
+}
+#else
+template<unsigned int I>
+struct C
+{
+    constexpr static void Fn(LuaFuctionData *functions_)
+    {
+        functions_[I] = F_<I>::F;
+        C<I - 1>::Fn(functions_);
+    }
+};
+
+template<>
+struct C<0>
+{
+    constexpr static void Fn(LuaFuctionData *functions_)
+    {
+        functions_[0] = F_<0>::F;
+    }
+};
+
+template<size_t LastI>
+LuaFuctionData *functions()
+{
+
+    static LuaFuctionData functions_[LastI];
+    C<LastI - 1>::Fn(functions_);
+
+    static_assert(
+        sizeof(functions_) / sizeof(functions_[0]) ==
+        sizeof(ScriptFunctions::functions) / sizeof(ScriptFunctions::functions[0]),
+        "Not all functions have been mapped to Lua");
+
+    return functions_;
+}
+#endif
+
+void LangLua::LoadProgram(const char *filename)
+{
+    int err = 0;
+
+    if ((err =luaL_loadfile(lua, filename)) != 0)
+        throw std::runtime_error("Lua script " + std::string(filename) + " error (" + std::to_string(err) + "): \"" +
+                            std::string(lua_tostring(lua, -1)) + "\"");
+
+    constexpr auto functions_n = sizeof(ScriptFunctions::functions) / sizeof(ScriptFunctions::functions[0]);
+
+#ifdef __arm__
+    LuaFuctionData *functions_ = functions(IndicesFor<functions_n>{});
+#else
+    LuaFuctionData *functions_ = functions<sizeof(ScriptFunctions::functions) / sizeof(ScriptFunctions::functions[0])>();
+#endif
+    luabridge::Namespace tes3mp = luabridge::getGlobalNamespace(lua).beginNamespace("tes3mp");
+
+    for (unsigned i = 0; i < functions_n; i++)
+        tes3mp.addCFunction(functions_[i].name, functions_[i].func);
+
+    // Bulk list accessors that return or take Lua tables, so they have no counterpart in ScriptFunctions
+    tes3mp.addCFunction("GetObjectList", LangLua::GetObjectList);
+    tes3mp.addCFunction("GetObjectListColumns", LangLua::GetObjectListColumns);
+    tes3mp.addCFunction("GetContainerItems", LangLua::GetContainerItems);
+    tes3mp.addCFunction("GetActorList", LangLua::GetActorList);
+    tes3mp.addCFunction("GetActorListColumns", LangLua::GetActorListColumns);
+    tes3mp.addCFunction("AddObjects", LangLua::AddObjects);
+    tes3mp.addCFunction("AddActors", LangLua::AddActors);
+
+    tes3mp.endNamespace();
+
+    if ((err = lua_pcall(lua, 0, 0, 0)) != 0) // Run once script for load in memory.
+        throw std::runtime_error("Lua script " + std::string(filename) + " error (" + std::to_string(err) + "): \"" +
+                            std::string(lua_tostring(lua, -1)) + "\"");
+}
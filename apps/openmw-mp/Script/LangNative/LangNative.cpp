@@ -78,6 +78,13 @@ boost::any LangNative::Call(const char *name, const char *argl, const std::vecto
     return nullptr;
 }
 
+void LangNative::CallCallback(unsigned int callbackId, const char *name, const char *argl, ...)
+{
+    // Script::Call never comes through here, because it calls the callbacks of native scripts through the
+    // function pointers it gets from their libraries, with the callback's own argument types, which can't
+    // be recovered from a variadic argument list
+}
+
 
 lib_t LangNative::GetInterface()
 {
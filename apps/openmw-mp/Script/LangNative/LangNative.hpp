@@ -17,6 +17,7 @@ public:
     virtual bool IsCallbackPresent(const char *name) override;
     virtual boost::any Call(const char *name, const char *argl, int buf, ...) override;
     virtual boost::any Call(const char *name, const char *argl, const std::vector<boost::any> &args) override;
+    virtual void CallCallback(unsigned int callbackId, const char *name, const char *argl, ...) override;
 
 };
 
@@ -15,6 +15,9 @@ public:
     virtual bool IsCallbackPresent(const char* name) = 0;
     virtual boost::any Call(const char* name, const char* argl, int buf, ...) = 0;
     virtual boost::any Call(const char* name, const char* argl, const std::vector<boost::any>& args) = 0;
+    // Call a script callback whose identity stays the same for the lifetime of the program,
+    // letting the language resolve it once instead of by name on every call
+    virtual void CallCallback(unsigned int callbackId, const char* name, const char* argl, ...) = 0;
 
     virtual lib_t GetInterface() = 0;
 
@@ -96,7 +96,7 @@ public:
             {
                 try
                 {
-                    script->lang->Call(data.name, data.callback.types, B, std::forward<Args>(args)...);
+                    script->lang->CallCallback(I, data.name, data.callback.types, std::forward<Args>(args)...);
                 }
                 catch (std::exception &e)
                 {
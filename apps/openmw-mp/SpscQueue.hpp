@@ -0,0 +1,73 @@
+#ifndef OPENMW_SPSCQUEUE_HPP
+#define OPENMW_SPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/*
+    Bounded lock-free queue for handing items from exactly one producer thread to exactly one
+    consumer thread
+
+    The capacity is rounded up to a power of two, and push fails instead of blocking when the
+    queue is full
+*/
+template<typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(std::size_t capacity) : head(0), tail(0)
+    {
+        std::size_t size = 2;
+
+        while (size < capacity)
+            size *= 2;
+
+        items.resize(size);
+        mask = size - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Only called by the producer
+    bool push(const T &item)
+    {
+        const std::size_t currentTail = tail.load(std::memory_order_relaxed);
+
+        if (currentTail - head.load(std::memory_order_acquire) > mask)
+            return false;
+
+        items[currentTail & mask] = item;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Only called by the consumer
+    bool pop(T &item)
+    {
+        const std::size_t currentHead = head.load(std::memory_order_relaxed);
+
+        if (currentHead == tail.load(std::memory_order_acquire))
+            return false;
+
+        item = items[currentHead & mask];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+private:
+    std::vector<T> items;
+    std::size_t mask;
+
+    // Kept on separate cache lines so the producer and consumer do not keep invalidating each other
+    alignas(64) std::atomic<std::size_t> head;
+    alignas(64) std::atomic<std::size_t> tail;
+};
+
+#endif //OPENMW_SPSCQUEUE_HPP
@@ -268,6 +268,28 @@ int main(int argc, char *argv[])
         Networking networking(peer);
         networking.setServerPassword(password);
 
+        int tickRate = mgr.getInt("tickRate", "General");
+
+        if (tickRate < 1 || tickRate > 1000)
+        {
+            tickRate = 60;
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Switching to tickRate %i because the one in the server config was outside the 1-1000 range",
+                tickRate);
+        }
+
+        networking.setTickRate(tickRate);
+
+        int decoderThreads = mgr.getInt("decoderThreads", "General");
+
+        if (decoderThreads < 0 || decoderThreads > 64)
+        {
+            decoderThreads = 4;
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Switching to decoderThreads %i because the one in the server config was outside the 0-64 range",
+                decoderThreads);
+        }
+
+        networking.setDecoderThreads(decoderThreads);
+
         if (mgr.getBool("enabled", "MasterServer"))
         {
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sharing server query info to master enabled.");
@@ -13,31 +13,57 @@ void ActorProcessor::Do(ActorPacket &packet, Player &player, BaseActorList &acto
 
 bool ActorProcessor::Process(RakNet::Packet &packet, BaseActorList &actorList) noexcept
 {
+    Player *player = Players::getPlayer(packet.guid);
+    ActorPacket *myPacket = Networking::get().getActorPacketController()->GetPacket(packet.data[0]);
+
+    if (!Decode(packet, *myPacket, player->getPositionDeltaState(), actorList))
+        return false;
+
+    return Apply(packet, actorList);
+}
+
+bool ActorProcessor::Decode(RakNet::Packet &packet, ActorPacket &myPacket, PositionDeltaState *deltaState,
+                            BaseActorList &actorList) noexcept
+{
+    ActorProcessor *processor = GetProcessor(packet.data[0]);
+
+    if (processor == nullptr)
+        return false;
+
     // Clear our BaseActorList before loading new data in it
     actorList.cell.blank();
     actorList.baseActors.clear();
     actorList.guid = packet.guid;
 
-    for (auto &processor : processors)
+    myPacket.setActorList(&actorList);
+    actorList.isValid = true;
+
+    if (!processor->avoidReading)
     {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            ActorPacket *myPacket = Networking::get().getActorPacketController()->GetPacket(packet.data[0]);
+        myPacket.setDeltaState(deltaState);
+        myPacket.Read();
+        myPacket.setDeltaState(nullptr);
+    }
 
-            myPacket->setActorList(&actorList);
-            actorList.isValid = true;
+    return true;
+}
 
-            if (!processor.second->avoidReading)
-                myPacket->Read();
+bool ActorProcessor::Apply(RakNet::Packet &packet, BaseActorList &actorList) noexcept
+{
+    ActorProcessor *processor = GetProcessor(packet.data[0]);
 
-            if (actorList.isValid)
-                processor.second->Do(*myPacket, *player, actorList);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
+    if (processor == nullptr)
+        return false;
 
-            return true;
-        }
-    }
-    return false;
+    Player *player = Players::getPlayer(packet.guid);
+    ActorPacket *myPacket = Networking::get().getActorPacketController()->GetPacket(packet.data[0]);
+
+    myPacket->setActorList(&actorList);
+
+    if (actorList.isValid)
+        processor->Do(*myPacket, *player, actorList);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
+
+    return true;
 }
@@ -18,6 +18,13 @@ namespace mwmp
         virtual void Do(ActorPacket &packet, Player &player, BaseActorList &actorList);
 
         static bool Process(RakNet::Packet &packet, BaseActorList &actorList) noexcept;
+
+        // Read a packet into an actor list without touching any state owned by the main thread,
+        // so PacketDecoder can call it from its worker threads
+        static bool Decode(RakNet::Packet &packet, ActorPacket &myPacket, PositionDeltaState *deltaState,
+                           BaseActorList &actorList) noexcept;
+        // Handle an actor list that has already been decoded
+        static bool Apply(RakNet::Packet &packet, BaseActorList &actorList) noexcept;
     };
 }
 
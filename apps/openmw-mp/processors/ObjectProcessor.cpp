@@ -13,31 +13,57 @@ void ObjectProcessor::Do(ObjectPacket &packet, Player &player, BaseObjectList &o
 
 bool ObjectProcessor::Process(RakNet::Packet &packet, BaseObjectList &objectList) noexcept
 {
+    Player *player = Players::getPlayer(packet.guid);
+    ObjectPacket *myPacket = Networking::get().getObjectPacketController()->GetPacket(packet.data[0]);
+
+    if (!Decode(packet, *myPacket, player->getRecordIdState(), objectList))
+        return false;
+
+    return Apply(packet, objectList);
+}
+
+bool ObjectProcessor::Decode(RakNet::Packet &packet, ObjectPacket &myPacket, RecordIdState *recordIdState,
+                             BaseObjectList &objectList) noexcept
+{
+    ObjectProcessor *processor = GetProcessor(packet.data[0]);
+
+    if (processor == nullptr)
+        return false;
+
     // Clear our BaseObjectList before loading new data in it
     objectList.cell.blank();
     objectList.baseObjects.clear();
     objectList.guid = packet.guid;
 
-    for (auto &processor : processors)
+    myPacket.setObjectList(&objectList);
+    objectList.isValid = true;
+
+    if (!processor->avoidReading)
     {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            ObjectPacket *myPacket = Networking::get().getObjectPacketController()->GetPacket(packet.data[0]);
-
-            myPacket->setObjectList(&objectList);
-            objectList.isValid = true;
-
-            if (!processor.second->avoidReading)
-                myPacket->Read();
-
-            if (objectList.isValid)
-                processor.second->Do(*myPacket, *player, objectList);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
-            
-            return true;
-        }
+        myPacket.setRecordIdState(recordIdState);
+        myPacket.Read();
+        myPacket.setRecordIdState(nullptr);
     }
-    return false;
+
+    return true;
+}
+
+bool ObjectProcessor::Apply(RakNet::Packet &packet, BaseObjectList &objectList) noexcept
+{
+    ObjectProcessor *processor = GetProcessor(packet.data[0]);
+
+    if (processor == nullptr)
+        return false;
+
+    Player *player = Players::getPlayer(packet.guid);
+    ObjectPacket *myPacket = Networking::get().getObjectPacketController()->GetPacket(packet.data[0]);
+
+    myPacket->setObjectList(&objectList);
+
+    if (objectList.isValid)
+        processor->Do(*myPacket, *player, objectList);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
+
+    return true;
 }
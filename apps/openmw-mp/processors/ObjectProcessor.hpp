@@ -18,6 +18,13 @@ namespace mwmp
         virtual void Do(ObjectPacket &packet, Player &player, BaseObjectList &objectList);
 
         static bool Process(RakNet::Packet &packet, BaseObjectList &objectList) noexcept;
+
+        // Read a packet into an object list without touching any state owned by the main thread,
+        // so PacketDecoder can call it from its worker threads
+        static bool Decode(RakNet::Packet &packet, ObjectPacket &myPacket, RecordIdState *recordIdState,
+                           BaseObjectList &objectList) noexcept;
+        // Handle an object list that has already been decoded
+        static bool Apply(RakNet::Packet &packet, BaseObjectList &objectList) noexcept;
     };
 }
 
@@ -8,20 +8,24 @@ typename BasePacketProcessor<T>::processors_t BasePacketProcessor<T>::processors
 
 bool PlayerProcessor::Process(RakNet::Packet &packet) noexcept
 {
-    for (auto &processor : processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            Player *player = Players::getPlayer(packet.guid);
-            PlayerPacket *myPacket = Networking::get().getPlayerPacketController()->GetPacket(packet.data[0]);
-            myPacket->setPlayer(player);
+    PlayerProcessor *processor = GetProcessor(packet.data[0]);
+
+    if (processor == nullptr)
+        return false;
 
-            if (!processor.second->avoidReading)
-                myPacket->Read();
+    Player *player = Players::getPlayer(packet.guid);
+    PlayerPacket *myPacket = Networking::get().getPlayerPacketController()->GetPacket(packet.data[0]);
+    myPacket->setPlayer(player);
 
-            processor.second->Do(*myPacket, *player);
-            return true;
-        }
+    if (!processor->avoidReading)
+    {
+        myPacket->setDeltaState(player->getPositionDeltaState());
+        myPacket->setRecordIdState(player->getRecordIdState());
+        myPacket->Read();
+        myPacket->setDeltaState(nullptr);
+        myPacket->setRecordIdState(nullptr);
     }
-    return false;
+
+    processor->Do(*myPacket, *player);
+    return true;
 }
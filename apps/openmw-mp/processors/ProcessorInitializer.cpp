@@ -56,6 +56,7 @@
 #include "actor/ProcessorActorSpeech.hpp"
 #include "actor/ProcessorActorSpellsActive.hpp"
 #include "actor/ProcessorActorStatsDynamic.hpp"
+#include "actor/ProcessorActorUpdate.hpp"
 #include "ObjectProcessor.hpp"
 #include "object/ProcessorConsoleCommand.hpp"
 #include "object/ProcessorContainer.hpp"
@@ -82,6 +83,7 @@
 #include "object/ProcessorVideoPlay.hpp"
 #include "WorldstateProcessor.hpp"
 #include "worldstate/ProcessorClientScriptGlobal.hpp"
+#include "worldstate/ProcessorRecordCache.hpp"
 #include "worldstate/ProcessorRecordDynamic.hpp"
 #include "worldstate/ProcessorWorldKillCount.hpp"
 #include "worldstate/ProcessorWorldMap.hpp"
@@ -143,6 +145,7 @@ void ProcessorInitializer()
     ActorProcessor::AddProcessor(new ProcessorActorSpellsActive());
     ActorProcessor::AddProcessor(new ProcessorActorStatsDynamic());
     ActorProcessor::AddProcessor(new ProcessorActorTest());
+    ActorProcessor::AddProcessor(new ProcessorActorUpdate());
 
     ObjectProcessor::AddProcessor(new ProcessorConsoleCommand());
     ObjectProcessor::AddProcessor(new ProcessorContainer());
@@ -169,6 +172,7 @@ void ProcessorInitializer()
     ObjectProcessor::AddProcessor(new ProcessorVideoPlay());
 
     WorldstateProcessor::AddProcessor(new ProcessorClientScriptGlobal());
+    WorldstateProcessor::AddProcessor(new ProcessorRecordCache());
     WorldstateProcessor::AddProcessor(new ProcessorRecordDynamic());
     WorldstateProcessor::AddProcessor(new ProcessorWorldKillCount());
     WorldstateProcessor::AddProcessor(new ProcessorWorldMap());
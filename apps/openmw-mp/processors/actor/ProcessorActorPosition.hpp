@@ -21,7 +21,7 @@ namespace mwmp
             if (serverCell != nullptr && *serverCell->getAuthority() == actorList.guid)
             {
                 serverCell->readActorList(packetID, &actorList);
-                serverCell->sendToLoaded(&packet, &actorList);
+                CellController::get()->queueActorPositions(serverCell, &actorList);
             }
         }
     };
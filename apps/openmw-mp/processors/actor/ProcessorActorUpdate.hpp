@@ -0,0 +1,30 @@
+#ifndef OPENMW_PROCESSORACTORUPDATE_HPP
+#define OPENMW_PROCESSORACTORUPDATE_HPP
+
+#include "../ActorProcessor.hpp"
+
+namespace mwmp
+{
+    class ProcessorActorUpdate : public ActorProcessor
+    {
+    public:
+        ProcessorActorUpdate()
+        {
+            BPP_INIT(ID_ACTOR_UPDATE)
+        }
+
+        void Do(ActorPacket &packet, Player &player, BaseActorList &actorList) override
+        {
+            // Send only to players who have the cell loaded
+            Cell *serverCell = CellController::get()->getCell(&actorList.cell);
+
+            if (serverCell != nullptr && *serverCell->getAuthority() == actorList.guid)
+            {
+                serverCell->readActorList(packetID, &actorList);
+                serverCell->sendToLoaded(&packet, &actorList);
+            }
+        }
+    };
+}
+
+#endif //OPENMW_PROCESSORACTORUPDATE_HPP
@@ -33,6 +33,10 @@ namespace mwmp
 
                 other->exchangeFullInfo = true;
 
+                // Positions sent outside of the tick carry no server time, so clients snap to them
+                // instead of interpolating toward them
+                other->positionTimestamp = 0;
+
                 playerController->GetPacket(ID_PLAYER_STATS_DYNAMIC)->setPlayer(other);
                 playerController->GetPacket(ID_PLAYER_ATTRIBUTE)->setPlayer(other);
                 playerController->GetPacket(ID_PLAYER_POSITION)->setPlayer(other);
@@ -68,6 +72,7 @@ namespace mwmp
                 LOG_APPEND(TimedLog::LOG_INFO, "- Finished information exchange with %s", other->npc.mName.c_str());
             });
 
+            player.positionTimestamp = 0;
             playerController->GetPacket(ID_PLAYER_POSITION)->setPlayer(&player);
             playerController->GetPacket(ID_PLAYER_POSITION)->Send();
             packet.setPlayer(&player);
@@ -17,6 +17,9 @@ namespace mwmp
         {
             DEBUG_PRINTF(strPacketID.c_str());
 
+            if (!packet.isPacketValid())
+                return;
+
             Script::Call<Script::CallbackIdentity("OnPlayerInventory")>(player.getId());
         }
     };
@@ -2,6 +2,7 @@
 #define OPENMW_PROCESSORPLAYERPOSITION_HPP
 
 #include "../PlayerProcessor.hpp"
+#include "apps/openmw-mp/Networking.hpp"
 
 namespace mwmp
 {
@@ -15,7 +16,8 @@ namespace mwmp
 
         void Do(PlayerPacket &packet, Player &player) override
         {
-            player.sendToLoaded(&packet);
+            if (packet.isPacketValid())
+                Networking::getPtr()->queuePlayerPosition(&player);
         }
     };
 }
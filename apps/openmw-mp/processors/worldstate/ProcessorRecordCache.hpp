@@ -0,0 +1,29 @@
+#ifndef OPENMW_PROCESSORRECORDCACHE_HPP
+#define OPENMW_PROCESSORRECORDCACHE_HPP
+
+#include "../WorldstateProcessor.hpp"
+
+namespace mwmp
+{
+    class ProcessorRecordCache : public WorldstateProcessor
+    {
+    public:
+        ProcessorRecordCache()
+        {
+            BPP_INIT(ID_RECORD_CACHE)
+        }
+
+        void Do(WorldstatePacket &packet, Player &player, BaseWorldstate &worldstate) override
+        {
+            DEBUG_PRINTF(strPacketID.c_str());
+
+            std::unordered_set<uint64_t> *knownRecords = player.getKnownRecords();
+            knownRecords->insert(worldstate.cachedRecords.begin(), worldstate.cachedRecords.end());
+
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Received %s with %u cached records from player %s",
+                strPacketID.c_str(), (unsigned int) worldstate.cachedRecords.size(), player.guid.ToString());
+        }
+    };
+}
+
+#endif //OPENMW_PROCESSORRECORDCACHE_HPP
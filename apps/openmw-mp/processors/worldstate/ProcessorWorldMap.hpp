@@ -17,8 +17,45 @@ namespace mwmp
         {
             DEBUG_PRINTF(strPacketID.c_str());
 
+            if (worldstate.mapTilesAction == BaseWorldstate::MAP_TILES_REQUEST)
+            {
+                sendRequestedTiles(packet, player, worldstate);
+                return;
+            }
+            else if (worldstate.mapTilesAction == BaseWorldstate::MAP_TILES_CACHED)
+            {
+                for (const auto &cachedTile : worldstate.mapTiles)
+                    player.removeCachedMapTile(cachedTile);
+
+                return;
+            }
+
             Script::Call<Script::CallbackIdentity("OnWorldMap")>(player.getId());
         }
+
+    private:
+        // Always reply, even if none of the tiles are still around, because the player waits for
+        // each chunk before asking for the next one
+        void sendRequestedTiles(WorldstatePacket &packet, Player &player, BaseWorldstate &worldstate)
+        {
+            BaseWorldstate chunk;
+            chunk.guid = player.guid;
+            chunk.mapTilesAction = BaseWorldstate::MAP_TILES_CHUNK;
+
+            for (const auto &requestedTile : worldstate.mapTiles)
+            {
+                if (chunk.mapTiles.size() == maxMapTilesPerRequest)
+                    break;
+
+                MapTile mapTile;
+
+                if (player.takeListedMapTile(requestedTile.x, requestedTile.y, mapTile))
+                    chunk.mapTiles.push_back(std::move(mapTile));
+            }
+
+            packet.setWorldstate(&chunk);
+            packet.Send(false);
+        }
     };
 }
 
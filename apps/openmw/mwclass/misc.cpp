@@ -240,6 +240,16 @@ namespace MWClass
         }
         newPtr.getCellRef().unsetRefNum();
 
+        /*
+            Start of tes3mp addition
+
+            Make the copy searchable by its new reference number
+        */
+        cell.updateRefNumIndex(newPtr);
+        /*
+            End of tes3mp addition
+        */
+
         return newPtr;
     }
 
@@ -661,7 +661,7 @@ namespace MWMechanics
                     actorList->reset();
                     actorList->cell = *actor.getCell()->getCell();
                     actorList->addAttackActor(actor, *localAttack);
-                    actorList->sendAttackActors();
+                    actorList->sendUpdateActors();
                 }
                 /*
                     End of tes3mp addition
@@ -41,6 +41,7 @@
 #include "../mwmp/DedicatedPlayer.hpp"
 #include "../mwmp/CellController.hpp"
 #include "../mwmp/MechanicsHelper.hpp"
+#include "../mwmp/ContainerEditQueue.hpp"
 /*
     End of tes3mp addition
 */
@@ -1169,7 +1170,19 @@ void CharacterController::handleTextKey(const std::string &groupname, SceneUtil:
     else if (groupname == "shield" && evt.compare(off, len, "block hit") == 0)
         mPtr.getClass().block(mPtr);
     else if (groupname == "containeropen" && evt.compare(off, len, "loot") == 0)
+    {
+        /*
+            Start of tes3mp addition
+
+            Finish applying the contents received for this container while its opening animation played
+        */
+        mwmp::Main::get().getContainerEditQueue()->applyFor(mPtr);
+        /*
+            End of tes3mp addition
+        */
+
         MWBase::Environment::get().getWindowManager()->pushGuiMode(MWGui::GM_Container, mPtr);
+    }
 }
 
 void CharacterController::updatePtr(const MWWorld::Ptr &ptr)
@@ -172,3 +172,35 @@ namespace MWMechanics
         *it = after;
     }
 }
+
+/*
+    Start of tes3mp addition
+
+    Moved here from mwworld/esmstore.cpp, so the stores can be linked into the benchmarks
+    without the constructor of SpellList
+*/
+namespace MWWorld
+{
+    std::pair<std::shared_ptr<MWMechanics::SpellList>, bool> ESMStore::getSpellList(const std::string& originalId) const
+    {
+        const std::string id = Misc::StringUtils::lowerCase(originalId);
+        auto result = mSpellListCache.find(id);
+        std::shared_ptr<MWMechanics::SpellList> ptr;
+        if (result != mSpellListCache.end())
+            ptr = result->second.lock();
+        if (!ptr)
+        {
+            int type = find(id);
+            ptr = std::make_shared<MWMechanics::SpellList>(id, type);
+            if (result != mSpellListCache.end())
+                result->second = ptr;
+            else
+                mSpellListCache.insert({id, ptr});
+            return {ptr, false};
+        }
+        return {ptr, true};
+    }
+}
+/*
+    End of tes3mp addition
+*/
@@ -29,6 +29,7 @@ void ActorList::reset()
 {
     cell.blank();
     baseActors.clear();
+    timestamp = 0;
     positionActors.clear();
     animFlagsActors.clear();
     animPlayActors.clear();
@@ -147,46 +148,6 @@ void ActorList::sendPositionActors()
     }
 }
 
-void ActorList::sendAnimFlagsActors()
-{
-    if (animFlagsActors.size() > 0)
-    {
-        baseActors = animFlagsActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ANIM_FLAGS)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ANIM_FLAGS)->Send();
-    }
-}
-
-void ActorList::sendAnimPlayActors()
-{
-    if (animPlayActors.size() > 0)
-    {
-        baseActors = animPlayActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ANIM_PLAY)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ANIM_PLAY)->Send();
-    }
-}
-
-void ActorList::sendSpeechActors()
-{
-    if (speechActors.size() > 0)
-    {
-        baseActors = speechActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_SPEECH)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_SPEECH)->Send();
-    }
-}
-
-void ActorList::sendStatsDynamicActors()
-{
-    if (statsDynamicActors.size() > 0)
-    {
-        baseActors = statsDynamicActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_STATS_DYNAMIC)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_STATS_DYNAMIC)->Send();
-    }
-}
-
 void ActorList::sendDeathActors()
 {
     if (deathActors.size() > 0)
@@ -217,26 +178,6 @@ void ActorList::sendAiActors()
     }
 }
 
-void ActorList::sendAttackActors()
-{
-    if (attackActors.size() > 0)
-    {
-        baseActors = attackActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ATTACK)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_ATTACK)->Send();
-    }
-}
-
-void ActorList::sendCastActors()
-{
-    if (castActors.size() > 0)
-    {
-        baseActors = castActors;
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_CAST)->setActorList(this);
-        Main::get().getNetworking()->getActorPacket(ID_ACTOR_CAST)->Send();
-    }
-}
-
 void ActorList::sendCellChangeActors()
 {
     if (cellChangeActors.size() > 0)
@@ -286,3 +227,76 @@ void ActorList::sendActorsInCell(MWWorld::CellStore* cellStore)
     mwmp::Main::get().getNetworking()->getActorPacket(ID_ACTOR_LIST)->setActorList(this);
     mwmp::Main::get().getNetworking()->getActorPacket(ID_ACTOR_LIST)->Send();
 }
+
+void ActorList::sendUpdateActors()
+{
+    baseActors.clear();
+    updateActorIndexes.clear();
+
+    for (const auto &animFlagsActor : animFlagsActors)
+    {
+        BaseActor &actor = getUpdateActor(animFlagsActor);
+        actor.movementFlags = animFlagsActor.movementFlags;
+        actor.drawState = animFlagsActor.drawState;
+        actor.isFlying = animFlagsActor.isFlying;
+        actor.updateFlags |= BaseActor::UPDATE_ANIM_FLAGS;
+    }
+
+    for (const auto &animPlayActor : animPlayActors)
+    {
+        BaseActor &actor = getUpdateActor(animPlayActor);
+        actor.animation = animPlayActor.animation;
+        actor.updateFlags |= BaseActor::UPDATE_ANIM_PLAY;
+    }
+
+    for (const auto &speechActor : speechActors)
+    {
+        BaseActor &actor = getUpdateActor(speechActor);
+        actor.sound = speechActor.sound;
+        actor.updateFlags |= BaseActor::UPDATE_SPEECH;
+    }
+
+    for (const auto &statsDynamicActor : statsDynamicActors)
+    {
+        BaseActor &actor = getUpdateActor(statsDynamicActor);
+        actor.creatureStats = statsDynamicActor.creatureStats;
+        actor.updateFlags |= BaseActor::UPDATE_STATS_DYNAMIC;
+    }
+
+    for (const auto &attackActor : attackActors)
+    {
+        BaseActor &actor = getUpdateActor(attackActor);
+        actor.attack = attackActor.attack;
+        actor.updateFlags |= BaseActor::UPDATE_ATTACK;
+    }
+
+    for (const auto &castActor : castActors)
+    {
+        BaseActor &actor = getUpdateActor(castActor);
+        actor.cast = castActor.cast;
+        actor.updateFlags |= BaseActor::UPDATE_CAST;
+    }
+
+    if (baseActors.size() > 0)
+    {
+        Main::get().getNetworking()->getActorPacket(ID_ACTOR_UPDATE)->setActorList(this);
+        Main::get().getNetworking()->getActorPacket(ID_ACTOR_UPDATE)->Send();
+    }
+}
+
+BaseActor &ActorList::getUpdateActor(const BaseActor &baseActor)
+{
+    ActorKey actorKey = getActorKey(baseActor.refNum, baseActor.mpNum);
+    auto it = updateActorIndexes.find(actorKey);
+
+    if (it != updateActorIndexes.end())
+        return baseActors[it->second];
+
+    updateActorIndexes[actorKey] = baseActors.size();
+
+    baseActors.emplace_back();
+    BaseActor &actor = baseActors.back();
+    actor.refNum = baseActor.refNum;
+    actor.mpNum = baseActor.mpNum;
+    return actor;
+}
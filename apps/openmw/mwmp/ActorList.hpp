@@ -1,10 +1,13 @@
 #ifndef OPENMW_ACTORLIST_HPP
 #define OPENMW_ACTORLIST_HPP
 
+#include <components/openmw-mp/ActorKey.hpp>
 #include <components/openmw-mp/Base/BaseActor.hpp>
 #include "../mwworld/cellstore.hpp"
 #include <RakNetTypes.h>
 
+#include <unordered_map>
+
 #include "LocalActor.hpp"
 
 namespace mwmp
@@ -35,21 +38,20 @@ namespace mwmp
         void addCellChangeActor(BaseActor baseActor);
 
         void sendPositionActors();
-        void sendAnimFlagsActors();
-        void sendAnimPlayActors();
-        void sendSpeechActors();
-        void sendStatsDynamicActors();
         void sendDeathActors();
         void sendEquipmentActors();
         void sendAiActors();
-        void sendAttackActors();
-        void sendCastActors();
         void sendCellChangeActors();
 
+        // Send the anim flags, anim play, speech, dynamic stats, attack and cast actors together
+        // as a single ID_ACTOR_UPDATE
+        void sendUpdateActors();
+
         void sendActorsInCell(MWWorld::CellStore* cellStore);
 
     private:
         Networking *getNetworking();
+        BaseActor &getUpdateActor(const BaseActor &baseActor);
 
         std::vector<BaseActor> positionActors;
         std::vector<BaseActor> animFlagsActors;
@@ -62,6 +64,8 @@ namespace mwmp
         std::vector<BaseActor> attackActors;
         std::vector<BaseActor> castActors;
         std::vector<BaseActor> cellChangeActors;
+
+        std::unordered_map<ActorKey, size_t> updateActorIndexes;
     };
 }
 
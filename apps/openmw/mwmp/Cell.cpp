@@ -13,9 +13,12 @@
 #include "LocalPlayer.hpp"
 #include "CellController.hpp"
 #include "MechanicsHelper.hpp"
+#include "PlayerList.hpp"
 
 using namespace mwmp;
 
+float Cell::actorUpdateInterval = 0.05f;
+
 mwmp::Cell::Cell(MWWorld::CellStore* cellStore)
 {
     store = cellStore;
@@ -29,14 +32,17 @@ Cell::~Cell()
 
 }
 
+void Cell::setActorUpdateInterval(float seconds)
+{
+    actorUpdateInterval = seconds;
+}
+
 void Cell::updateLocal(bool forceUpdate)
 {
     if (localActors.empty())
         return;
 
-    const float timeoutSec = 0.025;
-
-    if (!forceUpdate && (updateTimer += MWBase::Environment::get().getFrameDuration()) < timeoutSec)
+    if (!forceUpdate && (updateTimer += MWBase::Environment::get().getFrameDuration()) < actorUpdateInterval)
         return;
     else
         updateTimer = 0;
@@ -47,6 +53,8 @@ void Cell::updateLocal(bool forceUpdate)
 
     actorList->cell = *store->getCell();
 
+    PlayerList::getObserverPositions(store, observerPositions);
+
     for (auto it = localActors.begin(); it != localActors.end();)
     {
         LocalActor *actor = it->second;
@@ -56,13 +64,13 @@ void Cell::updateLocal(bool forceUpdate)
         if (newStore != store)
         {
             actor->updateCell();
-            std::string mapIndex = it->first;
+            ActorKey mapIndex = it->first;
 
             // If the cell this actor has moved to is under our authority, move them to it
             if (cellController->hasLocalAuthority(actor->cell))
             {
                 LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving LocalActor %s to our authority in %s",
-                    mapIndex.c_str(), actor->cell.getShortDescription().c_str());
+                    getActorKeyDescription(mapIndex).c_str(), actor->cell.getShortDescription().c_str());
                 Cell *newCell = cellController->getCell(actor->cell);
                 newCell->localActors[mapIndex] = actor;
                 cellController->setLocalActorRecord(mapIndex, newCell->getShortDescription());
@@ -70,7 +78,7 @@ void Cell::updateLocal(bool forceUpdate)
             else
             {
                 LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting LocalActor %s which is no longer under our authority",
-                    mapIndex.c_str(), getShortDescription().c_str());
+                    getActorKeyDescription(mapIndex).c_str(), getShortDescription().c_str());
                 cellController->removeLocalActorRecord(mapIndex);
                 delete actor;
             }
@@ -83,9 +91,9 @@ void Cell::updateLocal(bool forceUpdate)
             {
                 if (actor->getPtr().getRefData().isDeleted())
                 {
-                    std::string mapIndex = it->first;
+                    ActorKey mapIndex = it->first;
                     LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting LocalActor %s whose reference has been deleted",
-                        mapIndex.c_str(), getShortDescription().c_str());
+                        getActorKeyDescription(mapIndex).c_str(), getShortDescription().c_str());
                     cellController->removeLocalActorRecord(mapIndex);
                     delete actor;
                     localActors.erase(it++);
@@ -94,7 +102,8 @@ void Cell::updateLocal(bool forceUpdate)
                 {
                     // Forcibly update this local actor if its data has never been sent before;
                     // otherwise, use the current forceUpdate value
-                    actor->update(actor->hasSentData ? forceUpdate : true);
+                    bool isPositionDue = actor->updatePriority(observerPositions);
+                    actor->update(actor->hasSentData ? forceUpdate : true, isPositionDue);
                 }
             }
 
@@ -103,14 +112,9 @@ void Cell::updateLocal(bool forceUpdate)
     }
 
     actorList->sendPositionActors();
-    actorList->sendAnimFlagsActors();
-    actorList->sendAnimPlayActors();
-    actorList->sendSpeechActors();
+    actorList->sendUpdateActors();
     actorList->sendDeathActors();
-    actorList->sendStatsDynamicActors();
     actorList->sendEquipmentActors();
-    actorList->sendAttackActors();
-    actorList->sendCastActors();
     actorList->sendCellChangeActors();
 }
 
@@ -135,13 +139,14 @@ void Cell::readPositions(ActorList& actorList)
     
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
         {
             DedicatedActor *actor = dedicatedActors[mapIndex];
             actor->position = baseActor.position;
             actor->direction = baseActor.direction;
+            actor->bufferPosition(actorList.timestamp);
 
             if (!actor->hasPositionData)
             {
@@ -162,36 +167,40 @@ void Cell::readAnimFlags(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
-        {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
-            actor->movementFlags = baseActor.movementFlags;
-            actor->drawState = baseActor.drawState;
-            actor->isFlying = baseActor.isFlying;
-        }
+            readAnimFlags(dedicatedActors[mapIndex], baseActor);
     }
 }
 
+void Cell::readAnimFlags(DedicatedActor *actor, const BaseActor &baseActor)
+{
+    actor->movementFlags = baseActor.movementFlags;
+    actor->drawState = baseActor.drawState;
+    actor->isFlying = baseActor.isFlying;
+}
+
 void Cell::readAnimPlay(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
-        {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
-            actor->animation.groupname = baseActor.animation.groupname;
-            actor->animation.mode = baseActor.animation.mode;
-            actor->animation.count = baseActor.animation.count;
-            actor->animation.persist = baseActor.animation.persist;
-            actor->playAnimation();
-        }
+            readAnimPlay(dedicatedActors[mapIndex], baseActor);
     }
 }
 
+void Cell::readAnimPlay(DedicatedActor *actor, const BaseActor &baseActor)
+{
+    actor->animation.groupname = baseActor.animation.groupname;
+    actor->animation.mode = baseActor.animation.mode;
+    actor->animation.count = baseActor.animation.count;
+    actor->animation.persist = baseActor.animation.persist;
+    actor->playAnimation();
+}
+
 void Cell::readStatsDynamic(ActorList& actorList)
 {
     initializeDedicatedActors(actorList);
@@ -200,28 +209,108 @@ void Cell::readStatsDynamic(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
-        {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
-            actor->creatureStats = baseActor.creatureStats;
+            readStatsDynamic(dedicatedActors[mapIndex], baseActor);
+    }
+}
 
-            if (!actor->hasStatsDynamicData)
-            {
-                actor->hasStatsDynamicData = true;
+void Cell::readStatsDynamic(DedicatedActor *actor, const BaseActor &baseActor)
+{
+    actor->creatureStats = baseActor.creatureStats;
 
-                // If this is our first packet about this actor's dynamic stats, force an update
-                // now instead of waiting for its frame
-                //
-                // That way, if this actor is about to become a LocalActor, initial data about it
-                // received from the server still gets set
-                actor->setStatsDynamic();
-            }
+    if (!actor->hasStatsDynamicData)
+    {
+        actor->hasStatsDynamicData = true;
+
+        // If this is our first packet about this actor's dynamic stats, force an update
+        // now instead of waiting for its frame
+        //
+        // That way, if this actor is about to become a LocalActor, initial data about it
+        // received from the server still gets set
+        actor->setStatsDynamic();
+    }
+}
+
+void Cell::readSnapshot(ActorList& actorList)
+{
+    initializeDedicatedActors(actorList);
+
+    if (dedicatedActors.empty()) return;
+
+    for (const auto &baseActor : actorList.baseActors)
+    {
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+
+        if (dedicatedActors.count(mapIndex) == 0)
+            continue;
+
+        DedicatedActor *actor = dedicatedActors[mapIndex];
+
+        // Apply the snapshot right away, the same way the first position and dynamic stats
+        // packets about an actor are, so it is in place before any later update arrives
+        //
+        // The actor's position buffer starts over from the snapshot and its server timestamp, so
+        // the positions received next are interpolated from it instead of from older ones
+        if (baseActor.hasPositionData)
+        {
+            actor->position = baseActor.position;
+            actor->direction = baseActor.direction;
+            actor->hasPositionData = true;
+            actor->resetPosition(actorList.timestamp);
+        }
+
+        if (baseActor.hasStatsDynamicData)
+        {
+            actor->creatureStats.mDynamic[0] = baseActor.creatureStats.mDynamic[0];
+            actor->creatureStats.mDynamic[1] = baseActor.creatureStats.mDynamic[1];
+            actor->creatureStats.mDynamic[2] = baseActor.creatureStats.mDynamic[2];
+            actor->hasStatsDynamicData = true;
+            actor->setStatsDynamic();
         }
     }
 }
 
+void Cell::readUpdate(ActorList& actorList)
+{
+    initializeDedicatedActors(actorList);
+
+    if (dedicatedActors.empty()) return;
+
+    for (const auto &baseActor : actorList.baseActors)
+    {
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+
+        if (dedicatedActors.count(mapIndex) == 0)
+            continue;
+
+        DedicatedActor *actor = dedicatedActors[mapIndex];
+
+        // Apply the parts of the update in the order their separate packets used to be sent in
+        if (baseActor.updateFlags & BaseActor::UPDATE_ANIM_FLAGS)
+            readAnimFlags(actor, baseActor);
+
+        if (baseActor.updateFlags & BaseActor::UPDATE_ANIM_PLAY)
+            readAnimPlay(actor, baseActor);
+
+        if (baseActor.updateFlags & BaseActor::UPDATE_SPEECH)
+            readSpeech(actor, baseActor);
+
+        if (baseActor.updateFlags & BaseActor::UPDATE_STATS_DYNAMIC)
+            readStatsDynamic(actor, baseActor);
+
+        if (baseActor.updateFlags & BaseActor::UPDATE_ATTACK)
+            readAttack(actor, baseActor);
+
+        if (baseActor.updateFlags & BaseActor::UPDATE_CAST)
+            readCast(actor, baseActor);
+    }
+
+    if (hasLocalAuthority())
+        uninitializeDedicatedActors(actorList);
+}
+
 void Cell::readDeath(ActorList& actorList)
 {
     initializeDedicatedActors(actorList);
@@ -230,7 +319,7 @@ void Cell::readDeath(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
         {
@@ -261,7 +350,7 @@ void Cell::readEquipment(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
         {
@@ -286,20 +375,22 @@ void Cell::readSpeech(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
-        {
-            DedicatedActor *actor = dedicatedActors[mapIndex];
-            actor->sound = baseActor.sound;
-            actor->playSound();
-        }
+            readSpeech(dedicatedActors[mapIndex], baseActor);
     }
 
     if (hasLocalAuthority())
         uninitializeDedicatedActors(actorList);
 }
 
+void Cell::readSpeech(DedicatedActor *actor, const BaseActor &baseActor)
+{
+    actor->sound = baseActor.sound;
+    actor->playSound();
+}
+
 void Cell::readSpellsActive(ActorList& actorList)
 {
     initializeDedicatedActors(actorList);
@@ -308,7 +399,7 @@ void Cell::readSpellsActive(ActorList& actorList)
 
     for (const auto& baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
         {
@@ -338,7 +429,7 @@ void Cell::readAi(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
         {
@@ -362,44 +453,50 @@ void Cell::readAttack(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
-        {
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorAttack about %s", mapIndex.c_str());
+            readAttack(dedicatedActors[mapIndex], baseActor);
+    }
+}
 
-            DedicatedActor *actor = dedicatedActors[mapIndex];
-            actor->attack = baseActor.attack;
+void Cell::readAttack(DedicatedActor *actor, const BaseActor &baseActor)
+{
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorAttack about %s",
+        getActorKeyDescription(getActorKey(baseActor.refNum, baseActor.mpNum)).c_str());
 
-            MechanicsHelper::processAttack(actor->attack, actor->getPtr());
-        }
-    }
+    actor->attack = baseActor.attack;
+
+    MechanicsHelper::processAttack(actor->attack, actor->getPtr());
 }
 
 void Cell::readCast(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         if (dedicatedActors.count(mapIndex) > 0)
-        {
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorCast about %s", mapIndex.c_str());
+            readCast(dedicatedActors[mapIndex], baseActor);
+    }
+}
 
-            DedicatedActor *actor = dedicatedActors[mapIndex];
-            actor->cast = baseActor.cast;
+void Cell::readCast(DedicatedActor *actor, const BaseActor &baseActor)
+{
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Reading ActorCast about %s",
+        getActorKeyDescription(getActorKey(baseActor.refNum, baseActor.mpNum)).c_str());
 
-            // Set the correct drawState here if we've somehow we've missed a previous
-            // AnimFlags packet
-            if (actor->drawState != MWMechanics::DrawState_::DrawState_Spell)
-            {
-                actor->drawState = MWMechanics::DrawState_::DrawState_Spell;
-                actor->setAnimFlags();
-            }
+    actor->cast = baseActor.cast;
 
-            MechanicsHelper::processCast(actor->cast, actor->getPtr());
-        }
+    // Set the correct drawState here if we've somehow we've missed a previous
+    // AnimFlags packet
+    if (actor->drawState != MWMechanics::DrawState_::DrawState_Spell)
+    {
+        actor->drawState = MWMechanics::DrawState_::DrawState_Spell;
+        actor->setAnimFlags();
     }
+
+    MechanicsHelper::processCast(actor->cast, actor->getPtr());
 }
 
 void Cell::readCellChange(ActorList& actorList)
@@ -412,13 +509,13 @@ void Cell::readCellChange(ActorList& actorList)
 
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         // Is a packet mistakenly moving the actor to the cell it's already in? If so, ignore it
         if (Misc::StringUtils::ciEqual(getShortDescription(), baseActor.cell.getShortDescription()))
         {
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Server says DedicatedActor %s moved to %s, but it was already there",
-                mapIndex.c_str(), getShortDescription().c_str());
+                getActorKeyDescription(mapIndex).c_str(), getShortDescription().c_str());
             continue;
         }
 
@@ -430,7 +527,7 @@ void Cell::readCellChange(ActorList& actorList)
             dedicatedActor->direction = baseActor.direction;
 
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_VERBOSE, "Server says DedicatedActor %s moved to %s",
-                mapIndex.c_str(), dedicatedActor->cell.getShortDescription().c_str());
+                getActorKeyDescription(mapIndex).c_str(), dedicatedActor->cell.getShortDescription().c_str());
 
             MWWorld::CellStore *newStore = cellController->getCellStore(dedicatedActor->cell);
             dedicatedActor->setCell(newStore);
@@ -439,7 +536,7 @@ void Cell::readCellChange(ActorList& actorList)
             if (cellController->isActiveWorldCell(dedicatedActor->cell) && !cellController->hasLocalAuthority(dedicatedActor->cell))
             {
                 LOG_APPEND(TimedLog::LOG_VERBOSE, "- Moving DedicatedActor %s to our active cell %s",
-                    mapIndex.c_str(), dedicatedActor->cell.getShortDescription().c_str());
+                    getActorKeyDescription(mapIndex).c_str(), dedicatedActor->cell.getShortDescription().c_str());
                 cellController->initializeCell(dedicatedActor->cell);
                 Cell *newCell = cellController->getCell(dedicatedActor->cell);
                 newCell->dedicatedActors[mapIndex] = dedicatedActor;
@@ -450,7 +547,7 @@ void Cell::readCellChange(ActorList& actorList)
                 if (cellController->hasLocalAuthority(dedicatedActor->cell))
                 {
                     LOG_APPEND(TimedLog::LOG_VERBOSE, "- Creating new LocalActor based on %s in %s",
-                        mapIndex.c_str(), dedicatedActor->cell.getShortDescription().c_str());
+                        getActorKeyDescription(mapIndex).c_str(), dedicatedActor->cell.getShortDescription().c_str());
                     Cell *newCell = cellController->getCell(dedicatedActor->cell);
                     LocalActor *localActor = new LocalActor();
                     localActor->cell = dedicatedActor->cell;
@@ -467,7 +564,7 @@ void Cell::readCellChange(ActorList& actorList)
                 }
 
                 LOG_APPEND(TimedLog::LOG_VERBOSE, "- Deleting DedicatedActor %s which is no longer needed",
-                    mapIndex.c_str(), getShortDescription().c_str());
+                    getActorKeyDescription(mapIndex).c_str(), getShortDescription().c_str());
                 cellController->removeDedicatedActorRecord(mapIndex);
                 delete dedicatedActor;
             }
@@ -479,8 +576,8 @@ void Cell::readCellChange(ActorList& actorList)
 
 void Cell::initializeLocalActor(const MWWorld::Ptr& ptr)
 {
-    std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing LocalActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing LocalActor %s in %s", getActorKeyDescription(mapIndex).c_str(), getShortDescription().c_str());
 
     LocalActor *actor = new LocalActor();
     actor->cell = *store->getCell();
@@ -490,7 +587,7 @@ void Cell::initializeLocalActor(const MWWorld::Ptr& ptr)
 
     Main::get().getCellController()->setLocalActorRecord(mapIndex, getShortDescription());
 
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized LocalActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized LocalActor %s in %s", getActorKeyDescription(mapIndex).c_str(), getShortDescription().c_str());
 }
 
 void Cell::initializeLocalActors()
@@ -509,7 +606,7 @@ void Cell::initializeLocalActors()
             // If this Ptr is disabled or deleted, ignore it
             if (!ptr.getRefData().isEnabled() || ptr.getRefData().isDeleted()) continue;
 
-            std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
+            ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
 
             // Only initialize this actor if it isn't already initialized
             if (localActors.count(mapIndex) == 0)
@@ -522,8 +619,8 @@ void Cell::initializeLocalActors()
 
 void Cell::initializeDedicatedActor(const MWWorld::Ptr& ptr)
 {
-    std::string mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing DedicatedActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(ptr);
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Initializing DedicatedActor %s in %s", getActorKeyDescription(mapIndex).c_str(), getShortDescription().c_str());
 
     DedicatedActor *actor = new DedicatedActor();
     actor->cell = *store->getCell();
@@ -533,14 +630,14 @@ void Cell::initializeDedicatedActor(const MWWorld::Ptr& ptr)
 
     Main::get().getCellController()->setDedicatedActorRecord(mapIndex, getShortDescription());
 
-    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized DedicatedActor %s in %s", mapIndex.c_str(), getShortDescription().c_str());
+    LOG_APPEND(TimedLog::LOG_VERBOSE, "- Successfully initialized DedicatedActor %s in %s", getActorKeyDescription(mapIndex).c_str(), getShortDescription().c_str());
 }
 
 void Cell::initializeDedicatedActors(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
 
         // If this key doesn't exist, create it
         if (dedicatedActors.count(mapIndex) == 0)
@@ -569,7 +666,7 @@ void Cell::uninitializeDedicatedActors(ActorList& actorList)
 {
     for (const auto &baseActor : actorList.baseActors)
     {
-        std::string mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
+        ActorKey mapIndex = Main::get().getCellController()->generateMapIndex(baseActor);
         Main::get().getCellController()->removeDedicatedActorRecord(mapIndex);
         delete dedicatedActors.at(mapIndex);
         dedicatedActors.erase(mapIndex);
@@ -587,12 +684,12 @@ void Cell::uninitializeDedicatedActors()
     dedicatedActors.clear();
 }
 
-LocalActor *Cell::getLocalActor(std::string actorIndex)
+LocalActor *Cell::getLocalActor(ActorKey actorIndex)
 {
     return localActors.at(actorIndex);
 }
 
-DedicatedActor *Cell::getDedicatedActor(std::string actorIndex)
+DedicatedActor *Cell::getDedicatedActor(ActorKey actorIndex)
 {
     return dedicatedActors.at(actorIndex);
 }
@@ -1,6 +1,13 @@
 #ifndef OPENMW_MPCELL_HPP
 #define OPENMW_MPCELL_HPP
 
+#include <unordered_map>
+#include <vector>
+
+#include <osg/Vec3f>
+
+#include <components/openmw-mp/ActorKey.hpp>
+
 #include "ActorList.hpp"
 #include "LocalActor.hpp"
 #include "DedicatedActor.hpp"
@@ -22,6 +29,8 @@ namespace mwmp
         void readAnimFlags(ActorList& actorList);
         void readAnimPlay(ActorList& actorList);
         void readStatsDynamic(ActorList& actorList);
+        void readSnapshot(ActorList& actorList);
+        void readUpdate(ActorList& actorList);
         void readDeath(ActorList& actorList);
         void readEquipment(ActorList& actorList);
         void readSpeech(ActorList& actorList);
@@ -41,8 +50,8 @@ namespace mwmp
         void uninitializeDedicatedActors(ActorList& actorList);
         void uninitializeDedicatedActors();
 
-        virtual LocalActor *getLocalActor(std::string actorIndex);
-        virtual DedicatedActor *getDedicatedActor(std::string actorIndex);
+        virtual LocalActor *getLocalActor(ActorKey actorIndex);
+        virtual DedicatedActor *getDedicatedActor(ActorKey actorIndex);
 
         bool hasLocalAuthority();
         void setAuthority(const RakNet::RakNetGUID& guid);
@@ -52,14 +61,27 @@ namespace mwmp
 
         bool shouldInitializeActors;
 
+        // How often the positions and other changes of local actors are sent, in seconds
+        static void setActorUpdateInterval(float seconds);
+
     private:
+        void readAnimFlags(DedicatedActor *actor, const BaseActor &baseActor);
+        void readAnimPlay(DedicatedActor *actor, const BaseActor &baseActor);
+        void readSpeech(DedicatedActor *actor, const BaseActor &baseActor);
+        void readStatsDynamic(DedicatedActor *actor, const BaseActor &baseActor);
+        void readAttack(DedicatedActor *actor, const BaseActor &baseActor);
+        void readCast(DedicatedActor *actor, const BaseActor &baseActor);
+
         MWWorld::CellStore* store;
         RakNet::RakNetGUID authorityGuid;
 
-        std::map<std::string, LocalActor *> localActors;
-        std::map<std::string, DedicatedActor *> dedicatedActors;
+        std::unordered_map<ActorKey, LocalActor *> localActors;
+        std::unordered_map<ActorKey, DedicatedActor *> dedicatedActors;
 
         float updateTimer;
+        std::vector<osg::Vec3f> observerPositions;
+
+        static float actorUpdateInterval;
     };
 }
 
@@ -1,7 +1,6 @@
 #include <components/detournavigator/navigator.hpp>
 #include <components/esm/cellid.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
-#include <components/openmw-mp/Utils.hpp>
 
 #include "../mwbase/environment.hpp"
 
@@ -16,9 +15,9 @@
 using namespace mwmp;
 
 std::map<std::string, mwmp::Cell *> CellController::cellsInitialized;
-std::map<std::string, std::string> CellController::localActorsToCells;
-std::map<std::string, std::string> CellController::dedicatedActorsToCells;
-std::map<std::string, unsigned int> CellController::queuedDeathStates;
+std::unordered_map<ActorKey, std::string> CellController::localActorsToCells;
+std::unordered_map<ActorKey, std::string> CellController::dedicatedActorsToCells;
+std::unordered_map<ActorKey, unsigned int> CellController::queuedDeathStates;
 
 mwmp::CellController::CellController()
 {
@@ -178,6 +177,28 @@ void CellController::readStatsDynamic(ActorList& actorList)
         cellsInitialized[mapIndex]->readStatsDynamic(actorList);
 }
 
+void CellController::readSnapshot(ActorList& actorList)
+{
+    std::string mapIndex = actorList.cell.getShortDescription();
+
+    initializeCell(actorList.cell);
+
+    // If this now exists, send it the data
+    if (cellsInitialized.count(mapIndex) > 0)
+        cellsInitialized[mapIndex]->readSnapshot(actorList);
+}
+
+void CellController::readUpdate(ActorList& actorList)
+{
+    std::string mapIndex = actorList.cell.getShortDescription();
+
+    initializeCell(actorList.cell);
+
+    // If this now exists, send it the data
+    if (cellsInitialized.count(mapIndex) > 0)
+        cellsInitialized[mapIndex]->readUpdate(actorList);
+}
+
 void CellController::readDeath(ActorList& actorList)
 {
     std::string mapIndex = actorList.cell.getShortDescription();
@@ -268,38 +289,38 @@ void CellController::readCellChange(ActorList& actorList)
 
 bool CellController::hasQueuedDeathState(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    ActorKey actorIndex = generateMapIndex(ptr);
 
     return queuedDeathStates.count(actorIndex) > 0;
 }
 
 unsigned int CellController::getQueuedDeathState(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    ActorKey actorIndex = generateMapIndex(ptr);
 
     return queuedDeathStates[actorIndex];
 }
 
 void CellController::clearQueuedDeathState(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    ActorKey actorIndex = generateMapIndex(ptr);
 
     queuedDeathStates.erase(actorIndex);
 }
 
 void CellController::setQueuedDeathState(MWWorld::Ptr ptr, unsigned int deathState)
 {
-    std::string actorIndex = generateMapIndex(ptr);
+    ActorKey actorIndex = generateMapIndex(ptr);
 
     queuedDeathStates[actorIndex] = deathState;
 }
 
-void CellController::setLocalActorRecord(std::string actorIndex, std::string cellIndex)
+void CellController::setLocalActorRecord(ActorKey actorIndex, const std::string& cellIndex)
 {
     localActorsToCells[actorIndex] = cellIndex;
 }
 
-void CellController::removeLocalActorRecord(std::string actorIndex)
+void CellController::removeLocalActorRecord(ActorKey actorIndex)
 {
     localActorsToCells.erase(actorIndex);
 }
@@ -309,40 +330,40 @@ bool CellController::isLocalActor(MWWorld::Ptr ptr)
     if (ptr.mRef == nullptr)
         return false;
 
-    std::string actorIndex = generateMapIndex(ptr);
+    ActorKey actorIndex = generateMapIndex(ptr);
 
     return localActorsToCells.count(actorIndex) > 0;
 }
 
 bool CellController::isLocalActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
+    ActorKey actorIndex = generateMapIndex(refNum, mpNum);
 
     return localActorsToCells.count(actorIndex) > 0;
 }
 
 LocalActor *CellController::getLocalActor(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
-    std::string cellIndex = localActorsToCells.at(actorIndex);
+    ActorKey actorIndex = generateMapIndex(ptr);
+    const std::string &cellIndex = localActorsToCells.at(actorIndex);
 
     return cellsInitialized.at(cellIndex)->getLocalActor(actorIndex);
 }
 
 LocalActor *CellController::getLocalActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
-    std::string cellIndex = localActorsToCells.at(actorIndex);
+    ActorKey actorIndex = generateMapIndex(refNum, mpNum);
+    const std::string &cellIndex = localActorsToCells.at(actorIndex);
 
     return cellsInitialized.at(cellIndex)->getLocalActor(actorIndex);
 }
 
-void CellController::setDedicatedActorRecord(std::string actorIndex, std::string cellIndex)
+void CellController::setDedicatedActorRecord(ActorKey actorIndex, const std::string& cellIndex)
 {
     dedicatedActorsToCells[actorIndex] = cellIndex;
 }
 
-void CellController::removeDedicatedActorRecord(std::string actorIndex)
+void CellController::removeDedicatedActorRecord(ActorKey actorIndex)
 {
     dedicatedActorsToCells.erase(actorIndex);
 }
@@ -352,47 +373,45 @@ bool CellController::isDedicatedActor(MWWorld::Ptr ptr)
     if (ptr.mRef == nullptr)
         return false;
 
-    std::string actorIndex = generateMapIndex(ptr);
+    ActorKey actorIndex = generateMapIndex(ptr);
 
     return dedicatedActorsToCells.count(actorIndex) > 0;
 }
 
 bool CellController::isDedicatedActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
+    ActorKey actorIndex = generateMapIndex(refNum, mpNum);
 
     return dedicatedActorsToCells.count(actorIndex) > 0;
 }
 
 DedicatedActor *CellController::getDedicatedActor(MWWorld::Ptr ptr)
 {
-    std::string actorIndex = generateMapIndex(ptr);
-    std::string cellIndex = dedicatedActorsToCells.at(actorIndex);
+    ActorKey actorIndex = generateMapIndex(ptr);
+    const std::string &cellIndex = dedicatedActorsToCells.at(actorIndex);
 
     return cellsInitialized.at(cellIndex)->getDedicatedActor(actorIndex);
 }
 
 DedicatedActor *CellController::getDedicatedActor(int refNum, int mpNum)
 {
-    std::string actorIndex = generateMapIndex(refNum, mpNum);
-    std::string cellIndex = dedicatedActorsToCells.at(actorIndex);
+    ActorKey actorIndex = generateMapIndex(refNum, mpNum);
+    const std::string &cellIndex = dedicatedActorsToCells.at(actorIndex);
 
     return cellsInitialized.at(cellIndex)->getDedicatedActor(actorIndex);
 }
 
-std::string CellController::generateMapIndex(int refNum, int mpNum)
+ActorKey CellController::generateMapIndex(unsigned int refNum, unsigned int mpNum)
 {
-    std::string mapIndex = "";
-    mapIndex = Utils::toString(refNum) + "-" + Utils::toString(mpNum);
-    return mapIndex;
+    return getActorKey(refNum, mpNum);
 }
 
-std::string CellController::generateMapIndex(MWWorld::Ptr ptr)
+ActorKey CellController::generateMapIndex(const MWWorld::Ptr& ptr)
 {
     return generateMapIndex(ptr.getCellRef().getRefNum().mIndex, ptr.getCellRef().getMpNum());
 }
 
-std::string CellController::generateMapIndex(BaseActor baseActor)
+ActorKey CellController::generateMapIndex(const BaseActor& baseActor)
 {
     return generateMapIndex(baseActor.refNum, baseActor.mpNum);
 }
@@ -27,6 +27,8 @@ namespace mwmp
         void readAnimFlags(mwmp::ActorList& actorList);
         void readAnimPlay(mwmp::ActorList& actorList);
         void readStatsDynamic(mwmp::ActorList& actorList);
+        void readSnapshot(mwmp::ActorList& actorList);
+        void readUpdate(mwmp::ActorList& actorList);
         void readDeath(mwmp::ActorList& actorList);
         void readEquipment(mwmp::ActorList& actorList);
         void readSpeech(mwmp::ActorList& actorList);
@@ -41,25 +43,25 @@ namespace mwmp
         void clearQueuedDeathState(MWWorld::Ptr ptr);
         void setQueuedDeathState(MWWorld::Ptr ptr, unsigned int deathState);
 
-        void setLocalActorRecord(std::string actorIndex, std::string cellIndex);
-        void removeLocalActorRecord(std::string actorIndex);
+        void setLocalActorRecord(ActorKey actorIndex, const std::string& cellIndex);
+        void removeLocalActorRecord(ActorKey actorIndex);
         
         bool isLocalActor(MWWorld::Ptr ptr);
         bool isLocalActor(int refNum, int mpNum);
         virtual LocalActor *getLocalActor(MWWorld::Ptr ptr);
         virtual LocalActor *getLocalActor(int refNum, int mpNum);
 
-        void setDedicatedActorRecord(std::string actorIndex, std::string cellIndex);
-        void removeDedicatedActorRecord(std::string actorIndex);
+        void setDedicatedActorRecord(ActorKey actorIndex, const std::string& cellIndex);
+        void removeDedicatedActorRecord(ActorKey actorIndex);
         
         bool isDedicatedActor(MWWorld::Ptr ptr);
         bool isDedicatedActor(int refNum, int mpNum);
         virtual DedicatedActor *getDedicatedActor(MWWorld::Ptr ptr);
         virtual DedicatedActor *getDedicatedActor(int refNum, int mpNum);
 
-        std::string generateMapIndex(int refNumindex, int mpNum);
-        std::string generateMapIndex(MWWorld::Ptr ptr);
-        std::string generateMapIndex(mwmp::BaseActor baseActor);
+        ActorKey generateMapIndex(unsigned int refNum, unsigned int mpNum);
+        ActorKey generateMapIndex(const MWWorld::Ptr& ptr);
+        ActorKey generateMapIndex(const mwmp::BaseActor& baseActor);
 
         bool hasLocalAuthority(const ESM::Cell& cell);
         bool isInitializedCell(const std::string& cellDescription);
@@ -75,9 +77,9 @@ namespace mwmp
 
     private:
         static std::map<std::string, mwmp::Cell *> cellsInitialized;
-        static std::map<std::string, std::string> localActorsToCells;
-        static std::map<std::string, std::string> dedicatedActorsToCells;
-        static std::map<std::string, unsigned int> queuedDeathStates;
+        static std::unordered_map<ActorKey, std::string> localActorsToCells;
+        static std::unordered_map<ActorKey, std::string> dedicatedActorsToCells;
+        static std::unordered_map<ActorKey, unsigned int> queuedDeathStates;
     };
 }
 
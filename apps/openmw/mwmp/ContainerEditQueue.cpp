@@ -0,0 +1,324 @@
+#include "ContainerEditQueue.hpp"
+#include "Main.hpp"
+#include "LocalPlayer.hpp"
+#include "LocalActor.hpp"
+#include "CellController.hpp"
+
+#include <components/misc/stringops.hpp>
+#include <components/openmw-mp/TimedLog.hpp>
+
+#include "../mwbase/environment.hpp"
+#include "../mwbase/windowmanager.hpp"
+#include "../mwbase/world.hpp"
+
+#include "../mwgui/container.hpp"
+
+#include "../mwworld/class.hpp"
+#include "../mwworld/cellstore.hpp"
+#include "../mwworld/containerstore.hpp"
+#include "../mwworld/esmstore.hpp"
+#include "../mwworld/inventorystore.hpp"
+#include "../mwworld/manualref.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <limits>
+#include <utility>
+
+using namespace mwmp;
+
+namespace
+{
+    // How long container edits can take every frame, in milliseconds
+    const double frameBudget = 2.0;
+
+    double getTime()
+    {
+        using namespace std::chrono;
+        return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+ContainerEditQueue::ContainerEditQueue()
+{
+
+}
+
+void ContainerEditQueue::queue(const ESM::Cell &cell, BaseObject &container, unsigned char action,
+    unsigned char containerSubAction, bool isLocalEvent)
+{
+    edits.emplace_back();
+
+    ContainerEdit &edit = edits.back();
+    edit.cell = cell;
+    edit.refId = container.refId;
+    edit.refNum = container.refNum;
+    edit.mpNum = container.mpNum;
+    edit.action = action;
+    edit.containerSubAction = containerSubAction;
+    edit.isLocalEvent = isLocalEvent;
+    edit.containerItems = std::move(container.containerItems);
+    edit.nextItem = 0;
+}
+
+void ContainerEditQueue::apply()
+{
+    const double budgetEnd = getTime() + frameBudget;
+
+    while (!edits.empty())
+    {
+        if (!apply(edits.front(), budgetEnd))
+            return;
+
+        edits.pop_front();
+    }
+}
+
+void ContainerEditQueue::applyAll()
+{
+    while (!edits.empty())
+    {
+        apply(edits.front(), std::numeric_limits<double>::max());
+        edits.pop_front();
+    }
+}
+
+void ContainerEditQueue::applyFor(const MWWorld::Ptr &container)
+{
+    auto last = std::find_if(edits.rbegin(), edits.rend(), [&](const ContainerEdit &edit) {
+        return edit.isFor(container);
+    });
+
+    for (size_t remaining = std::distance(last, edits.rend()); remaining > 0; remaining--)
+    {
+        apply(edits.front(), std::numeric_limits<double>::max());
+        edits.pop_front();
+    }
+}
+
+void ContainerEditQueue::clear()
+{
+    edits.clear();
+}
+
+void ContainerEditQueue::clear(const ESM::Cell &cell)
+{
+    CellController *cellController = Main::get().getCellController();
+
+    edits.erase(std::remove_if(edits.begin(), edits.end(), [&](const ContainerEdit &edit) {
+        return cellController->isSameCell(edit.cell, cell);
+    }), edits.end());
+}
+
+bool ContainerEditQueue::isEmpty() const
+{
+    return edits.empty();
+}
+
+bool ContainerEditQueue::ContainerEdit::isFor(const MWWorld::Ptr &container) const
+{
+    return refNum == container.getCellRef().getRefNum().mIndex && mpNum == container.getCellRef().getMpNum() &&
+        Misc::StringUtils::ciEqual(refId, container.getCellRef().getRefId());
+}
+
+bool ContainerEditQueue::apply(ContainerEdit &edit, double budgetEnd)
+{
+    // The container is found again every time, because it can be removed or unloaded between frames
+    MWWorld::CellStore *cellStore = Main::get().getCellController()->getCellStore(edit.cell);
+
+    if (!cellStore)
+        return true;
+
+    MWWorld::Ptr ptrFound = cellStore->searchExact(edit.refNum, edit.mpNum, edit.refId);
+
+    if (!ptrFound)
+        return true;
+
+    if (edit.nextItem == 0)
+    {
+        LOG_APPEND(TimedLog::LOG_VERBOSE, "-- Found %s %i-%i", ptrFound.getCellRef().getRefId().c_str(),
+            ptrFound.getCellRef().getRefNum(), ptrFound.getCellRef().getMpNum());
+    }
+
+    bool isCurrentContainer = false;
+
+    // If we are in a container, and it happens to be this container, keep track of that
+    if (MWBase::Environment::get().getWindowManager()->containsMode(MWGui::GM_Container))
+    {
+        CurrentContainer *currentContainer = &mwmp::Main::get().getLocalPlayer()->currentContainer;
+
+        if (currentContainer->refNum == ptrFound.getCellRef().getRefNum().mIndex &&
+            currentContainer->mpNum == ptrFound.getCellRef().getMpNum())
+        {
+            isCurrentContainer = true;
+
+            // Don't leave an open container partly filled for the player to take items from
+            budgetEnd = std::numeric_limits<double>::max();
+        }
+    }
+
+    MWWorld::ContainerStore& containerStore = ptrFound.getClass().getContainerStore(ptrFound);
+
+    // If we are setting the entire contents, clear the current ones
+    if (edit.action == BaseObjectList::SET && edit.nextItem == 0)
+    {
+        containerStore.setResolved(true);
+        containerStore.clear();
+    }
+
+    MWWorld::Ptr ownerPtr = ptrFound.getClass().isActor() ? ptrFound : MWBase::Environment::get().getWorld()->getPlayerPtr();
+    std::string takeAllSound = "";
+
+    if (edit.action == BaseObjectList::SET || edit.action == BaseObjectList::ADD)
+    {
+        const MWWorld::ESMStore &esmStore = MWBase::Environment::get().getWorld()->getStore();
+
+        while (edit.nextItem < edit.containerItems.size())
+        {
+            // Always add at least one item, so every edit keeps moving forward
+            if (edit.nextItem > 0 && getTime() >= budgetEnd)
+                return false;
+
+            const ContainerItem &containerItem = edit.containerItems[edit.nextItem++];
+
+            if (containerItem.refId.find("$dynamic") != std::string::npos)
+                continue;
+
+            // Skip items whose records don't exist here, instead of letting ManualRef throw for them
+            if (esmStore.find(Misc::StringUtils::lowerCase(containerItem.refId)) == 0)
+            {
+                LOG_APPEND(TimedLog::LOG_WARN, "-- Ignored containerItem %s with an unknown refId", containerItem.refId.c_str());
+                continue;
+            }
+
+            // Create a ManualRef to be able to set item charge
+            MWWorld::ManualRef ref(esmStore, containerItem.refId, 1);
+            MWWorld::Ptr newPtr = ref.getPtr();
+
+            if (containerItem.count > 1)
+                newPtr.getRefData().setCount(containerItem.count);
+
+            if (containerItem.charge > -1)
+                newPtr.getCellRef().setCharge(containerItem.charge);
+
+            if (containerItem.enchantmentCharge > -1)
+                newPtr.getCellRef().setEnchantmentCharge(containerItem.enchantmentCharge);
+
+            if (!containerItem.soul.empty())
+                newPtr.getCellRef().setSoul(containerItem.soul);
+
+            containerStore.add(newPtr, containerItem.count, ownerPtr);
+        }
+    }
+    else if (edit.action == BaseObjectList::REMOVE)
+        removeItems(edit, ptrFound, ownerPtr, isCurrentContainer, takeAllSound);
+
+    finish(edit, ptrFound, isCurrentContainer, takeAllSound);
+    return true;
+}
+
+void ContainerEditQueue::removeItems(ContainerEdit &edit, const MWWorld::Ptr &ptrFound, const MWWorld::Ptr &ownerPtr,
+    bool isCurrentContainer, std::string &takeAllSound)
+{
+    MWWorld::ContainerStore& containerStore = ptrFound.getClass().getContainerStore(ptrFound);
+
+    bool hasActorEquipment = ptrFound.getClass().isActor() && ptrFound.getClass().hasInventoryStore(ptrFound);
+    bool isLocalDrag = edit.isLocalEvent && edit.containerSubAction == BaseObjectList::DRAG;
+    bool isLocalTakeAll = edit.isLocalEvent && edit.containerSubAction == BaseObjectList::TAKE_ALL;
+
+    for (const auto &containerItem : edit.containerItems)
+    {
+        if (containerItem.refId.find("$dynamic") != std::string::npos || containerItem.actionCount <= 0)
+            continue;
+
+        // We have to find the right item ourselves because ContainerStore has no method
+        // accounting for charge
+        for (const auto itemPtr : containerStore)
+        {
+            if (Misc::StringUtils::ciEqual(itemPtr.getCellRef().getRefId(), containerItem.refId))
+            {
+                if (itemPtr.getCellRef().getCharge() == containerItem.charge &&
+                    itemPtr.getCellRef().getEnchantmentCharge() == containerItem.enchantmentCharge &&
+                    Misc::StringUtils::ciEqual(itemPtr.getCellRef().getSoul(), containerItem.soul))
+                {
+                    // Store the sound of the first item in a TAKE_ALL
+                    if (isLocalTakeAll && takeAllSound.empty())
+                        takeAllSound = itemPtr.getClass().getUpSoundId(itemPtr);
+
+                    // Is this an actor's container? If so, unequip this item if it was equipped
+                    if (hasActorEquipment)
+                    {
+                        MWWorld::InventoryStore& invStore = ptrFound.getClass().getInventoryStore(ptrFound);
+
+                        if (invStore.isEquipped(itemPtr))
+                            invStore.unequipItemQuantity(itemPtr, ptrFound, containerItem.count);
+                    }
+
+                    bool isDragResolved = false;
+
+                    if (isLocalDrag && isCurrentContainer)
+                    {
+                        MWGui::ContainerWindow* containerWindow = MWBase::Environment::get().getWindowManager()->getContainerWindow();
+
+                        if (!containerWindow->isOnDragAndDrop())
+                        {
+                            isDragResolved = containerWindow->dragItemByPtr(itemPtr, containerItem.actionCount);
+                        }
+                    }
+
+                    if (!isLocalDrag || !isDragResolved)
+                    {
+                        containerStore.remove(itemPtr, containerItem.actionCount, ownerPtr);
+
+                        if (isLocalDrag || isLocalTakeAll)
+                        {
+                            MWWorld::Ptr ptrPlayer = MWBase::Environment::get().getWorld()->getPlayerPtr();
+                            MWWorld::ContainerStore &playerStore = ptrPlayer.getClass().getContainerStore(ptrPlayer);
+                            *playerStore.add(itemPtr, containerItem.actionCount, ownerPtr, false);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void ContainerEditQueue::finish(ContainerEdit &edit, const MWWorld::Ptr &ptrFound, bool isCurrentContainer,
+    const std::string &takeAllSound)
+{
+    bool hasActorEquipment = ptrFound.getClass().isActor() && ptrFound.getClass().hasInventoryStore(ptrFound);
+    bool isLocalTakeAll = edit.isLocalEvent && edit.containerSubAction == BaseObjectList::TAKE_ALL;
+
+    // Was this a SET or ADD action on an actor's container, and are we the authority
+    // over the actor? If so, autoequip the actor
+    if ((edit.action == BaseObjectList::ADD || edit.action == BaseObjectList::SET) && hasActorEquipment &&
+        mwmp::Main::get().getCellController()->isLocalActor(ptrFound))
+    {
+        MWWorld::InventoryStore& invStore = ptrFound.getClass().getInventoryStore(ptrFound);
+        invStore.autoEquip(ptrFound);
+        mwmp::Main::get().getCellController()->getLocalActor(ptrFound)->updateEquipment(true, true);
+    }
+
+    // If this container can be harvested, disable and then enable it again to refresh its animation
+    if (ptrFound.getClass().canBeHarvested(ptrFound))
+    {
+        MWBase::Environment::get().getWorld()->disable(ptrFound);
+        MWBase::Environment::get().getWorld()->enable(ptrFound);
+    }
+
+    // If this container was open for us, update its view
+    if (isCurrentContainer)
+    {
+        if (isLocalTakeAll)
+        {
+            MWBase::Environment::get().getWindowManager()->removeGuiMode(MWGui::GM_Container);
+            MWBase::Environment::get().getWindowManager()->playSound(takeAllSound);
+        }
+        else
+        {
+            MWGui::ContainerWindow* containerWindow = MWBase::Environment::get().getWindowManager()->getContainerWindow();
+            containerWindow->setPtr(ptrFound);
+        }
+    }
+}
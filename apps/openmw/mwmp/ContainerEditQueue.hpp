@@ -0,0 +1,73 @@
+#ifndef OPENMW_CONTAINEREDITQUEUE_HPP
+#define OPENMW_CONTAINEREDITQUEUE_HPP
+
+#include <deque>
+#include <vector>
+
+#include <components/esm/loadcell.hpp>
+#include <components/openmw-mp/Base/BaseObject.hpp>
+
+#include "../mwworld/ptr.hpp"
+
+namespace mwmp
+{
+    /*
+        Received container contents that are waiting to be applied
+
+        Creating the items of a large container can take long enough to stall a frame, so the items
+        are added a few at a time within a time budget every frame. Edits are always applied in the
+        order they were received, and anything that depends on containers being up-to-date applies
+        all of them first, as does opening or activating a container that has edits waiting
+    */
+    class ContainerEditQueue
+    {
+    public:
+        ContainerEditQueue();
+
+        void queue(const ESM::Cell &cell, BaseObject &container, unsigned char action,
+            unsigned char containerSubAction, bool isLocalEvent);
+
+        // Apply edits until the time budget for this frame has been used up
+        void apply();
+        // Apply every queued edit, regardless of how long it takes
+        void applyAll();
+        // Apply every queued edit up to and including the last one for this container, so it isn't
+        // opened or looted while it is only partly filled
+        void applyFor(const MWWorld::Ptr &container);
+        void clear();
+        // Drop the edits for containers in a cell that is being reset, so they aren't applied to
+        // the containers it gets from the server next
+        void clear(const ESM::Cell &cell);
+
+        bool isEmpty() const;
+
+    private:
+        struct ContainerEdit
+        {
+            bool isFor(const MWWorld::Ptr &container) const;
+
+            ESM::Cell cell;
+            std::string refId;
+            unsigned int refNum;
+            unsigned int mpNum;
+
+            unsigned char action;
+            unsigned char containerSubAction;
+            bool isLocalEvent;
+
+            std::vector<ContainerItem> containerItems;
+            size_t nextItem;
+        };
+
+        // Returns whether the edit is done, or false if the time budget ran out before it was
+        bool apply(ContainerEdit &edit, double budgetEnd);
+        void removeItems(ContainerEdit &edit, const MWWorld::Ptr &ptrFound, const MWWorld::Ptr &ownerPtr,
+            bool isCurrentContainer, std::string &takeAllSound);
+        void finish(ContainerEdit &edit, const MWWorld::Ptr &ptrFound, bool isCurrentContainer,
+            const std::string &takeAllSound);
+
+        std::deque<ContainerEdit> edits;
+    };
+}
+
+#endif //OPENMW_CONTAINEREDITQUEUE_HPP
@@ -72,6 +72,8 @@ void DedicatedActor::setCell(MWWorld::CellStore *cellStore)
     ptr = world->moveObject(ptr, cellStore, position.pos[0], position.pos[1], position.pos[2]);
     setMovementSettings();
 
+    // Positions from the previous cell can't be interpolated with ones from the new one
+    positionBuffer.clear();
     hasChangedCell = true;
 }
 
@@ -81,29 +83,42 @@ void DedicatedActor::move(float dt)
     MWBase::World *world = MWBase::Environment::get().getWorld();
     const int maxInterpolationDistance = 40;
 
+    // Show the position the server had for this actor a short while ago, interpolated from the
+    // buffered positions, or approach the newest position if none have been buffered
+    ESM::Position shownPosition;
+    bool isBuffered = positionBuffer.sample(dt, shownPosition);
+
+    if (!isBuffered)
+        shownPosition = position;
+
     // Apply interpolation only if the position hasn't changed too much from last time
-    bool shouldInterpolate = abs(position.pos[0] - refPos.pos[0]) < maxInterpolationDistance && abs(position.pos[1] - refPos.pos[1]) < maxInterpolationDistance && abs(position.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
+    bool shouldInterpolate = abs(shownPosition.pos[0] - refPos.pos[0]) < maxInterpolationDistance && abs(shownPosition.pos[1] - refPos.pos[1]) < maxInterpolationDistance && abs(shownPosition.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
 
     // Don't apply linear interpolation if the DedicatedActor has just gone through a cell change, because
     // the interpolated position will be invalid, causing a slight hopping glitch
     if (shouldInterpolate && !hasChangedCell)
     {
-        static const int timeMultiplier = 15;
-        osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
-        refPos.pos[0] = lerp.x();
-        refPos.pos[1] = lerp.y();
-        refPos.pos[2] = lerp.z();
+        if (!isBuffered)
+        {
+            static const int timeMultiplier = 15;
+            osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
+            shownPosition.pos[0] = lerp.x();
+            shownPosition.pos[1] = lerp.y();
+            shownPosition.pos[2] = lerp.z();
+        }
 
-        world->moveObject(ptr, refPos.pos[0], refPos.pos[1], refPos.pos[2]);
+        world->moveObject(ptr, shownPosition.pos[0], shownPosition.pos[1], shownPosition.pos[2]);
     }
     else
     {
         setPosition();
+        positionBuffer.clear();
+        shownPosition = position;
         hasChangedCell = false;
     }
 
     setMovementSettings();
-    world->rotateObject(ptr, position.rot[0], position.rot[1], position.rot[2]);
+    world->rotateObject(ptr, shownPosition.rot[0], shownPosition.rot[1], shownPosition.rot[2]);
 }
 
 void DedicatedActor::setMovementSettings()
@@ -128,6 +143,20 @@ void DedicatedActor::setPosition()
     world->moveObject(ptr, position.pos[0], position.pos[1], position.pos[2]);
 }
 
+void DedicatedActor::bufferPosition(uint32_t timestamp)
+{
+    positionBuffer.add(timestamp, position);
+}
+
+void DedicatedActor::resetPosition(uint32_t timestamp)
+{
+    // Drop the positions buffered so far, which are older than the one being reset to, and move
+    // straight to it instead of interpolating toward it
+    positionBuffer.clear();
+    positionBuffer.add(timestamp, position);
+    setPosition();
+}
+
 void DedicatedActor::setAnimFlags()
 {
     using namespace MWMechanics;
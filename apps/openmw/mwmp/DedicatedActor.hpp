@@ -5,6 +5,8 @@
 #include "../mwmechanics/aisequence.hpp"
 #include "../mwworld/manualref.hpp"
 
+#include "SnapshotBuffer.hpp"
+
 namespace mwmp
 {
     class DedicatedActor : public BaseActor
@@ -19,6 +21,8 @@ namespace mwmp
         void setCell(MWWorld::CellStore *cellStore);
         void setMovementSettings();
         void setPosition();
+        void bufferPosition(uint32_t timestamp);
+        void resetPosition(uint32_t timestamp);
         void setAnimFlags();
         void setStatsDynamic();
         void setEquipment();
@@ -39,6 +43,7 @@ namespace mwmp
 
     private:
         MWWorld::Ptr ptr;
+        SnapshotBuffer positionBuffer;
 
         bool hasReceivedInitialEquipment;
         bool hasChangedCell;
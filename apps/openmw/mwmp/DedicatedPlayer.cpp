@@ -122,23 +122,40 @@ void DedicatedPlayer::move(float dt)
     MWBase::World *world = MWBase::Environment::get().getWorld();
     const int maxInterpolationDistance = 80;
 
+    // Show the position the server had for this player a short while ago, interpolated from the
+    // buffered positions, or approach the newest position if none have been buffered
+    ESM::Position shownPosition;
+    bool isBuffered = positionBuffer.sample(dt, shownPosition);
+
+    if (!isBuffered)
+        shownPosition = position;
+
     // Apply interpolation only if the position hasn't changed too much from last time
     bool shouldInterpolate =
-            abs(position.pos[0] - refPos.pos[0]) < maxInterpolationDistance &&
-            abs(position.pos[1] - refPos.pos[1]) < maxInterpolationDistance &&
-            abs(position.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
+            abs(shownPosition.pos[0] - refPos.pos[0]) < maxInterpolationDistance &&
+            abs(shownPosition.pos[1] - refPos.pos[1]) < maxInterpolationDistance &&
+            abs(shownPosition.pos[2] - refPos.pos[2]) < maxInterpolationDistance;
 
     if (shouldInterpolate)
     {
-        static const int timeMultiplier = 15;
-        osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
+        if (isBuffered)
+            world->moveObject(ptr, shownPosition.pos[0], shownPosition.pos[1], shownPosition.pos[2]);
+        else
+        {
+            static const int timeMultiplier = 15;
+            osg::Vec3f lerp = MechanicsHelper::getLinearInterpolation(refPos.asVec3(), position.asVec3(), dt * timeMultiplier);
 
-        world->moveObject(ptr, lerp.x(), lerp.y(), lerp.z());
+            world->moveObject(ptr, lerp.x(), lerp.y(), lerp.z());
+        }
     }
     else
+    {
         world->moveObject(ptr, position.pos[0], position.pos[1], position.pos[2]);
+        positionBuffer.clear();
+        shownPosition = position;
+    }
 
-    world->rotateObject(ptr, position.rot[0], 0, position.rot[2]);
+    world->rotateObject(ptr, shownPosition.rot[0], 0, shownPosition.rot[2]);
 
     MWMechanics::Movement *move = &ptr.getClass().getMovementSettings(ptr);
     move->mPosition[0] = direction.pos[0];
@@ -154,6 +171,11 @@ void DedicatedPlayer::move(float dt)
     }
 }
 
+void DedicatedPlayer::bufferPosition()
+{
+    positionBuffer.add(positionTimestamp, position);
+}
+
 void DedicatedPlayer::setBaseInfo()
 {
     // Use the previous race if the new one doesn't exist
@@ -417,6 +439,9 @@ void DedicatedPlayer::setCell()
     // update has been called
     setPtr(world->moveObject(ptr, cellStore, position.pos[0], position.pos[1], position.pos[2]));
 
+    // Positions from the previous cell can't be interpolated with ones from the new one
+    positionBuffer.clear();
+
     // Remove the marker entirely if this player has moved to an interior that is inactive for us
     if (!cell.isExterior() && !Main::get().getCellController()->isActiveWorldCell(cell))
         removeMarker();
@@ -12,6 +12,8 @@
 
 #include "../mwworld/manualref.hpp"
 
+#include "SnapshotBuffer.hpp"
+
 #include <map>
 #include <RakNetTypes.h>
 
@@ -31,6 +33,7 @@ namespace mwmp
         void update(float dt);
 
         void move(float dt);
+        void bufferPosition();
         void setBaseInfo();
         void setStatsDynamic();
         void setAnimFlags();
@@ -72,6 +75,7 @@ namespace mwmp
         MWWorld::ManualRef* reference;
 
         MWWorld::Ptr ptr;
+        SnapshotBuffer positionBuffer;
 
         ESM::CustomMarker marker;
         bool markerEnabled;
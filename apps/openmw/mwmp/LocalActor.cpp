@@ -2,6 +2,7 @@
 
 #include "../mwbase/environment.hpp"
 
+#include "../mwmechanics/aisequence.hpp"
 #include "../mwmechanics/mechanicsmanagerimp.hpp"
 #include "../mwmechanics/movement.hpp"
 
@@ -17,14 +18,24 @@
 #include "ActorList.hpp"
 #include "MechanicsHelper.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 using namespace mwmp;
 
+float LocalActor::fullPriorityDistance = 2048;
+float LocalActor::minPriority = 0.25f;
+float LocalActor::maxPositionError = 128;
+
 LocalActor::LocalActor()
 {
     hasSentData = false;
     posWasChanged = false;
     equipmentChanged = false;
 
+    priority = 0;
+
     wasRunning = false;
     wasSneaking = false;
     wasForceJumping = false;
@@ -54,14 +65,21 @@ LocalActor::~LocalActor()
 
 }
 
-void LocalActor::update(bool forceUpdate)
+void LocalActor::update(bool forceUpdate, bool isPositionDue)
 {
     updateStatsDynamic(forceUpdate);
     updateEquipment(forceUpdate, false);
 
     if (forceUpdate || !creatureStats.mDeathAnimationFinished)
     {
-        updatePosition(forceUpdate);
+        // Positions change continuously, so they are the only thing sent less often for actors
+        // with a low priority, while everything else is only sent when it changes
+        if (forceUpdate || isPositionDue)
+        {
+            updatePosition(forceUpdate);
+            priority = 0;
+        }
+
         updateAnimFlags(forceUpdate);
         updateAnimPlay();
         updateSpeech();
@@ -71,6 +89,48 @@ void LocalActor::update(bool forceUpdate)
     hasSentData = true;
 }
 
+void LocalActor::setFullPriorityDistance(float distance)
+{
+    fullPriorityDistance = std::max(0.0f, distance);
+}
+
+void LocalActor::setMaxUpdateInterval(float seconds, float updateInterval)
+{
+    // The priority an actor gains on every update, so that even the farthest actors reach a full
+    // priority within a whole number of updates that fit in the interval
+    const float updates = updateInterval > 0 ? std::floor(seconds / updateInterval) : 1;
+
+    minPriority = 1.0f / std::max(1.0f, updates);
+}
+
+void LocalActor::setMaxPositionError(float distance)
+{
+    maxPositionError = std::max(1.0f, distance);
+}
+
+bool LocalActor::updatePriority(const std::vector<osg::Vec3f>& observerPositions)
+{
+    const osg::Vec3f ptrPosition = ptr.getRefData().getPosition().asVec3();
+    float nearestDistance = std::numeric_limits<float>::max();
+
+    for (const osg::Vec3f& observerPosition : observerPositions)
+        nearestDistance = std::min(nearestDistance, (observerPosition - ptrPosition).length());
+
+    float addedPriority = std::max(minPriority, std::min(1.0f, fullPriorityDistance / nearestDistance));
+
+    // Actors in combat are usually fighting a player or near one, and their movement is what
+    // players pay the most attention to
+    if (ptr.getClass().getCreatureStats(ptr).getAiSequence().isInCombat())
+        addedPriority = 1;
+
+    priority += addedPriority;
+
+    // Fast moving actors drift away from their last sent position sooner
+    const float positionError = (ptrPosition - position.asVec3()).length() / maxPositionError;
+
+    return priority + positionError >= 1;
+}
+
 void LocalActor::updateCell()
 {
     LOG_MESSAGE_SIMPLE(TimedLog::LOG_VERBOSE, "Sending ID_ACTOR_CELL_CHANGE about %s %i-%i in cell %s to server",
@@ -1,6 +1,10 @@
 #ifndef OPENMW_LOCALACTOR_HPP
 #define OPENMW_LOCALACTOR_HPP
 
+#include <vector>
+
+#include <osg/Vec3f>
+
 #include <components/openmw-mp/Base/BaseActor.hpp>
 #include "../mwmechanics/creaturestats.hpp"
 #include "../mwmechanics/activespells.hpp"
@@ -16,7 +20,10 @@ namespace mwmp
         LocalActor();
         virtual ~LocalActor();
 
-        void update(bool forceUpdate);
+        void update(bool forceUpdate, bool isPositionDue = true);
+        // Raise this actor's update priority based on how visible and how active it is, returning
+        // whether its position is due to be sent
+        bool updatePriority(const std::vector<osg::Vec3f>& observerPositions);
 
         void updateCell();
         void updatePosition(bool forceUpdate);
@@ -37,12 +44,22 @@ namespace mwmp
 
         bool hasSentData;
 
+        // Actors at most this far from a player have their position sent on every update
+        static void setFullPriorityDistance(float distance);
+        // Actors far from every player still have their position sent at least this often, in seconds,
+        // given how often actors are updated
+        static void setMaxUpdateInterval(float seconds, float updateInterval);
+        // Actors that have moved this far since their position was last sent have it sent right away
+        static void setMaxPositionError(float distance);
+
     private:
         MWWorld::Ptr ptr;
 
         bool posWasChanged;
         bool equipmentChanged;
 
+        float priority;
+
         bool wasRunning;
         bool wasSneaking;
         bool wasForceJumping;
@@ -56,6 +73,10 @@ namespace mwmp
         MWMechanics::DynamicStat<float> oldHealth;
         MWMechanics::DynamicStat<float> oldMagicka;
         MWMechanics::DynamicStat<float> oldFatigue;
+
+        static float fullPriorityDistance;
+        static float minPriority;
+        static float maxPositionError;
     };
 }
 
@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <cstdlib>
 
+#include <components/openmw-mp/ContentCache.hpp>
 #include <components/openmw-mp/Utils.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
 #include <components/openmw-mp/Version.hpp>
@@ -44,8 +46,12 @@
 #include "PlayerList.hpp"
 #include "GUIController.hpp"
 #include "CellController.hpp"
+#include "ContainerEditQueue.hpp"
 #include "MechanicsHelper.hpp"
 #include "RecordHelper.hpp"
+#include "Cell.hpp"
+#include "LocalActor.hpp"
+#include "SnapshotBuffer.hpp"
 
 using namespace mwmp;
 
@@ -90,6 +96,7 @@ Main::Main()
     mLocalPlayer = new LocalPlayer();
     mGUIController = new GUIController();
     mCellController = new CellController();
+    mContainerEditQueue = new ContainerEditQueue();
 
     server = "mp.tes3mp.com";
     port = 25565;
@@ -102,6 +109,7 @@ Main::~Main()
     delete mLocalSystem;
     delete mLocalPlayer;
     delete mCellController;
+    delete mContainerEditQueue;
     delete mGUIController;
     PlayerList::cleanUp();
 }
@@ -131,8 +139,26 @@ bool Main::init(std::vector<std::string> &content, Files::Collections &collectio
     Settings::Manager manager;
     loadSettings(manager);
 
+    Files::ConfigurationManager cfgMgr;
+    ContentCache::setBaseDirectory((cfgMgr.getCachePath() / "tes3mp").string());
+
     int logLevel = manager.getInt("logLevel", "General");
     TimedLog::SetLevel(logLevel);
+
+    const float maxExtrapolation = manager.getFloat("maxExtrapolation", "Movement");
+    const float actorUpdateInterval = manager.getFloat("actorUpdateInterval", "Movement");
+
+    SnapshotBuffer::setInterpolationDelay(manager.getFloat("interpolationDelay", "Movement"));
+    SnapshotBuffer::setMaxExtrapolation(maxExtrapolation);
+    Cell::setActorUpdateInterval(actorUpdateInterval);
+
+    // Other clients stop extrapolating actors whose positions are late, so far actors have to be sent
+    // more often than that, with an update to spare
+    LocalActor::setFullPriorityDistance(manager.getFloat("actorFullPriorityDistance", "Movement"));
+    LocalActor::setMaxUpdateInterval(std::min(manager.getFloat("actorMaxUpdateInterval", "Movement"),
+        maxExtrapolation - actorUpdateInterval), actorUpdateInterval);
+    LocalActor::setMaxPositionError(manager.getFloat("actorMaxPositionError", "Movement"));
+
     if (address.empty())
     {
         pMain->server = manager.getString("destinationAddress", "General");
@@ -181,6 +207,7 @@ void Main::destroy()
 void Main::frame(float dt)
 {
     get().getNetworking()->update();
+    get().getContainerEditQueue()->apply();
 
     PlayerList::update(dt);
     get().getCellController()->updateDedicated(dt);
@@ -199,12 +226,18 @@ void Main::updateWorld(float dt) const
     if (init)
     {
         init = false;
+        // Ordered ahead of ID_LOADED, so the server knows which records are cached before sending any
+        mNetworking->getWorldstate()->sendRecordCache();
+
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sending ID_PLAYER_BASEINFO to server");
 
         mNetworking->getPlayerPacket(ID_PLAYER_BASEINFO)->setPlayer(getLocalPlayer());
         mNetworking->getPlayerPacket(ID_LOADED)->setPlayer(getLocalPlayer());
         mNetworking->getPlayerPacket(ID_PLAYER_BASEINFO)->Send();
         mNetworking->getPlayerPacket(ID_LOADED)->Send();
+
+        // Every packet from the server is read from now on, so it can send record ids through the tables
+        mNetworking->sendRecordIdReset();
         mLocalPlayer->updateStatsDynamic(true);
         get().getGUIController()->setChatVisible(true);
     }
@@ -245,6 +278,11 @@ CellController *Main::getCellController() const
     return mCellController;
 }
 
+ContainerEditQueue *Main::getContainerEditQueue() const
+{
+    return mContainerEditQueue;
+}
+
 bool Main::isValidPacketScript(std::string scriptId)
 {
     mwmp::BaseWorldstate *worldstate = get().getNetworking()->getWorldstate();
@@ -9,6 +9,7 @@ namespace mwmp
 {
     class GUIController;
     class CellController;
+    class ContainerEditQueue;
     class LocalSystem;
     class LocalPlayer;
     class Networking;
@@ -38,6 +39,7 @@ namespace mwmp
         LocalPlayer *getLocalPlayer() const;
         GUIController *getGUIController() const;
         CellController *getCellController() const;
+        ContainerEditQueue *getContainerEditQueue() const;
 
         void updateWorld(float dt) const;
 
@@ -56,6 +58,7 @@ namespace mwmp
 
         GUIController *mGUIController;
         CellController *mCellController;
+        ContainerEditQueue *mContainerEditQueue;
 
         std::string server;
         unsigned short port;
@@ -6,6 +6,7 @@
 #include <components/openmw-mp/Utils.hpp>
 #include <components/openmw-mp/Version.hpp>
 #include <components/openmw-mp/Packets/PacketPreInit.hpp>
+#include <components/openmw-mp/Packets/Worldstate/PacketRecordDynamic.hpp>
 
 #include <components/esm/cellid.hpp>
 #include <components/files/configurationmanager.hpp>
@@ -39,6 +40,7 @@
 #include "processors/WorldstateProcessor.hpp"
 #include "GUIController.hpp"
 #include "CellController.hpp"
+#include "ContainerEditQueue.hpp"
 
 using namespace mwmp;
 
@@ -209,6 +211,23 @@ Networking::Networking(): peer(RakNet::RakPeerInterface::GetInstance()), systemP
     objectPacketController.SetStream(0, &bsOut);
     worldstatePacketController.SetStream(0, &bsOut);
 
+    dispatchTable.addController(PacketDispatchTable::Category::System, systemPacketController);
+    dispatchTable.addController(PacketDispatchTable::Category::Player, playerPacketController);
+    dispatchTable.addController(PacketDispatchTable::Category::Actor, actorPacketController);
+    dispatchTable.addController(PacketDispatchTable::Category::Object, objectPacketController);
+    dispatchTable.addController(PacketDispatchTable::Category::Worldstate, worldstatePacketController);
+
+    // We only ever have one connection, so position packets can always be delta encoded against it
+    // and record ids can always be interned against it
+    playerPacketController.GetPacket(ID_PLAYER_POSITION)->setDeltaState(&positionDeltaState);
+    actorPacketController.GetPacket(ID_ACTOR_POSITION)->setDeltaState(&positionDeltaState);
+    objectPacketController.GetPacket(ID_CONTAINER)->setRecordIdState(&recordIdState);
+    playerPacketController.GetPacket(ID_PLAYER_INVENTORY)->setRecordIdState(&recordIdState);
+
+    // Dynamic records sent only as hashes are looked up in the record cache
+    static_cast<PacketRecordDynamic *>(worldstatePacketController.GetPacket(ID_RECORD_DYNAMIC))->setRecordCache(
+        worldstate.getRecordCache());
+
     connected = 0;
     ProcessorInitializer();
 }
@@ -255,6 +274,14 @@ void Networking::update()
                 break;
             default:
                 receiveMessage(packet);
+
+                // A packet that couldn't be read through the record id tables means ours no longer
+                // match the server's, so both start over
+                if (recordIdState.isDesynced())
+                {
+                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Record ids from the server are out of sync, resetting them");
+                    sendRecordIdReset();
+                }
                 //LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Message with identifier %i has arrived.", packet->data[0]);
                 break;
         }
@@ -264,6 +291,9 @@ void Networking::update()
     {
         LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, errmsg.c_str());
         SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_ERROR, "tes3mp", errmsg.c_str(), 0);
+
+        // Stop applying container contents from a server we are no longer connected to
+        Main::get().getContainerEditQueue()->clear();
         MWBase::Environment::get().getStateManager()->requestQuit();
     }
 }
@@ -286,6 +316,8 @@ void Networking::connect(const std::string &ip, unsigned short port, std::vector
     if (peer->Connect(master.ToString(false), master.GetPort(), sstr.str().c_str(), (int) sstr.str().size(), 0, 0, 3, 500, 0) != RakNet::CONNECTION_ATTEMPT_STARTED)
         errmsg = "Connection attempt failed.\n";
 
+    worldstate.setServerAddress(master.ToString(true, '_'));
+
     bool queue = true;
     while (queue)
     {
@@ -373,6 +405,8 @@ void Networking::preInit(std::vector<std::string> &content, Files::Collections &
             throw std::runtime_error("Plugin doesn't exist.");
     }
 
+    contentChecksums = checksums;
+
     PacketPreInit packetPreInit(peer);
     RakNet::BitStream bs;
     RakNet::RakNetGUID guid;
@@ -428,30 +462,63 @@ void Networking::receiveMessage(RakNet::Packet *packet)
     if (packet->length < 2)
         return;
 
-    if (systemPacketController.ContainsPacket(packet->data[0]))
-    {
-        if (!SystemProcessor::Process(*packet))
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled SystemPacket with identifier %i has arrived", packet->data[0]);
-    }
-    else if (playerPacketController.ContainsPacket(packet->data[0]))
-    {
-        if (!PlayerProcessor::Process(*packet))
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled PlayerPacket with identifier %i has arrived", packet->data[0]);
-    }
-    else if (actorPacketController.ContainsPacket(packet->data[0]))
-    {
-        if (!ActorProcessor::Process(*packet, actorList))
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ActorPacket with identifier %i has arrived", packet->data[0]);
-    }
-    else if (objectPacketController.ContainsPacket(packet->data[0]))
+    if (packet->data[0] == ID_PACKET_BATCH)
+        receiveBatch(packet);
+    else
     {
-        if (!ObjectProcessor::Process(*packet, objectList))
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ObjectPacket with identifier %i has arrived", packet->data[0]);
+        switch (dispatchTable.get(packet->data[0]).category)
+        {
+            case PacketDispatchTable::Category::System:
+                if (!SystemProcessor::Process(*packet))
+                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled SystemPacket with identifier %i has arrived", packet->data[0]);
+                break;
+            case PacketDispatchTable::Category::Player:
+                if (!PlayerProcessor::Process(*packet))
+                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled PlayerPacket with identifier %i has arrived", packet->data[0]);
+                break;
+            case PacketDispatchTable::Category::Actor:
+                if (!ActorProcessor::Process(*packet, actorList))
+                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ActorPacket with identifier %i has arrived", packet->data[0]);
+                break;
+            case PacketDispatchTable::Category::Object:
+                if (!ObjectProcessor::Process(*packet, objectList))
+                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled ObjectPacket with identifier %i has arrived", packet->data[0]);
+                break;
+            case PacketDispatchTable::Category::Worldstate:
+                if (!WorldstateProcessor::Process(*packet, worldstate))
+                    LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled WorldstatePacket with identifier %i has arrived", packet->data[0]);
+                break;
+            default:
+                break;
+        }
     }
-    else if (worldstatePacketController.ContainsPacket(packet->data[0]))
+}
+
+void Networking::receiveBatch(RakNet::Packet *packet)
+{
+    // Every packet in a batch is prefixed with its length as a little-endian 32-bit integer
+    unsigned int offset = 1;
+
+    while (offset + 4 <= packet->length)
     {
-        if (!WorldstateProcessor::Process(*packet, worldstate))
-            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Unhandled WorldstatePacket with identifier %i has arrived", packet->data[0]);
+        unsigned int length = packet->data[offset] | (packet->data[offset + 1] << 8) |
+            (packet->data[offset + 2] << 16) | ((unsigned int) packet->data[offset + 3] << 24);
+        offset += 4;
+
+        if (length > packet->length - offset)
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received ID_PACKET_BATCH with an invalid length and ignored the rest of it");
+            return;
+        }
+
+        RakNet::Packet batchedPacket = *packet;
+        batchedPacket.data = &packet->data[offset];
+        batchedPacket.length = length;
+        batchedPacket.bitSize = (RakNet::BitSize_t) length * 8;
+
+        receiveMessage(&batchedPacket);
+
+        offset += length;
     }
 }
 
@@ -505,6 +572,26 @@ Worldstate *Networking::getWorldstate()
     return &worldstate;
 }
 
+RecordIdState *Networking::getRecordIdState()
+{
+    return &recordIdState;
+}
+
+void Networking::sendRecordIdReset()
+{
+    LocalSystem *localSystem = getLocalSystem();
+    localSystem->recordIdEpoch = recordIdState.resetRead();
+
+    SystemPacket *myPacket = getSystemPacket(ID_SYSTEM_RECORD_ID_RESET);
+    myPacket->setSystem(localSystem);
+    myPacket->Send(serverAddr);
+}
+
+const PacketPreInit::PluginContainer &Networking::getContentChecksums() const
+{
+    return contentChecksums;
+}
+
 bool Networking::isConnected()
 {
     return connected;
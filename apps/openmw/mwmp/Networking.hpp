@@ -12,6 +12,10 @@
 #include <components/openmw-mp/Controllers/ActorPacketController.hpp>
 #include <components/openmw-mp/Controllers/ObjectPacketController.hpp>
 #include <components/openmw-mp/Controllers/WorldstatePacketController.hpp>
+#include <components/openmw-mp/Controllers/PacketDispatchTable.hpp>
+#include <components/openmw-mp/Packets/PacketPreInit.hpp>
+#include <components/openmw-mp/Packets/PositionDeltaState.hpp>
+#include <components/openmw-mp/Packets/RecordIdState.hpp>
 
 #include <components/files/collections.hpp>
 
@@ -50,6 +54,14 @@ namespace mwmp
         ActorList *getActorList();
         ObjectList *getObjectList();
         Worldstate *getWorldstate();
+        RecordIdState *getRecordIdState();
+
+        // Start over with empty record id tables for the packets the server sends us, and ask it to
+        // do the same
+        void sendRecordIdReset();
+
+        // The checksums of the content files sent to the server, in load order
+        const PacketPreInit::PluginContainer &getContentChecksums() const;
 
     private:
         bool connected;
@@ -62,12 +74,20 @@ namespace mwmp
         ActorPacketController actorPacketController;
         ObjectPacketController objectPacketController;
         WorldstatePacketController worldstatePacketController;
+        PacketDispatchTable dispatchTable;
+
+        // Position keyframes exchanged with the server
+        PositionDeltaState positionDeltaState;
+        RecordIdState recordIdState;
 
         ActorList actorList;
         ObjectList objectList;
         Worldstate worldstate;
 
+        PacketPreInit::PluginContainer contentChecksums;
+
         void receiveMessage(RakNet::Packet *packet);
+        void receiveBatch(RakNet::Packet *packet);
 
         void preInit(std::vector<std::string> &content, Files::Collections &collections);
     };
@@ -7,6 +7,7 @@
 #include "PlayerList.hpp"
 #include "CellController.hpp"
 #include "RecordHelper.hpp"
+#include "ContainerEditQueue.hpp"
 
 #include <components/translation/translation.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
@@ -149,6 +150,9 @@ void ObjectList::addEntireContainer(const MWWorld::Ptr& ptr)
     LOG_APPEND(TimedLog::LOG_VERBOSE, "-- Adding entire container %s %i-%i", ptr.getCellRef().getRefId().c_str(),
         ptr.getCellRef().getRefNum().mIndex, ptr.getCellRef().getMpNum());
 
+    // Send the contents the server has sent us, including the ones that haven't been applied yet
+    Main::get().getContainerEditQueue()->applyAll();
+
     MWWorld::ContainerStore& containerStore = ptr.getClass().getContainerStore(ptr);
 
     mwmp::BaseObject baseObject = getBaseObjectFromPtr(ptr);
@@ -171,167 +175,21 @@ void ObjectList::editContainers(MWWorld::CellStore* cellStore)
 
     LOG_APPEND(TimedLog::LOG_VERBOSE, "- isLocalEvent? %s", isLocalEvent ? "true" : "false");
 
-    BaseObject baseObject;
+    ContainerEditQueue *containerEditQueue = Main::get().getContainerEditQueue();
 
     for (unsigned int i = 0; i < baseObjectCount; i++)
     {
-        baseObject = baseObjects.at(i);
+        BaseObject &baseObject = baseObjects.at(i);
 
         LOG_APPEND(TimedLog::LOG_VERBOSE, "- container %s %i-%i", baseObject.refId.c_str(), baseObject.refNum, baseObject.mpNum);
 
-        MWWorld::Ptr ptrFound = cellStore->searchExact(baseObject.refNum, baseObject.mpNum, baseObject.refId);
-
-        if (ptrFound)
-        {
-            LOG_APPEND(TimedLog::LOG_VERBOSE, "-- Found %s %i-%i", ptrFound.getCellRef().getRefId().c_str(),
-                ptrFound.getCellRef().getRefNum(), ptrFound.getCellRef().getMpNum());
-
-            bool isCurrentContainer = false;
-            bool hasActorEquipment = ptrFound.getClass().isActor() && ptrFound.getClass().hasInventoryStore(ptrFound);
-
-            // If we are in a container, and it happens to be this container, keep track of that
-            if (MWBase::Environment::get().getWindowManager()->containsMode(MWGui::GM_Container))
-            {
-                CurrentContainer *currentContainer = &mwmp::Main::get().getLocalPlayer()->currentContainer;
-
-                if (currentContainer->refNum == ptrFound.getCellRef().getRefNum().mIndex &&
-                    currentContainer->mpNum == ptrFound.getCellRef().getMpNum())
-                {
-                    isCurrentContainer = true;
-                }
-            }
-
-            MWWorld::ContainerStore& containerStore = ptrFound.getClass().getContainerStore(ptrFound);
-
-            // If we are setting the entire contents, clear the current ones
-            if (action == BaseObjectList::SET)
-            {
-                containerStore.setResolved(true);
-                containerStore.clear();
-            }
-
-            bool isLocalDrag = isLocalEvent && containerSubAction == BaseObjectList::DRAG;
-            bool isLocalTakeAll = isLocalEvent && containerSubAction == BaseObjectList::TAKE_ALL;
-            std::string takeAllSound = "";
-
-            MWWorld::Ptr ownerPtr = ptrFound.getClass().isActor() ? ptrFound : MWBase::Environment::get().getWorld()->getPlayerPtr();
-
-            for (const auto &containerItem : baseObject.containerItems)
-            {
-                //LOG_APPEND(TimedLog::LOG_VERBOSE, "-- containerItem %s, count: %i, actionCount: %i",
-                //    containerItem.refId.c_str(), containerItem.count, containerItem.actionCount);
-
-                if (containerItem.refId.find("$dynamic") != std::string::npos)
-                    continue;
-
-                if (action == BaseObjectList::SET || action == BaseObjectList::ADD)
-                {
-                    // Create a ManualRef to be able to set item charge
-                    MWWorld::ManualRef ref(MWBase::Environment::get().getWorld()->getStore(), containerItem.refId, 1);
-                    MWWorld::Ptr newPtr = ref.getPtr();
-
-                    if (containerItem.count > 1)
-                        newPtr.getRefData().setCount(containerItem.count);
-
-                    if (containerItem.charge > -1)
-                        newPtr.getCellRef().setCharge(containerItem.charge);
-
-                    if (containerItem.enchantmentCharge > -1)
-                        newPtr.getCellRef().setEnchantmentCharge(containerItem.enchantmentCharge);
-
-                    if (!containerItem.soul.empty())
-                        newPtr.getCellRef().setSoul(containerItem.soul);
-
-                    containerStore.add(newPtr, containerItem.count, ownerPtr);
-                }
-
-                else if (action == BaseObjectList::REMOVE && containerItem.actionCount > 0)
-                {
-                    // We have to find the right item ourselves because ContainerStore has no method
-                    // accounting for charge
-                    for (const auto itemPtr : containerStore)
-                    {
-                        if (Misc::StringUtils::ciEqual(itemPtr.getCellRef().getRefId(), containerItem.refId))
-                        {
-                            if (itemPtr.getCellRef().getCharge() == containerItem.charge &&
-                                itemPtr.getCellRef().getEnchantmentCharge() == containerItem.enchantmentCharge &&
-                                Misc::StringUtils::ciEqual(itemPtr.getCellRef().getSoul(), containerItem.soul))
-                            {
-                                // Store the sound of the first item in a TAKE_ALL
-                                if (isLocalTakeAll && takeAllSound.empty())
-                                    takeAllSound = itemPtr.getClass().getUpSoundId(itemPtr);
-
-                                // Is this an actor's container? If so, unequip this item if it was equipped
-                                if (hasActorEquipment)
-                                {
-                                    MWWorld::InventoryStore& invStore = ptrFound.getClass().getInventoryStore(ptrFound);
-
-                                    if (invStore.isEquipped(itemPtr))
-                                        invStore.unequipItemQuantity(itemPtr, ptrFound, containerItem.count);
-                                }
-
-                                bool isDragResolved = false;
-
-                                if (isLocalDrag && isCurrentContainer)
-                                {
-                                    MWGui::ContainerWindow* containerWindow = MWBase::Environment::get().getWindowManager()->getContainerWindow();
-
-                                    if (!containerWindow->isOnDragAndDrop())
-                                    {
-                                        isDragResolved = containerWindow->dragItemByPtr(itemPtr, containerItem.actionCount);
-                                    }
-                                }
-
-                                if (!isLocalDrag || !isDragResolved)
-                                {
-                                    containerStore.remove(itemPtr, containerItem.actionCount, ownerPtr);
-
-                                    if (isLocalDrag || isLocalTakeAll)
-                                    {
-                                        MWWorld::Ptr ptrPlayer = MWBase::Environment::get().getWorld()->getPlayerPtr();
-                                        MWWorld::ContainerStore &playerStore = ptrPlayer.getClass().getContainerStore(ptrPlayer);
-                                        *playerStore.add(itemPtr, containerItem.actionCount, ownerPtr, false);
-                                    }
-                                }
-                            }
-                        }
-                    }
-                }
-            }
-
-            // Was this a SET or ADD action on an actor's container, and are we the authority
-            // over the actor? If so, autoequip the actor
-            if ((action == BaseObjectList::ADD || action == BaseObjectList::SET) && hasActorEquipment &&
-                mwmp::Main::get().getCellController()->isLocalActor(ptrFound))
-            {
-                MWWorld::InventoryStore& invStore = ptrFound.getClass().getInventoryStore(ptrFound);
-                invStore.autoEquip(ptrFound);
-                mwmp::Main::get().getCellController()->getLocalActor(ptrFound)->updateEquipment(true, true);
-            }
-
-            // If this container can be harvested, disable and then enable it again to refresh its animation
-            if (ptrFound.getClass().canBeHarvested(ptrFound))
-            {
-                MWBase::Environment::get().getWorld()->disable(ptrFound);
-                MWBase::Environment::get().getWorld()->enable(ptrFound);
-            }
-
-            // If this container was open for us, update its view
-            if (isCurrentContainer)
-            {
-                if (isLocalTakeAll)
-                {
-                    MWBase::Environment::get().getWindowManager()->removeGuiMode(MWGui::GM_Container);
-                    MWBase::Environment::get().getWindowManager()->playSound(takeAllSound);
-                }
-                else
-                {
-                    MWGui::ContainerWindow* containerWindow = MWBase::Environment::get().getWindowManager()->getContainerWindow();
-                    containerWindow->setPtr(ptrFound);
-                }
-            }
-        }
+        containerEditQueue->queue(*cellStore->getCell(), baseObject, action, containerSubAction, isLocalEvent);
     }
+
+    // Our own container actions can involve the container window we have open, so apply them right
+    // away, along with anything received before them, while other edits are left to Main::frame
+    if (isLocalEvent)
+        containerEditQueue->applyAll();
 }
 
 void ObjectList::activateObjects(MWWorld::CellStore* cellStore)
@@ -445,6 +303,7 @@ void ObjectList::placeObjects(MWWorld::CellStore* cellStore)
 
                 // Because gold automatically gets replaced with a new object, make sure we set the mpNum at the end
                 newPtr.getCellRef().setMpNum(baseObject.mpNum);
+                newPtr.getCell()->updateRefNumIndex(newPtr);
 
                 if (baseObject.droppedByPlayer)
                 {
@@ -115,6 +115,31 @@ std::vector<RakNet::RakNetGUID> PlayerList::getPlayersInCell(const ESM::Cell& ce
     return playersInCell;
 }
 
+void PlayerList::getObserverPositions(const MWWorld::CellStore *cellStore, std::vector<osg::Vec3f>& positions)
+{
+    positions.clear();
+
+    // Players in any exterior cell can see into neighbouring exterior cells, but players in an
+    // interior can only see the one they are in
+    auto addObserver = [&](const MWWorld::Ptr& playerPtr) {
+        if (playerPtr.mRef == nullptr || playerPtr.getCell() == nullptr || !playerPtr.getRefData().isEnabled())
+            return;
+
+        const MWWorld::CellStore *playerCellStore = playerPtr.getCell();
+
+        if (playerCellStore == cellStore || (cellStore->isExterior() && playerCellStore->isExterior()))
+            positions.push_back(playerPtr.getRefData().getPosition().asVec3());
+    };
+
+    addObserver(MWBase::Environment::get().getWorld()->getPlayerPtr());
+
+    for (auto& playerEntry : playerList)
+    {
+        if (playerEntry.second != nullptr)
+            addObserver(playerEntry.second->getPtr());
+    }
+}
+
 bool PlayerList::isDedicatedPlayer(const MWWorld::Ptr &ptr)
 {
     if (ptr.mRef == nullptr)
@@ -12,6 +12,8 @@
 #include "DedicatedPlayer.hpp"
 
 #include <map>
+#include <vector>
+#include <osg/Vec3f>
 #include <RakNetTypes.h>
 
 namespace MWMechanics
@@ -37,6 +39,9 @@ namespace mwmp
         static DedicatedPlayer* getPlayer(int actorId);
         static std::vector<RakNet::RakNetGUID> getPlayersInCell(const ESM::Cell& cell);
 
+        // Get the positions of the players, including our own, who can see the actors in a cell
+        static void getObserverPositions(const MWWorld::CellStore *cellStore, std::vector<osg::Vec3f>& positions);
+
         static bool isDedicatedPlayer(const MWWorld::Ptr &ptr);
 
         static void enableMarkers(const ESM::Cell& cell);
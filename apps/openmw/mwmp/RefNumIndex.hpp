@@ -0,0 +1,75 @@
+#ifndef OPENMW_REFNUMINDEX_HPP
+#define OPENMW_REFNUMINDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <components/openmw-mp/ActorKey.hpp>
+
+namespace mwmp
+{
+    /*
+        The references of a cell indexed by their refNum and mpNum, used by CellStore::searchExact
+        so it doesn't have to go through every reference in the cell
+
+        Every reference stays listed under the refNum and mpNum it had when it was added, so it can
+        still be removed after they change, and references with the same ones are listed in the order
+        they were added in
+    */
+    template <class Ref>
+    class RefNumIndex
+    {
+    public:
+        void add(Ref *ref, unsigned int refNum, unsigned int mpNum)
+        {
+            const ActorKey key = getActorKey(refNum, mpNum);
+
+            if (keys.emplace(ref, key).second)
+                refs[key].push_back(ref);
+        }
+
+        void remove(Ref *ref)
+        {
+            auto keyIt = keys.find(ref);
+
+            if (keyIt == keys.end())
+                return;
+
+            auto it = refs.find(keyIt->second);
+            std::vector<Ref *> &refsWithKey = it->second;
+            refsWithKey.erase(std::find(refsWithKey.begin(), refsWithKey.end(), ref));
+
+            if (refsWithKey.empty())
+                refs.erase(it);
+
+            keys.erase(keyIt);
+        }
+
+        // The references added with a refNum and mpNum, or nullptr if there are none
+        const std::vector<Ref *> *find(unsigned int refNum, unsigned int mpNum) const
+        {
+            auto it = refs.find(getActorKey(refNum, mpNum));
+            return it != refs.end() ? &it->second : nullptr;
+        }
+
+        void clear()
+        {
+            refs.clear();
+            keys.clear();
+        }
+
+        void reserve(std::size_t count)
+        {
+            refs.reserve(count);
+            keys.reserve(count);
+        }
+
+    private:
+        std::unordered_map<ActorKey, std::vector<Ref *>> refs;
+        std::unordered_map<Ref *, ActorKey> keys;
+    };
+}
+
+#endif //OPENMW_REFNUMINDEX_HPP
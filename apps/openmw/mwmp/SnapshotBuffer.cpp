@@ -0,0 +1,153 @@
+#include "SnapshotBuffer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace mwmp;
+
+double SnapshotBuffer::interpolationDelay = 100;
+double SnapshotBuffer::maxExtrapolation = 250;
+
+namespace
+{
+    // How quickly the time positions are shown from drifts back toward the interpolation delay,
+    // as a fraction of the difference per second
+    const double catchUpRate = 2;
+
+    // Differences larger than this, in milliseconds, are caught up on at once
+    const double maxDrift = 1000;
+
+    const double pi = 3.14159265358979323846;
+
+    float interpolateAngle(float from, float to, double fraction)
+    {
+        double difference = std::fmod(static_cast<double>(to) - from, 2 * pi);
+
+        if (difference > pi)
+            difference -= 2 * pi;
+        else if (difference < -pi)
+            difference += 2 * pi;
+
+        return static_cast<float>(from + difference * fraction);
+    }
+}
+
+SnapshotBuffer::SnapshotBuffer() : first(0), count(0), lastTimestamp(0), renderTime(0), hasRenderTime(false)
+{
+
+}
+
+void SnapshotBuffer::add(uint32_t timestamp, const ESM::Position &position)
+{
+    const int32_t elapsed = static_cast<int32_t>(timestamp - lastTimestamp);
+
+    // A position without a server time is snapped to, and so is the first one after it, since
+    // there is no time to interpolate from
+    if (timestamp == 0 || count == 0 || lastTimestamp == 0 || elapsed <= 0)
+    {
+        clear();
+
+        snapshots[0].time = 0;
+        snapshots[0].position = position;
+        count = 1;
+    }
+    else
+    {
+        const double time = at(count - 1).time + elapsed;
+
+        if (count == capacity)
+            removeFirst();
+
+        Snapshot &snapshot = snapshots[(first + count) % capacity];
+        snapshot.time = time;
+        snapshot.position = position;
+        count++;
+    }
+
+    lastTimestamp = timestamp;
+}
+
+void SnapshotBuffer::clear()
+{
+    first = 0;
+    count = 0;
+    hasRenderTime = false;
+}
+
+bool SnapshotBuffer::sample(float dt, ESM::Position &position)
+{
+    if (count == 0)
+        return false;
+
+    const double newestTime = at(count - 1).time;
+    const double targetTime = newestTime - interpolationDelay;
+
+    if (!hasRenderTime)
+    {
+        renderTime = targetTime;
+        hasRenderTime = true;
+    }
+    else
+    {
+        renderTime += dt * 1000.0;
+
+        const double drift = targetTime - renderTime;
+
+        if (std::abs(drift) > maxDrift)
+            renderTime = targetTime;
+        else
+            renderTime += drift * std::min(1.0, dt * catchUpRate);
+    }
+
+    renderTime = std::min(renderTime, newestTime + maxExtrapolation);
+
+    // Only keep the last position before the time being shown
+    while (count > 2 && at(1).time <= renderTime)
+        removeFirst();
+
+    if (count == 1 || renderTime <= at(0).time)
+        position = at(0).position;
+    else if (renderTime < at(1).time)
+        position = interpolate(at(0), at(1), renderTime);
+    else
+        position = interpolate(at(count - 2), at(count - 1), renderTime);
+
+    return true;
+}
+
+void SnapshotBuffer::setInterpolationDelay(float seconds)
+{
+    interpolationDelay = std::max(0.0f, seconds) * 1000.0;
+}
+
+void SnapshotBuffer::setMaxExtrapolation(float seconds)
+{
+    maxExtrapolation = std::max(0.0f, seconds) * 1000.0;
+}
+
+const SnapshotBuffer::Snapshot &SnapshotBuffer::at(std::size_t index) const
+{
+    return snapshots[(first + index) % capacity];
+}
+
+void SnapshotBuffer::removeFirst()
+{
+    first = (first + 1) % capacity;
+    count--;
+}
+
+ESM::Position SnapshotBuffer::interpolate(const Snapshot &from, const Snapshot &to, double time)
+{
+    const double duration = to.time - from.time;
+    const double fraction = duration > 0 ? (time - from.time) / duration : 1;
+
+    ESM::Position position;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        position.pos[i] = static_cast<float>(from.position.pos[i] + (to.position.pos[i] - from.position.pos[i]) * fraction);
+        position.rot[i] = interpolateAngle(from.position.rot[i], to.position.rot[i], fraction);
+    }
+
+    return position;
+}
@@ -0,0 +1,67 @@
+#ifndef OPENMW_SNAPSHOTBUFFER_HPP
+#define OPENMW_SNAPSHOTBUFFER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <components/esm/defs.hpp>
+
+namespace mwmp
+{
+    /*
+        The positions received for a DedicatedPlayer or DedicatedActor, each with the server time at
+        which it was sent out
+
+        Positions are shown from a configurable delay behind the newest one, interpolating between the
+        two received around that time, so positions arriving unevenly don't show up as uneven movement.
+        When positions are late, movement is extrapolated from the last two for a limited time and then
+        held in place
+
+        Positions sent without a server time, or with one that isn't newer than the last one, replace
+        everything before them, which is how teleports and other corrections are handled. The server
+        sends every position outside of its tick without a server time
+    */
+    class SnapshotBuffer
+    {
+    public:
+        SnapshotBuffer();
+
+        void add(uint32_t timestamp, const ESM::Position &position);
+        void clear();
+
+        // Advance by dt seconds and get the position to show, returning false if there is none
+        bool sample(float dt, ESM::Position &position);
+
+        static void setInterpolationDelay(float seconds);
+        static void setMaxExtrapolation(float seconds);
+
+    private:
+        struct Snapshot
+        {
+            double time;
+            ESM::Position position;
+        };
+
+        static const std::size_t capacity = 16;
+
+        const Snapshot &at(std::size_t index) const;
+        void removeFirst();
+
+        static ESM::Position interpolate(const Snapshot &from, const Snapshot &to, double time);
+
+        std::array<Snapshot, capacity> snapshots;
+        std::size_t first;
+        std::size_t count;
+
+        // Server time in milliseconds, kept as a double that doesn't wrap around like the timestamps do
+        uint32_t lastTimestamp;
+        double renderTime;
+        bool hasRenderTime;
+
+        static double interpolationDelay;
+        static double maxExtrapolation;
+    };
+}
+
+#endif //OPENMW_SNAPSHOTBUFFER_HPP
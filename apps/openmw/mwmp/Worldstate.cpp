@@ -1,4 +1,8 @@
+#include <cctype>
+
 #include <components/openmw-mp/TimedLog.hpp>
+#include <components/openmw-mp/Utils.hpp>
+#include <components/openmw-mp/Packets/Worldstate/PacketRecordCache.hpp>
 
 #include "../mwbase/environment.hpp"
 
@@ -16,10 +20,11 @@
 #include "DedicatedPlayer.hpp"
 #include "RecordHelper.hpp"
 #include "CellController.hpp"
+#include "ContainerEditQueue.hpp"
 
 using namespace mwmp;
 
-Worldstate::Worldstate()
+Worldstate::Worldstate() : isAwaitingMapTiles(false), mapTileCache("maptiles"), recordCache("records")
 {
     hasPlayerCollision = true;
     hasActorCollision = true;
@@ -37,6 +42,11 @@ Networking *Worldstate::getNetworking()
     return mwmp::Main::get().getNetworking();
 }
 
+const ContentCache *Worldstate::getRecordCache() const
+{
+    return &recordCache;
+}
+
 void Worldstate::addRecords()
 {
     LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Received ID_RECORD_DYNAMIC with %i records of type %i",
@@ -441,18 +451,84 @@ void Worldstate::setKills()
 
 void Worldstate::setMapExplored()
 {
+    if (mapTilesAction == MAP_TILES_LIST)
+    {
+        std::vector<MapTile> cachedMapTiles;
+
+        for (auto &&mapTile : mapTiles)
+        {
+            if (mapTileCache.load(mapTile.hash, mapTile.imageData))
+            {
+                setMapTile(mapTile);
+                cachedMapTiles.push_back({mapTile.x, mapTile.y, mapTile.hash, {}});
+            }
+            else
+                missingMapTiles.push_back(mapTile);
+        }
+
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Received ID_WORLD_MAP listing %zu map tiles, of which %zu were cached",
+            mapTiles.size(), cachedMapTiles.size());
+
+        // Let the server know which tiles it no longer has to keep for us
+        if (!cachedMapTiles.empty())
+        {
+            mapTilesAction = MAP_TILES_CACHED;
+            mapTiles = std::move(cachedMapTiles);
+
+            getNetworking()->getWorldstatePacket(ID_WORLD_MAP)->setWorldstate(this);
+            getNetworking()->getWorldstatePacket(ID_WORLD_MAP)->Send();
+        }
+
+        if (!isAwaitingMapTiles)
+            requestMapTiles();
+
+        return;
+    }
+
     for (const auto &mapTile : mapTiles)
     {
-        const MWWorld::CellStore *cellStore = MWBase::Environment::get().getWorld()->getExterior(mapTile.x, mapTile.y);
+        setMapTile(mapTile);
+        mapTileCache.store(Utils::hashBytes(mapTile.imageData.data(), mapTile.imageData.size()), mapTile.imageData);
+    }
+
+    if (mapTilesAction == MAP_TILES_CHUNK)
+    {
+        isAwaitingMapTiles = false;
+        requestMapTiles();
+    }
+}
+
+void Worldstate::setMapTile(const MapTile &mapTile)
+{
+    const MWWorld::CellStore *cellStore = MWBase::Environment::get().getWorld()->getExterior(mapTile.x, mapTile.y);
 
-        if (!cellStore->getCell()->mName.empty())
-            MWBase::Environment::get().getWindowManager()->addVisitedLocation(cellStore->getCell()->mName, mapTile.x, mapTile.y);
+    if (!cellStore->getCell()->mName.empty())
+        MWBase::Environment::get().getWindowManager()->addVisitedLocation(cellStore->getCell()->mName, mapTile.x, mapTile.y);
 
-        MWBase::Environment::get().getWindowManager()->setGlobalMapImage(mapTile.x, mapTile.y, mapTile.imageData);
+    MWBase::Environment::get().getWindowManager()->setGlobalMapImage(mapTile.x, mapTile.y, mapTile.imageData);
 
-        // Keep this tile marked as explored so we don't send any more packets for it
-        markExploredMapTile(mapTile.x, mapTile.y);
+    // Keep this tile marked as explored so we don't send any more packets for it
+    markExploredMapTile(mapTile.x, mapTile.y);
+}
+
+void Worldstate::requestMapTiles()
+{
+    if (missingMapTiles.empty())
+        return;
+
+    mapTilesAction = MAP_TILES_REQUEST;
+    mapTiles.clear();
+
+    while (!missingMapTiles.empty() && mapTiles.size() < maxMapTilesPerRequest)
+    {
+        mapTiles.push_back(missingMapTiles.front());
+        missingMapTiles.pop_front();
     }
+
+    isAwaitingMapTiles = true;
+
+    getNetworking()->getWorldstatePacket(ID_WORLD_MAP)->setWorldstate(this);
+    getNetworking()->getWorldstatePacket(ID_WORLD_MAP)->Send();
 }
 
 void Worldstate::setWeather()
@@ -511,6 +587,7 @@ void Worldstate::resetCells(std::vector<ESM::Cell>* cells)
             }
         }
 
+        mwmp::Main::get().getContainerEditQueue()->clear(cell);
         world->clearCellStore(cell);
 
         for (RakNet::RakNetGUID otherGuid : playersInCell)
@@ -573,8 +650,39 @@ void Worldstate::sendClientGlobal(std::string varName, float value)
     getNetworking()->getWorldstatePacket(ID_CLIENT_SCRIPT_GLOBAL)->Send();
 }
 
+void Worldstate::setServerAddress(const std::string &address)
+{
+    std::string directoryName = address;
+
+    for (char &character : directoryName)
+    {
+        if (!std::isalnum(static_cast<unsigned char>(character)) && character != '.')
+            character = '_';
+    }
+
+    recordCache = ContentCache("records/" + directoryName);
+}
+
+void Worldstate::sendRecordCache()
+{
+    // Drop the records unused the longest, so the list stays short enough to send on every join
+    recordCache.trim(PacketRecordCache::maxCachedRecords);
+
+    cachedRecords.clear();
+    recordCache.getHashes(cachedRecords, PacketRecordCache::maxCachedRecords);
+
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Sending ID_RECORD_CACHE with %u cached records",
+        (unsigned int) cachedRecords.size());
+
+    getNetworking()->getWorldstatePacket(ID_RECORD_CACHE)->setWorldstate(this);
+    getNetworking()->getWorldstatePacket(ID_RECORD_CACHE)->Send();
+
+    cachedRecords.clear();
+}
+
 void Worldstate::sendMapExplored(int cellX, int cellY, const std::vector<char>& imageData)
 {
+    mapTilesAction = MAP_TILES_SET;
     mapTiles.clear();
 
     mwmp::MapTile mapTile;
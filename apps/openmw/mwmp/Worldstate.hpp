@@ -1,6 +1,9 @@
 #ifndef OPENMW_WORLDSTATE_HPP
 #define OPENMW_WORLDSTATE_HPP
 
+#include <deque>
+
+#include <components/openmw-mp/ContentCache.hpp>
 #include <components/openmw-mp/Base/BaseWorldstate.hpp>
 
 namespace mwmp
@@ -25,6 +28,13 @@ namespace mwmp
 
         void resetCells(std::vector<ESM::Cell>* cells);
 
+        // Keep the dynamic records of every server in a cache of their own, so only the ones a server
+        // has actually sent are listed to it when joining
+        void setServerAddress(const std::string &address);
+
+        // Tell the server which dynamic records are cached, so it only sends their hashes from now on
+        void sendRecordCache();
+
         void sendClientGlobal(std::string varName, int value, mwmp::VARIABLE_TYPE variableType);
         void sendClientGlobal(std::string varName, float value);
         void sendMapExplored(int cellX, int cellY, const std::vector<char>& imageData);
@@ -39,10 +49,22 @@ namespace mwmp
         void sendClothingRecord(const ESM::Clothing* clothing, std::string baseRefId = "");
         void sendWeaponRecord(const ESM::Weapon* weapon, std::string baseRefId = "", unsigned int quantity = 1);
 
+        const ContentCache *getRecordCache() const;
+
     private:
 
+        void setMapTile(const MapTile &mapTile);
+        void requestMapTiles();
+
         std::vector<MapTile> exploredMapTiles;
 
+        // Listed map tiles that weren't cached, which are asked for a chunk at a time, with the next
+        // chunk only being asked for once the previous one has arrived
+        std::deque<MapTile> missingMapTiles;
+        bool isAwaitingMapTiles;
+        ContentCache mapTileCache;
+        ContentCache recordCache;
+
         Networking *getNetworking();
 
     };
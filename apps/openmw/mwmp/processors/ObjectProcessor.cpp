@@ -24,25 +24,23 @@ bool ObjectProcessor::Process(RakNet::Packet &packet, ObjectList &objectList)
     myPacket->setObjectList(&objectList);
     myPacket->SetReadStream(&bsIn);
 
-    for (auto &processor: processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            myGuid = Main::get().getLocalPlayer()->guid;
-            request = packet.length == myPacket->headerSize();
-
-            objectList.isValid = true;
-
-            if (!request && !processor.second->avoidReading)
-                myPacket->Read();
-
-            if (objectList.isValid)
-                processor.second->Do(*myPacket, objectList);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
-
-            return true;
-        }
-    }
-    return false;
+    ObjectProcessor *processor = GetProcessor(packet.data[0]);
+
+    if (processor == nullptr)
+        return false;
+
+    myGuid = Main::get().getLocalPlayer()->guid;
+    request = packet.length == myPacket->headerSize();
+
+    objectList.isValid = true;
+
+    if (!request && !processor->avoidReading)
+        myPacket->Read();
+
+    if (objectList.isValid)
+        processor->Do(*myPacket, objectList);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
+
+    return true;
 }
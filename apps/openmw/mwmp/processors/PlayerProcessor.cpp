@@ -25,28 +25,26 @@ bool PlayerProcessor::Process(RakNet::Packet &packet)
         // error: packet not found
     }*/
 
-    for (auto &processor : processors)
+    PlayerProcessor *processor = GetProcessor(packet.data[0]);
+
+    if (processor == nullptr)
+        return false;
+
+    myGuid = Main::get().getLocalPlayer()->guid;
+    request = packet.length == myPacket->headerSize();
+
+    BasePlayer *player = 0;
+    if (guid != myGuid)
+        player = PlayerList::getPlayer(guid);
+    else
+        player = Main::get().getLocalPlayer();
+
+    if (!request && !processor->avoidReading && player != 0)
     {
-        if (processor.first == packet.data[0])
-        {
-            myGuid = Main::get().getLocalPlayer()->guid;
-            request = packet.length == myPacket->headerSize();
-
-            BasePlayer *player = 0;
-            if (guid != myGuid)
-                player = PlayerList::getPlayer(guid);
-            else
-                player = Main::get().getLocalPlayer();
-
-            if (!request && !processor.second->avoidReading && player != 0)
-            {
-                myPacket->setPlayer(player);
-                myPacket->Read();
-            }
-
-            processor.second->Do(*myPacket, player);
-            return true;
-        }
+        myPacket->setPlayer(player);
+        myPacket->Read();
     }
-    return false;
+
+    processor->Do(*myPacket, player);
+    return true;
 }
@@ -2,6 +2,7 @@
 
 #include "SystemProcessor.hpp"
 #include "system/ProcessorSystemHandshake.hpp"
+#include "system/ProcessorSystemRecordIdReset.hpp"
 
 #include "PlayerProcessor.hpp"
 #include "player/ProcessorChatMessage.hpp"
@@ -90,6 +91,8 @@
 #include "actor/ProcessorActorSpeech.hpp"
 #include "actor/ProcessorActorSpellsActive.hpp"
 #include "actor/ProcessorActorStatsDynamic.hpp"
+#include "actor/ProcessorActorSnapshot.hpp"
+#include "actor/ProcessorActorUpdate.hpp"
 #include "actor/ProcessorActorTest.hpp"
 
 #include "WorldstateProcessor.hpp"
@@ -110,6 +113,7 @@ using namespace mwmp;
 void ProcessorInitializer()
 {
     SystemProcessor::AddProcessor(new ProcessorSystemHandshake());
+    SystemProcessor::AddProcessor(new ProcessorSystemRecordIdReset());
 
     PlayerProcessor::AddProcessor(new ProcessorChatMessage());
     PlayerProcessor::AddProcessor(new ProcessorGUIMessageBox());
@@ -195,6 +199,8 @@ void ProcessorInitializer()
     ActorProcessor::AddProcessor(new ProcessorActorSpeech());
     ActorProcessor::AddProcessor(new ProcessorActorSpellsActive());
     ActorProcessor::AddProcessor(new ProcessorActorStatsDynamic());
+    ActorProcessor::AddProcessor(new ProcessorActorSnapshot());
+    ActorProcessor::AddProcessor(new ProcessorActorUpdate());
     ActorProcessor::AddProcessor(new ProcessorActorTest());
 
     WorldstateProcessor::AddProcessor(new ProcessorCellReset());
@@ -24,25 +24,23 @@ bool WorldstateProcessor::Process(RakNet::Packet &packet, Worldstate &worldstate
     myPacket->setWorldstate(&worldstate);
     myPacket->SetReadStream(&bsIn);
 
-    for (auto &processor : processors)
-    {
-        if (processor.first == packet.data[0])
-        {
-            myGuid = Main::get().getLocalPlayer()->guid;
-            request = packet.length == myPacket->headerSize();
-
-            worldstate.isValid = true;
-
-            if (!request && !processor.second->avoidReading)
-                myPacket->Read();
-
-            if (worldstate.isValid)
-                processor.second->Do(*myPacket, worldstate);
-            else
-                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor.second->strPacketID.c_str());
-
-            return true;
-        }
-    }
-    return false;
+    WorldstateProcessor *processor = GetProcessor(packet.data[0]);
+
+    if (processor == nullptr)
+        return false;
+
+    myGuid = Main::get().getLocalPlayer()->guid;
+    request = packet.length == myPacket->headerSize();
+
+    worldstate.isValid = true;
+
+    if (!request && !processor->avoidReading)
+        myPacket->Read();
+
+    if (worldstate.isValid)
+        processor->Do(*myPacket, worldstate);
+    else
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Received %s that failed integrity check and was ignored!", processor->strPacketID.c_str());
+
+    return true;
 }
@@ -0,0 +1,25 @@
+#ifndef OPENMW_PROCESSORACTORSNAPSHOT_HPP
+#define OPENMW_PROCESSORACTORSNAPSHOT_HPP
+
+#include "../ActorProcessor.hpp"
+#include "apps/openmw/mwmp/Main.hpp"
+#include "apps/openmw/mwmp/CellController.hpp"
+
+namespace mwmp
+{
+    class ProcessorActorSnapshot final: public ActorProcessor
+    {
+    public:
+        ProcessorActorSnapshot()
+        {
+            BPP_INIT(ID_ACTOR_SNAPSHOT);
+        }
+
+        virtual void Do(ActorPacket &packet, ActorList &actorList)
+        {
+            Main::get().getCellController()->readSnapshot(actorList);
+        }
+    };
+}
+
+#endif //OPENMW_PROCESSORACTORSNAPSHOT_HPP
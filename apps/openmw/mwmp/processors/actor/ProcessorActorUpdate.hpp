@@ -0,0 +1,25 @@
+#ifndef OPENMW_PROCESSORACTORUPDATE_HPP
+#define OPENMW_PROCESSORACTORUPDATE_HPP
+
+#include "../ActorProcessor.hpp"
+#include "apps/openmw/mwmp/Main.hpp"
+#include "apps/openmw/mwmp/CellController.hpp"
+
+namespace mwmp
+{
+    class ProcessorActorUpdate final: public ActorProcessor
+    {
+    public:
+        ProcessorActorUpdate()
+        {
+            BPP_INIT(ID_ACTOR_UPDATE);
+        }
+
+        virtual void Do(ActorPacket &packet, ActorList &actorList)
+        {
+            Main::get().getCellController()->readUpdate(actorList);
+        }
+    };
+}
+
+#endif //OPENMW_PROCESSORACTORUPDATE_HPP
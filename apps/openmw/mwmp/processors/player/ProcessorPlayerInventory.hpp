@@ -21,6 +21,8 @@ namespace mwmp
 
             if (isRequest())
                 static_cast<LocalPlayer*>(player)->updateInventory(true);
+            else if (!packet.isPacketValid())
+                LOG_APPEND(TimedLog::LOG_WARN, "- Ignored it because its items could not be read");
             else
             {
                 LocalPlayer &localPlayer = static_cast<LocalPlayer&>(*player);
@@ -16,6 +16,10 @@ namespace mwmp
 
         virtual void Do(PlayerPacket &packet, BasePlayer *player)
         {
+            // Position deltas based on a keyframe we never read can't be applied
+            if (!isRequest() && !packet.isPacketValid())
+                return;
+
             if (isLocal())
             {
                 if (!isRequest())
@@ -28,7 +32,10 @@ namespace mwmp
                     static_cast<LocalPlayer*>(player)->updatePosition(true);
             }
             else if (player != 0) // dedicated player
+            {
+                static_cast<DedicatedPlayer*>(player)->bufferPosition();
                 static_cast<DedicatedPlayer*>(player)->updateMarker();
+            }
         }
     };
 }
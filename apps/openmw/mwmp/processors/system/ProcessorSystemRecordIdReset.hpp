@@ -0,0 +1,34 @@
+#ifndef OPENMW_PROCESSORSYSTEMRECORDIDRESET_HPP
+#define OPENMW_PROCESSORSYSTEMRECORDIDRESET_HPP
+
+#include <components/openmw-mp/Base/BaseSystem.hpp>
+#include <components/openmw-mp/Packets/RecordIdState.hpp>
+
+#include "apps/openmw/mwmp/Main.hpp"
+#include "apps/openmw/mwmp/Networking.hpp"
+
+#include "../SystemProcessor.hpp"
+
+namespace mwmp
+{
+    class ProcessorSystemRecordIdReset final: public SystemProcessor
+    {
+    public:
+        ProcessorSystemRecordIdReset()
+        {
+            BPP_INIT(ID_SYSTEM_RECORD_ID_RESET)
+        }
+
+        virtual void Do(SystemPacket &packet, BaseSystem *system)
+        {
+            if (!packet.isPacketValid())
+                return;
+
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Received ID_SYSTEM_RECORD_ID_RESET from server");
+
+            Main::get().getNetworking()->getRecordIdState()->resetWrite(system->recordIdEpoch);
+        }
+    };
+}
+
+#endif //OPENMW_PROCESSORSYSTEMRECORDIDRESET_HPP
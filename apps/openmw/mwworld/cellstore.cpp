@@ -303,6 +303,16 @@ namespace MWWorld
             mMovedHere.insert(std::make_pair(object.getBase(), from));
         }
         updateMergedRefs();
+
+        /*
+            Start of tes3mp addition
+
+            Make the moved reference searchable by its reference number and mpNum in this cell
+        */
+        addToRefNumIndex(object.getBase());
+        /*
+            End of tes3mp addition
+        */
     }
 
     MWWorld::Ptr CellStore::moveTo(const Ptr &object, CellStore *cellToMoveTo)
@@ -340,6 +350,16 @@ namespace MWWorld
             End of tes3mp change (major)
         */
 
+        /*
+            Start of tes3mp addition
+
+            Stop finding the moved reference in this cell by its reference number and mpNum
+        */
+        mRefNumIndex.remove(object.getBase());
+        /*
+            End of tes3mp addition
+        */
+
         MovedRefTracker::iterator found = mMovedHere.find(object.getBase());
         if (found != mMovedHere.end())
         {
@@ -644,9 +664,48 @@ namespace MWWorld
         if (refNum == 0 && mpNum == 0)
             return 0;
 
+        if (mState != State_Loaded || mMergedRefs.empty())
+            return Ptr();
+
+        mHasState = true;
+
+        const std::vector<LiveCellRefBase*>* refs = mRefNumIndex.find(refNum, mpNum);
+
+        if (!refs)
+            return Ptr();
+
         SearchExactVisitor searchVisitor(refNum, mpNum, refId, actorsOnly);
-        forEach(searchVisitor);
-        return searchVisitor.mFound;
+
+        for (LiveCellRefBase* ref : *refs)
+        {
+            if (!isAccessible(ref->mData, ref->mRef))
+                continue;
+
+            if (!searchVisitor(Ptr(ref, this)))
+                return searchVisitor.mFound;
+        }
+
+        return Ptr();
+    }
+
+    void CellStore::updateRefNumIndex(const Ptr& ptr)
+    {
+        mRefNumIndex.remove(ptr.getBase());
+        addToRefNumIndex(ptr.getBase());
+    }
+
+    void CellStore::addToRefNumIndex(LiveCellRefBase* ref)
+    {
+        mRefNumIndex.add(ref, ref->mRef.getRefNum().mIndex, ref->mRef.getMpNum());
+    }
+
+    void CellStore::rebuildRefNumIndex()
+    {
+        mRefNumIndex.clear();
+        mRefNumIndex.reserve(mMergedRefs.size());
+
+        for (LiveCellRefBase* ref : mMergedRefs)
+            addToRefNumIndex(ref);
     }
     /*
         End of tes3mp addition
@@ -865,6 +924,16 @@ namespace MWWorld
         }
 
         updateMergedRefs();
+
+        /*
+            Start of tes3mp addition
+
+            Index the loaded references by reference number and mpNum
+        */
+        rebuildRefNumIndex();
+        /*
+            End of tes3mp addition
+        */
     }
 
     bool CellStore::isExterior() const
@@ -1178,6 +1247,16 @@ namespace MWWorld
         // This update is only needed for old saves that used the old copy&delete way of moving objects
         updateMergedRefs();
 
+        /*
+            Start of tes3mp addition
+
+            Index the references by the reference numbers and mpNums they were given in the save
+        */
+        rebuildRefNumIndex();
+        /*
+            End of tes3mp addition
+        */
+
         while (reader.isNextSub("MVRF"))
         {
             reader.cacheSubName();
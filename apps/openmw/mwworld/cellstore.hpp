@@ -8,6 +8,16 @@
 #include <map>
 #include <memory>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include "../mwmp/RefNumIndex.hpp"
+/*
+    End of tes3mp addition
+*/
+
 #include "livecellref.hpp"
 #include "cellreflist.hpp"
 
@@ -110,6 +120,21 @@ namespace MWWorld
             // Merged list of ref's currently in this cell - i.e. with added refs from mMovedHere, removed refs from mMovedToAnotherCell
             std::vector<LiveCellRefBase*> mMergedRefs;
 
+            /*
+                Start of tes3mp addition
+
+                Index mMergedRefs by reference number and mpNum so searchExact doesn't have to go through
+                every reference in the cell, keeping the index up to date as references are added to the
+                cell or moved out of it
+            */
+            mwmp::RefNumIndex<LiveCellRefBase> mRefNumIndex;
+
+            void addToRefNumIndex(LiveCellRefBase* ref);
+            void rebuildRefNumIndex();
+            /*
+                End of tes3mp addition
+            */
+
             // Get the Ptr for the given ref which originated from this cell (possibly moved to another cell at this point).
             Ptr getCurrentPtr(MWWorld::LiveCellRefBase* ref);
 
@@ -218,6 +243,17 @@ namespace MWWorld
                 CellRefList<T>& list = get<T>();
                 LiveCellRefBase* ret = &list.insert(*ref);
                 updateMergedRefs();
+
+                /*
+                    Start of tes3mp addition
+
+                    Make the new reference searchable by its reference number and mpNum
+                */
+                addToRefNumIndex(ret);
+                /*
+                    End of tes3mp addition
+                */
+
                 return ret;
             }
 
@@ -266,6 +302,10 @@ namespace MWWorld
                 their refIds
             */
             Ptr searchExact (unsigned int refNum, unsigned int mpNum, std::string refId = "", bool actorsOnly = false);
+
+            /// Index a reference in this cell again after its reference number or mpNum was changed,
+            /// so searchExact finds it by the new ones
+            void updateRefNumIndex(const Ptr& ptr);
             /*
                 End of tes3mp addition
             */
@@ -8,6 +8,7 @@
     Include additional headers for multiplayer purposes
 */
 #include <components/openmw-mp/TimedLog.hpp>
+#include "cellstore.hpp"
 /*
     End of tes3mp addition
 */
@@ -412,6 +413,17 @@ namespace MWWorld
     {
         Ptr newPtr = copyToCellImpl(ptr, cell);
         newPtr.getCellRef().unsetRefNum(); // This RefNum is only valid within the original cell of the reference
+
+        /*
+            Start of tes3mp addition
+
+            Make the copy searchable by its new reference number
+        */
+        cell.updateRefNumIndex(newPtr);
+        /*
+            End of tes3mp addition
+        */
+
         newPtr.getRefData().setCount(count);
         return newPtr;
     }
@@ -23,6 +23,16 @@ void EsmLoader::load(const boost::filesystem::path& filepath, int& index)
   lEsm.setEncoder(mEncoder);
   lEsm.setIndex(index);
   lEsm.setGlobalReaderList(&mEsm);
+  /*
+      Start of tes3mp addition
+
+      Read content files through a memory mapping, which the readers copied from this one for
+      loading cells keep sharing
+  */
+  lEsm.setMemoryMapped(true);
+  /*
+      End of tes3mp addition
+  */
   lEsm.open(filepath.string());
   mEsm[index] = lEsm;
   mStore.load(mEsm[index], &mListener);
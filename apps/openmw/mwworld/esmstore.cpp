@@ -3,14 +3,49 @@
 #include <algorithm>
 #include <set>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <sstream>
+/*
+    End of tes3mp addition
+*/
+
 #include <boost/filesystem/operations.hpp>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <boost/filesystem/fstream.hpp>
+/*
+    End of tes3mp addition
+*/
+
 #include <components/debug/debuglog.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/esm/esmreader.hpp>
 #include <components/esm/esmwriter.hpp>
 #include <components/misc/algorithm.hpp>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <components/to_utf8/to_utf8.hpp>
+/*
+    End of tes3mp addition
+*/
+
 #include "../mwmechanics/spelllist.hpp"
 
 namespace
@@ -31,7 +66,22 @@ namespace
         {
             size_t index = cell.mContextList[i].index;
             if (readers.size() <= index)
+            {
+                /*
+                    Start of tes3mp change (minor)
+
+                    Memory map the content files the references are read from, since every cell
+                    reopens them
+                */
+                const size_t oldSize = readers.size();
                 readers.resize(index + 1);
+
+                for (size_t j = oldSize; j < readers.size(); j++)
+                    readers[j].setMemoryMapped(true);
+                /*
+                    End of tes3mp change (minor)
+                */
+            }
             cell.restore(readers[index], i);
             ESM::CellRef ref;
             ref.mRefNum.mContentFile = ESM::RefNum::RefNum_NoContentFile;
@@ -109,6 +159,31 @@ namespace
 
         return npcsToReplace;
     }
+
+    /*
+        Start of tes3mp addition
+
+        Content files are split into parts of roughly this size to be parsed ahead of time
+    */
+    constexpr std::size_t stagedPartSize = 8 * 1024 * 1024;
+
+    // Get the part of a content file a record belongs to based on its position among the records
+    // counted in the file's header, with any records beyond that count going to the last part
+    std::size_t getStagedPart(std::size_t recordIndex, std::size_t recordCount, std::size_t partCount)
+    {
+        if (recordCount == 0)
+            return 0;
+
+        return std::min(recordIndex * partCount / recordCount, partCount - 1);
+    }
+
+    double getElapsedMilliseconds(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    /*
+        End of tes3mp addition
+    */
 }
 
 namespace MWWorld
@@ -168,12 +243,46 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
         esm.addParentFileIndex(index);
     }
 
+    /*
+        Start of tes3mp addition
+
+        Use the records of this file that were parsed ahead of time, as long as all of them were
+    */
+    const auto start = std::chrono::steady_clock::now();
+    StagedContentFile *stagedFile = nullptr;
+
+    if (esm.getIndex() >= 0 && static_cast<std::size_t>(esm.getIndex()) < mStagedContentFiles.size())
+    {
+        StagedContentFile &file = mStagedContentFiles[esm.getIndex()];
+
+        if (!file.mParts.empty() && file.mPath == esm.getContext().filename)
+            stagedFile = &file;
+    }
+
+    std::size_t recordIndex = 0;
+    std::size_t stagedRecordCount = 0;
+    std::size_t snapshotRecordCount = 0;
+    /*
+        End of tes3mp addition
+    */
+
     // Loop through all records
     while(esm.hasMoreRecs())
     {
         ESM::NAME n = esm.getRecName();
         esm.getRecHeader();
 
+        /*
+            Start of tes3mp addition
+
+            Keep track of which part of the file each record was staged in
+        */
+        const std::size_t recordPart = stagedFile ? getStagedPart(recordIndex++, esm.getRecordCount(),
+            stagedFile->mParts.size()) : 0;
+        /*
+            End of tes3mp addition
+        */
+
         // Look up the record type.
         std::map<int, StoreBase *>::iterator it = mStores.find(n.intval);
 
@@ -204,7 +313,34 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
                 throw std::runtime_error(error.str());
             }
         } else {
-            RecordId id = it->second->load(esm);
+            /*
+                Start of tes3mp change (major)
+
+                Skip records of the stores that were loaded from a snapshot, and add the record
+                parsed ahead of time instead of parsing it now, if there is one
+            */
+            if (mIsSnapshotLoaded && it->second->isStageable())
+            {
+                esm.skipRecord();
+                snapshotRecordCount++;
+                dialogue = nullptr;
+                listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
+                continue;
+            }
+
+            RecordId id;
+
+            if (stagedFile && it->second->isStageable())
+            {
+                esm.skipRecord();
+                id = it->second->loadStaged(*stagedFile->mParts[recordPart].mRecords.at(n.intval));
+                stagedRecordCount++;
+            }
+            else
+                id = it->second->load(esm);
+            /*
+                End of tes3mp change (major)
+            */
             if (id.mIsDeleted)
             {
                 it->second->eraseStatic(id.mId);
@@ -219,8 +355,351 @@ void ESMStore::load(ESM::ESMReader &esm, Loading::Listener* listener)
         }
         listener->setProgress(static_cast<size_t>(esm.getFileOffset() / (float)esm.getFileSize() * 1000));
     }
+
+    /*
+        Start of tes3mp addition
+
+        Report how long loading the file took, and free the records parsed ahead of time
+    */
+    Log(Debug::Info) << "Loaded " << esm.getName() << " in " << getElapsedMilliseconds(start) << " ms, with "
+        << stagedRecordCount << " records parsed ahead of time and " << snapshotRecordCount
+        << " already loaded from a snapshot";
+
+    if (stagedFile)
+        *stagedFile = StagedContentFile();
+    /*
+        End of tes3mp addition
+    */
+}
+
+/*
+    Start of tes3mp addition
+
+    Parse the records of content files that don't depend on other records on worker threads ahead of
+    loading them, with each file split into parts of consecutive records so large files like
+    Morrowind.esm are spread across threads too
+*/
+void ESMStore::stage(const std::vector<std::string> &filePaths, ToUTF8::Utf8Encoder *encoder, Loading::Listener* listener,
+    std::size_t partCount)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const std::size_t maxThreadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::pair<StagedContentFile *, std::size_t>> tasks;
+
+    mStagedContentFiles.clear();
+    mStagedContentFiles.resize(filePaths.size());
+
+    for (std::size_t i = 0; i < filePaths.size(); ++i)
+    {
+        if (filePaths[i].empty())
+            continue;
+
+        boost::system::error_code error;
+        const std::size_t fileSize = static_cast<std::size_t>(boost::filesystem::file_size(filePaths[i], error));
+
+        if (error)
+            continue;
+
+        StagedContentFile &file = mStagedContentFiles[i];
+        file.mPath = filePaths[i];
+        file.mParts.resize(partCount > 0 ? partCount : std::clamp<std::size_t>(fileSize / stagedPartSize, 1, maxThreadCount));
+
+        for (std::size_t part = 0; part < file.mParts.size(); ++part)
+            tasks.emplace_back(&file, part);
+    }
+
+    if (tasks.empty())
+        return;
+
+    std::atomic<std::size_t> nextTask(0);
+    std::size_t finishedTasks = 0;
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < std::min(maxThreadCount, tasks.size()); ++i)
+    {
+        threads.emplace_back([&]
+        {
+            // Encoders keep a buffer for their output, so every thread needs its own
+            std::unique_ptr<ToUTF8::Utf8Encoder> threadEncoder;
+
+            if (encoder)
+                threadEncoder = std::make_unique<ToUTF8::Utf8Encoder>(*encoder);
+
+            for (std::size_t task = nextTask++; task < tasks.size(); task = nextTask++)
+            {
+                stagePart(*tasks[task].first, tasks[task].second, threadEncoder.get());
+
+                std::lock_guard<std::mutex> lock(mutex);
+                finishedTasks++;
+                finishedCondition.notify_one();
+            }
+        });
+    }
+
+    // Keep the loading screen updated while waiting
+    listener->setProgressRange(tasks.size());
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (finishedTasks < tasks.size())
+        {
+            finishedCondition.wait_for(lock, std::chrono::milliseconds(50));
+
+            const std::size_t progress = finishedTasks;
+            lock.unlock();
+            listener->setProgress(progress);
+            lock.lock();
+        }
+    }
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    // Files with a part that couldn't be parsed are parsed in full while loading them instead, which
+    // also reports the error in the usual way
+    for (StagedContentFile &file : mStagedContentFiles)
+    {
+        if (std::any_of(file.mParts.begin(), file.mParts.end(), [] (const StagedPart &part) { return part.mHasFailed; }))
+            file = StagedContentFile();
+    }
+
+    Log(Debug::Info) << "Parsed " << tasks.size() << " parts of content files ahead of time on " << threads.size()
+        << " threads in " << getElapsedMilliseconds(start) << " ms";
 }
 
+void ESMStore::stagePart(StagedContentFile &file, std::size_t part, ToUTF8::Utf8Encoder *encoder) const
+{
+    StagedPart &stagedPart = file.mParts[part];
+
+    try
+    {
+        ESM::ESMReader esm;
+        esm.setEncoder(encoder);
+        esm.setMemoryMapped(true);
+        esm.open(file.mPath);
+
+        std::size_t recordIndex = 0;
+
+        while (esm.hasMoreRecs())
+        {
+            const std::size_t recordPart = getStagedPart(recordIndex++, esm.getRecordCount(), file.mParts.size());
+
+            if (recordPart > part)
+                break;
+
+            ESM::NAME n = esm.getRecName();
+            esm.getRecHeader();
+
+            std::map<int, StoreBase *>::const_iterator it = mStores.find(n.intval);
+
+            if (recordPart < part || it == mStores.end() || !it->second->isStageable())
+            {
+                esm.skipRecord();
+                continue;
+            }
+
+            std::unique_ptr<StagedRecords> &records = stagedPart.mRecords[n.intval];
+
+            if (!records)
+                records = it->second->createStagedRecords();
+
+            it->second->stage(esm, *records);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        Log(Debug::Warning) << "Could not parse " << file.mPath << " ahead of time: " << e.what();
+        stagedPart.mHasFailed = true;
+    }
+}
+
+/*
+    Snapshots are written like content files, so they can be read the same way and inspected with
+    esmtool
+*/
+bool ESMStore::loadSnapshot(const std::string &path, const std::string &engineVersion,
+    const std::vector<ESM::StoreSnapshot::ContentFile> &contentFiles, ToUTF8::Utf8Encoder *encoder)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    boost::system::error_code error;
+
+    if (!boost::filesystem::exists(path, error))
+        return false;
+
+    ESM::StoreSnapshot snapshot;
+    std::map<int, std::pair<std::unique_ptr<StagedRecords>, std::size_t>> stagedRecords;
+
+    try
+    {
+        ESM::ESMReader esm;
+        esm.setEncoder(encoder);
+        esm.setMemoryMapped(true);
+        esm.open(path);
+
+        if (!esm.hasMoreRecs() || esm.getRecName().intval != ESM::StoreSnapshot::sRecordId)
+            esm.fail("Missing snapshot header");
+
+        esm.getRecHeader();
+        snapshot.load(esm);
+
+        if (!snapshot.matches(engineVersion, contentFiles))
+        {
+            Log(Debug::Info) << "Snapshot " << path << " was made from different content files, so they will be loaded in full";
+            return false;
+        }
+
+        // The snapshot has to hold the records of exactly the stores that can be staged
+        for (int type : snapshot.mRecordTypes)
+        {
+            std::map<int, StoreBase *>::const_iterator it = mStores.find(type);
+
+            if (it == mStores.end() || !it->second->isStageable())
+                esm.fail("Unexpected record type in snapshot header");
+
+            stagedRecords[type].first = it->second->createStagedRecords();
+        }
+
+        for (const auto &[type, store] : mStores)
+        {
+            if (store->isStageable() && stagedRecords.find(type) == stagedRecords.end())
+                esm.fail("Missing record type in snapshot header");
+        }
+
+        // Parse every record before adding any of them, so a damaged snapshot leaves the stores as
+        // they were
+        while (esm.hasMoreRecs())
+        {
+            ESM::NAME n = esm.getRecName();
+            esm.getRecHeader();
+
+            auto it = stagedRecords.find(n.intval);
+
+            if (it == stagedRecords.end())
+                esm.fail("Unexpected record in snapshot: " + n.toString());
+
+            mStores[n.intval]->stage(esm, *it->second.first);
+            it->second.second++;
+        }
+    }
+    catch (const std::exception &e)
+    {
+        Log(Debug::Warning) << "Could not load snapshot " << path << ", so the content files will be loaded in full: " << e.what();
+        return false;
+    }
+
+    std::size_t recordCount = 0;
+
+    for (auto &[type, records] : stagedRecords)
+    {
+        StoreBase *store = mStores[type];
+
+        for (std::size_t i = 0; i < records.second; ++i)
+            store->loadStaged(*records.first);
+
+        recordCount += records.second;
+    }
+
+    mRefCount.clear();
+    mRefCount.insert(snapshot.mRefCounts.begin(), snapshot.mRefCounts.end());
+
+    mIsSnapshotLoaded = true;
+
+    Log(Debug::Info) << "Loaded " << recordCount << " records from snapshot " << path << " in "
+        << getElapsedMilliseconds(start) << " ms";
+
+    return true;
+}
+
+void ESMStore::writeSnapshot(const std::string &path, const std::string &engineVersion,
+    const std::vector<ESM::StoreSnapshot::ContentFile> &contentFiles, ToUTF8::Utf8Encoder *encoder)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    // Reference counts only depend on the cells, which are all loaded by now, so they can be
+    // counted early and kept for setUp()
+    mCells.setUp();
+    countRecords();
+
+    ESM::StoreSnapshot snapshot;
+    snapshot.mFormat = ESM::StoreSnapshot::sCurrentFormat;
+    snapshot.mEngineVersion = engineVersion;
+    snapshot.mContentFiles = contentFiles;
+    snapshot.mRefCounts.assign(mRefCount.begin(), mRefCount.end());
+
+    std::size_t recordCount = 0;
+
+    for (const auto &[type, store] : mStores)
+    {
+        if (store->isStageable())
+        {
+            snapshot.mRecordTypes.push_back(type);
+            recordCount += store->getSize();
+        }
+    }
+
+    // Write to a temporary file first, so an interrupted write never leaves a partial snapshot
+    // behind under the final name
+    const boost::filesystem::path finalPath(path);
+    const boost::filesystem::path temporaryPath(path + ".tmp");
+
+    try
+    {
+        boost::filesystem::create_directories(finalPath.parent_path());
+
+        {
+            // ESMWriter seeks back to fill in the size of every record, which would flush a file
+            // stream each time, so the snapshot is put together in memory first
+            std::stringstream buffer(std::ios::in | std::ios::out | std::ios::binary);
+
+            ESM::ESMWriter writer;
+            writer.setEncoder(encoder);
+            writer.setFormat(0);
+            writer.setVersion();
+            writer.setAuthor("tes3mp");
+            writer.setDescription("Snapshot of the records merged from content files");
+            writer.setRecordCount(static_cast<int>(recordCount + 1));
+            writer.save(buffer);
+
+            writer.startRecord(ESM::StoreSnapshot::sRecordId);
+            snapshot.save(writer);
+            writer.endRecord(ESM::StoreSnapshot::sRecordId);
+
+            for (int type : snapshot.mRecordTypes)
+                mStores[type]->writeStatic(writer);
+
+            writer.close();
+
+            boost::filesystem::ofstream stream(temporaryPath, std::ios::binary);
+            stream << buffer.rdbuf();
+
+            if (!stream)
+                throw std::runtime_error("Could not write " + temporaryPath.string());
+        }
+
+        boost::filesystem::rename(temporaryPath, finalPath);
+    }
+    catch (const std::exception &e)
+    {
+        Log(Debug::Warning) << "Could not write snapshot " << path << ": " << e.what();
+
+        boost::system::error_code error;
+        boost::filesystem::remove(temporaryPath, error);
+        return;
+    }
+
+    Log(Debug::Info) << "Wrote " << recordCount << " records to snapshot " << path << " in "
+        << getElapsedMilliseconds(start) << " ms";
+}
+/*
+    End of tes3mp addition
+*/
+
 void ESMStore::setUp(bool validateRecords)
 {
     mIds.clear();
@@ -455,6 +934,13 @@ void ESMStore::validateDynamic()
             throw std::runtime_error ("Invalid player record (race or class unavailable");
     }
 
+    /*
+        Start of tes3mp change (minor)
+
+        Move ESMStore::getSpellList to mwmechanics/spelllist.cpp, so the stores can be linked into
+        the benchmarks without the constructor of SpellList
+    */
+    /*
     std::pair<std::shared_ptr<MWMechanics::SpellList>, bool> ESMStore::getSpellList(const std::string& originalId) const
     {
         const std::string id = Misc::StringUtils::lowerCase(originalId);
@@ -474,4 +960,8 @@ void ESMStore::validateDynamic()
         }
         return {ptr, true};
     }
+    */
+    /*
+        End of tes3mp change (minor)
+    */
 } // end namespace
@@ -7,6 +7,17 @@
 #include <unordered_map>
 
 #include <components/esm/records.hpp>
+
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <components/esm/storesnapshot.hpp>
+/*
+    End of tes3mp addition
+*/
+
 #include "store.hpp"
 
 namespace Loading
@@ -19,6 +30,19 @@ namespace MWMechanics
     class SpellList;
 }
 
+/*
+    Start of tes3mp addition
+
+    Declare additional classes for multiplayer purposes
+*/
+namespace ToUTF8
+{
+    class Utf8Encoder;
+}
+/*
+    End of tes3mp addition
+*/
+
 namespace MWWorld
 {
     class ESMStore
@@ -89,6 +113,35 @@ namespace MWWorld
         void validate();
 
         void countRecords();
+
+        /*
+            Start of tes3mp addition
+
+            The records of each content file that were parsed ahead of time by stage(), with the
+            file split into parts of consecutive records that are each parsed on their own thread
+        */
+        struct StagedPart
+        {
+            std::map<int, std::unique_ptr<StagedRecords>> mRecords;
+            bool mHasFailed = false;
+        };
+
+        struct StagedContentFile
+        {
+            std::string mPath;
+            std::vector<StagedPart> mParts;
+        };
+
+        std::vector<StagedContentFile> mStagedContentFiles;
+
+        void stagePart(StagedContentFile &file, std::size_t part, ToUTF8::Utf8Encoder *encoder) const;
+
+        // Whether the records of stores that can be staged were loaded from a snapshot, in which case
+        // load() skips them in the content files
+        bool mIsSnapshotLoaded = false;
+        /*
+            End of tes3mp addition
+        */
     public:
         /// \todo replace with SharedIterator<StoreBase>
         typedef std::map<int, StoreBase *>::const_iterator iterator;
@@ -185,6 +238,44 @@ namespace MWWorld
 
         void load(ESM::ESMReader &esm, Loading::Listener* listener);
 
+        /*
+            Start of tes3mp addition
+
+            Parse the records of the given content files that don't depend on any other records on
+            worker threads, so load() only has to add them in load order afterwards
+
+            The paths are in load order, with empty ones for files that shouldn't be parsed ahead
+
+            Every file is split into parts based on its size and the number of hardware threads,
+            unless given a number of parts to split every file into, as tests and benchmarks do
+        */
+        void stage(const std::vector<std::string> &filePaths, ToUTF8::Utf8Encoder *encoder, Loading::Listener* listener,
+            std::size_t partCount = 0);
+
+        /*
+            Load the records of every store that can be staged, along with the reference counts, from
+            a snapshot written by writeSnapshot() for the same content files, returning false without
+            changing anything if there is no such snapshot or it can't be read
+
+            Must be called before load(), which then only loads the remaining records from the
+            content files
+        */
+        bool loadSnapshot(const std::string &path, const std::string &engineVersion,
+            const std::vector<ESM::StoreSnapshot::ContentFile> &contentFiles, ToUTF8::Utf8Encoder *encoder);
+
+        /*
+            Write the records of every store that can be staged, along with the reference counts,
+            to a snapshot that later launches with the same content files can load instead
+
+            Must be called right after loading the content files, before any records are added or
+            changed in any other way
+        */
+        void writeSnapshot(const std::string &path, const std::string &engineVersion,
+            const std::vector<ESM::StoreSnapshot::ContentFile> &contentFiles, ToUTF8::Utf8Encoder *encoder);
+        /*
+            End of tes3mp addition
+        */
+
         template <class T>
         const Store<T> &get() const {
             throw std::runtime_error("Storage for this type not exist");
@@ -28,6 +28,31 @@ namespace
             return x->mX < y.first;
         }
     };
+
+    /*
+        Start of tes3mp addition
+
+        Get the flags to write a record with, which only matter for the ones that are loaded with
+        the persistent flag of their record header
+    */
+    template<typename T>
+    uint32_t getRecordFlags(const T &record)
+    {
+        return 0;
+    }
+
+    uint32_t getRecordFlags(const ESM::NPC &record)
+    {
+        return record.mPersistent ? 0x0400 : 0;
+    }
+
+    uint32_t getRecordFlags(const ESM::Creature &record)
+    {
+        return record.mPersistent ? 0x0400 : 0;
+    }
+    /*
+        End of tes3mp addition
+    */
 }
 
 namespace MWWorld
@@ -102,6 +127,17 @@ namespace MWWorld
     Store<T>::Store(const Store<T>& orig)
         : mStatic(orig.mStatic)
     {
+        /*
+            Start of tes3mp addition
+
+            Index the copied records, since the index of the original points to its own ones
+        */
+        mStaticIndex.reserve(mStatic.size());
+        for (auto & [id, record] : mStatic)
+            mStaticIndex.insert(id, &record);
+        /*
+            End of tes3mp addition
+        */
     }
 
     template<typename T>
@@ -111,40 +147,54 @@ namespace MWWorld
         assert(mShared.size() >= mStatic.size());
         mShared.erase(mShared.begin() + mStatic.size(), mShared.end());
         mDynamic.clear();
+
+        /*
+            Start of tes3mp addition
+
+            Keep the index of dynamic records in sync with them
+        */
+        mDynamicIndex.clear();
+        /*
+            End of tes3mp addition
+        */
     }
 
+    /*
+        Start of tes3mp change (major)
+
+        Search the hash indexes instead of the maps, hashing the ID only once for both of them and
+        without building a lowercase copy of it
+    */
     template<typename T>
-    const T *Store<T>::search(const std::string &id) const
+    const T *Store<T>::search(std::string_view id) const
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
+        const std::size_t hash = mStaticIndex.hash(id);
 
-        typename Dynamic::const_iterator dit = mDynamic.find(idLower);
-        if (dit != mDynamic.end())
-            return &dit->second;
+        if (T * const *record = mDynamicIndex.find(id, hash))
+            return *record;
 
-        typename std::map<std::string, T>::const_iterator it = mStatic.find(idLower);
-        if (it != mStatic.end())
-            return &(it->second);
+        if (T * const *record = mStaticIndex.find(id, hash))
+            return *record;
 
         return nullptr;
     }
     template<typename T>
-    const T *Store<T>::searchStatic(const std::string &id) const
+    const T *Store<T>::searchStatic(std::string_view id) const
     {
-        std::string idLower = Misc::StringUtils::lowerCase(id);
-        typename std::map<std::string, T>::const_iterator it = mStatic.find(idLower);
-        if (it != mStatic.end())
-            return &(it->second);
+        if (T * const *record = mStaticIndex.find(id))
+            return *record;
 
         return nullptr;
     }
 
     template<typename T>
-    bool Store<T>::isDynamic(const std::string &id) const
+    bool Store<T>::isDynamic(std::string_view id) const
     {
-        typename Dynamic::const_iterator dit = mDynamic.find(id);
-        return (dit != mDynamic.end());
+        return mDynamicIndex.find(id) != nullptr;
     }
+    /*
+        End of tes3mp change (major)
+    */
     template<typename T>
     const T *Store<T>::searchRandom(const std::string &id) const
     {
@@ -158,13 +208,21 @@ namespace MWWorld
             return results[Misc::Rng::rollDice(results.size())];
         return nullptr;
     }
+    /*
+        Start of tes3mp change (minor)
+
+        Take a string view, so IDs can be searched for without building a string for them first
+    */
     template<typename T>
-    const T *Store<T>::find(const std::string &id) const
+    const T *Store<T>::find(std::string_view id) const
+    /*
+        End of tes3mp change (minor)
+    */
     {
         const T *ptr = search(id);
         if (ptr == nullptr)
         {
-            const std::string msg = T::getRecordType() + " '" + id + "' not found";
+            const std::string msg = T::getRecordType() + " '" + std::string(id) + "' not found";
             throw std::runtime_error(msg);
         }
         return ptr;
@@ -180,10 +238,80 @@ namespace MWWorld
 
         std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(record.mId, record);
         if (inserted.second)
+        {
             mShared.push_back(&inserted.first->second);
 
+            /*
+                Start of tes3mp addition
+
+                Index new records, which keep their map nodes and thereby their IDs when replaced later
+            */
+            mStaticIndex.insert(inserted.first->first, &inserted.first->second);
+            /*
+                End of tes3mp addition
+            */
+        }
+
         return RecordId(record.mId, isDeleted);
     }
+
+    /*
+        Start of tes3mp addition
+
+        Make it possible to parse records ahead of loading them
+    */
+    template<typename T>
+    bool Store<T>::isStageable() const
+    {
+        return true;
+    }
+    template<typename T>
+    std::unique_ptr<StagedRecords> Store<T>::createStagedRecords() const
+    {
+        return std::make_unique<Staged>();
+    }
+    template<typename T>
+    void Store<T>::stage(ESM::ESMReader &esm, StagedRecords &staged) const
+    {
+        T record;
+        bool isDeleted = false;
+
+        record.load(esm, isDeleted);
+        Misc::StringUtils::lowerCaseInPlace(record.mId);
+
+        static_cast<Staged &>(staged).mRecords.emplace_back(std::move(record), isDeleted);
+    }
+    template<typename T>
+    RecordId Store<T>::loadStaged(StagedRecords &staged)
+    {
+        Staged &records = static_cast<Staged &>(staged);
+        std::pair<T, bool> &record = records.mRecords[records.mNext++];
+        RecordId id(record.first.mId, record.second);
+
+        std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(id.mId, std::move(record.first));
+        if (inserted.second)
+        {
+            mShared.push_back(&inserted.first->second);
+            mStaticIndex.insert(inserted.first->first, &inserted.first->second);
+        }
+
+        return id;
+    }
+    template<typename T>
+    void Store<T>::writeStatic(ESM::ESMWriter &writer) const
+    {
+        // Records added during play come after the ones loaded from content files
+        for (std::size_t i = 0; i < mStatic.size() && i < mShared.size(); ++i)
+        {
+            writer.startRecord(T::sRecordId, getRecordFlags(*mShared[i]));
+            mShared[i]->save(writer);
+            writer.endRecord(T::sRecordId);
+        }
+    }
+    /*
+        End of tes3mp addition
+    */
+
     template<typename T>
     void Store<T>::setUp()
     {
@@ -233,7 +361,19 @@ namespace MWWorld
         std::pair<typename Dynamic::iterator, bool> result = mDynamic.insert_or_assign(id, item);
         T *ptr = &result.first->second;
         if (result.second)
+        {
             mShared.push_back(ptr);
+
+            /*
+                Start of tes3mp addition
+
+                Keep the index of dynamic records in sync with them
+            */
+            mDynamicIndex.insert(result.first->first, ptr);
+            /*
+                End of tes3mp addition
+            */
+        }
         return ptr;
     }
     template<typename T>
@@ -243,7 +383,19 @@ namespace MWWorld
         std::pair<typename Static::iterator, bool> result = mStatic.insert_or_assign(id, item);
         T *ptr = &result.first->second;
         if (result.second)
+        {
             mShared.push_back(ptr);
+
+            /*
+                Start of tes3mp addition
+
+                Keep the index of static records in sync with them
+            */
+            mStaticIndex.insert(result.first->first, ptr);
+            /*
+                End of tes3mp addition
+            */
+        }
         return ptr;
     }
     template<typename T>
@@ -265,6 +417,17 @@ namespace MWWorld
                 }
                 ++sharedIter;
             }
+
+            /*
+                Start of tes3mp addition
+
+                Keep the index of static records in sync with them
+            */
+            mStaticIndex.erase(it->first);
+            /*
+                End of tes3mp addition
+            */
+
             mStatic.erase(it);
         }
 
@@ -279,6 +442,17 @@ namespace MWWorld
         if (it == mDynamic.end()) {
             return false;
         }
+
+        /*
+            Start of tes3mp addition
+
+            Keep the index of dynamic records in sync with them
+        */
+        mDynamicIndex.erase(it->first);
+        /*
+            End of tes3mp addition
+        */
+
         mDynamic.erase(it);
 
         // have to reinit the whole shared part
@@ -1134,7 +1308,17 @@ namespace MWWorld
         if (found == mStatic.end())
         {
             dialogue.loadData(esm, isDeleted);
-            mStatic.insert(std::make_pair(idLower, dialogue));
+
+            /*
+                Start of tes3mp change (minor)
+
+                Index new dialogue records like the records of other stores
+            */
+            std::map<std::string, ESM::Dialogue>::iterator inserted = mStatic.insert(std::make_pair(idLower, dialogue)).first;
+            mStaticIndex.insert(inserted->first, &inserted->second);
+            /*
+                End of tes3mp change (minor)
+            */
         }
         else
         {
@@ -1145,13 +1329,40 @@ namespace MWWorld
         return RecordId(dialogue.mId, isDeleted);
     }
 
+    /*
+        Start of tes3mp addition
+
+        Dialogue records are merged with the ones before them and followed by their info records,
+        so they can't be parsed ahead of time
+    */
+    template<>
+    bool Store<ESM::Dialogue>::isStageable() const
+    {
+        return false;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     template<>
     bool Store<ESM::Dialogue>::eraseStatic(const std::string &id)
     {
         auto it = mStatic.find(Misc::StringUtils::lowerCase(id));
 
         if (it != mStatic.end())
+        {
+            /*
+                Start of tes3mp addition
+
+                Keep the index of static records in sync with them
+            */
+            mStaticIndex.erase(it->first);
+            /*
+                End of tes3mp addition
+            */
+
             mStatic.erase(it);
+        }
 
         return true;
     }
@@ -5,6 +5,20 @@
 #include <vector>
 #include <map>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <memory>
+#include <string_view>
+
+#include <components/misc/stringops.hpp>
+#include <components/misc/hashindex.hpp>
+/*
+    End of tes3mp addition
+*/
+
 #include "recordcmp.hpp"
 
 namespace ESM
@@ -27,6 +41,20 @@ namespace MWWorld
         RecordId(const std::string &id = "", bool isDeleted = false);
     };
 
+    /*
+        Start of tes3mp addition
+
+        Records parsed by a store ahead of loading them, kept in the order they were read in
+    */
+    class StagedRecords
+    {
+    public:
+        virtual ~StagedRecords() {}
+    };
+    /*
+        End of tes3mp addition
+    */
+
     class StoreBase
     {
     public:
@@ -48,6 +76,25 @@ namespace MWWorld
 
         virtual RecordId read (ESM::ESMReader& reader, bool overrideOnly = false) { return RecordId(); }
         ///< Read into dynamic storage
+
+        /*
+            Start of tes3mp addition
+
+            Records that don't depend on any other records while being loaded can be parsed ahead of
+            time on another thread with stage(), and then added in load order with loadStaged(), which
+            has the same effect load() would have had at that point
+        */
+        virtual bool isStageable() const { return false; }
+        virtual std::unique_ptr<StagedRecords> createStagedRecords() const { return nullptr; }
+        virtual void stage(ESM::ESMReader &esm, StagedRecords &staged) const {}
+        virtual RecordId loadStaged(StagedRecords &staged) { return RecordId(); }
+
+        // Write the records loaded from content files in the order they were loaded in, so that
+        // loading them again has the same effect as loading the content files did
+        virtual void writeStatic(ESM::ESMWriter &writer) const {}
+        /*
+            End of tes3mp addition
+        */
     };
 
     template <class T>
@@ -154,6 +201,33 @@ namespace MWWorld
         typedef std::map<std::string, T> Dynamic;
         typedef std::map<std::string, T> Static;
 
+        /*
+            Start of tes3mp addition
+
+            Hash indexes of the records in mStatic and mDynamic, so searching for an ID doesn't need
+            a lowercase copy of it or two walks down the maps
+        */
+        typedef Misc::HashIndex<T *, Misc::StringUtils::CiHash, Misc::StringUtils::CiEqual> Index;
+        Index mStaticIndex;
+        Index mDynamicIndex;
+        /*
+            End of tes3mp addition
+        */
+
+        /*
+            Start of tes3mp addition
+
+            Records parsed ahead of time along with whether they were deleted, and the next one to load
+        */
+        struct Staged : public StagedRecords
+        {
+            std::vector<std::pair<T, bool>> mRecords;
+            std::size_t mNext = 0;
+        };
+        /*
+            End of tes3mp addition
+        */
+
         friend class ESMStore;
 
     public:
@@ -166,18 +240,36 @@ namespace MWWorld
         void clearDynamic() override;
         void setUp() override;
 
-        const T *search(const std::string &id) const;
-        const T *searchStatic(const std::string &id) const;
+        /*
+            Start of tes3mp change (minor)
+
+            Take string views, so IDs can be searched for case-insensitively without building a
+            string for them first
+        */
+        const T *search(std::string_view id) const;
+        const T *searchStatic(std::string_view id) const;
 
         /**
          * Does the record with this ID come from the dynamic store?
          */
-        bool isDynamic(const std::string &id) const;
+        bool isDynamic(std::string_view id) const;
+        /*
+            End of tes3mp change (minor)
+        */
 
         /** Returns a random record that starts with the named ID, or nullptr if not found. */
         const T *searchRandom(const std::string &id) const;
 
-        const T *find(const std::string &id) const;
+        /*
+            Start of tes3mp change (minor)
+
+            Take string views, so IDs can be searched for case-insensitively without building a
+            string for them first
+        */
+        const T *find(std::string_view id) const;
+        /*
+            End of tes3mp change (minor)
+        */
 
         iterator begin() const;
         iterator end() const;
@@ -198,6 +290,20 @@ namespace MWWorld
         RecordId load(ESM::ESMReader &esm) override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
         RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) override;
+
+        /*
+            Start of tes3mp addition
+
+            Make it possible to parse records ahead of loading them
+        */
+        bool isStageable() const override;
+        std::unique_ptr<StagedRecords> createStagedRecords() const override;
+        void stage(ESM::ESMReader &esm, StagedRecords &staged) const override;
+        RecordId loadStaged(StagedRecords &staged) override;
+        void writeStatic(ESM::ESMWriter &writer) const override;
+        /*
+            End of tes3mp addition
+        */
     };
 
     template <>
@@ -14,7 +14,12 @@
 
     Include additional headers for multiplayer purposes
 */
+#include <chrono>
+#include <components/esm/storesnapshot.hpp>
+#include <components/openmw-mp/ContentCache.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
+#include <components/openmw-mp/Utils.hpp>
+#include <components/openmw-mp/Version.hpp>
 #include "../mwmp/Main.hpp"
 #include "../mwmp/Networking.hpp"
 #include "../mwmp/LocalPlayer.hpp"
@@ -26,6 +31,7 @@
 #include "../mwmp/RecordHelper.hpp"
 #include "../mwmp/CellController.hpp"
 #include "../mwmp/MechanicsHelper.hpp"
+#include "../mwmp/ContainerEditQueue.hpp"
 /*
     End of tes3mp addition
 */
@@ -110,6 +116,62 @@ void wrap(float& rad)
         rad = std::fmod(rad-pi, 2.0f*pi)+pi;
 }
 
+/*
+    Start of tes3mp addition
+
+    Get the content files a snapshot of the merged records has to be made from to be usable, using
+    the checksums already sent to the server for the content files, or nothing if there are none
+*/
+std::vector<ESM::StoreSnapshot::ContentFile> getSnapshotContentFiles(const Files::Collections& fileCollections,
+    const std::vector<std::string>& contentFiles, const std::vector<std::string>& groundcoverFiles)
+{
+    std::vector<ESM::StoreSnapshot::ContentFile> snapshotContentFiles;
+
+    for (const auto &checksums : mwmp::Main::get().getNetworking()->getContentChecksums())
+    {
+        if (checksums.second.empty())
+            return {};
+
+        snapshotContentFiles.push_back({checksums.first, checksums.second.front()});
+    }
+
+    if (snapshotContentFiles.empty() || snapshotContentFiles.size() != contentFiles.size())
+        return {};
+
+    // Groundcover files aren't sent to the server
+    for (const std::string &file : groundcoverFiles)
+    {
+        const Files::MultiDirCollection& col = fileCollections.getCollection(boost::filesystem::path(file).extension().string());
+
+        if (!col.doesExist(file))
+            return {};
+
+        snapshotContentFiles.push_back({file, Utils::crc32Checksum(col.getPath(file).string())});
+    }
+
+    return snapshotContentFiles;
+}
+
+// Snapshots are kept under a hash of the content files they were made from, so switching between
+// servers with different content files doesn't keep replacing them
+std::string getSnapshotPath(const std::vector<ESM::StoreSnapshot::ContentFile> &contentFiles)
+{
+    std::string key;
+
+    for (const ESM::StoreSnapshot::ContentFile &file : contentFiles)
+        key += file.mName + '\0' + std::to_string(file.mChecksum) + '\0';
+
+    return mwmp::ContentCache("esmstore").getPath(Utils::hashBytes(key.data(), key.size()));
+}
+
+std::string getSnapshotEngineVersion()
+{
+    return std::string(TES3MP_VERSION) + "." + std::to_string(TES3MP_PROTO_VERSION);
+}
+/*
+    End of tes3mp addition
+*/
+
 }
 
 namespace MWWorld
@@ -126,6 +188,19 @@ namespace MWWorld
             return mLoaders.insert(std::make_pair(extension, loader)).second;
         }
 
+        /*
+            Start of tes3mp addition
+
+            Make it possible to check whether a file can be loaded ahead of loading it
+        */
+        bool hasLoader(const std::string& extension) const
+        {
+            return mLoaders.find(Misc::StringUtils::lowerCase(extension)) != mLoaders.end();
+        }
+        /*
+            End of tes3mp addition
+        */
+
         void load(const boost::filesystem::path& filepath, int& index) override
         {
             LoadersContainer::iterator it(mLoaders.find(Misc::StringUtils::lowerCase(filepath.extension().string())));
@@ -189,8 +264,64 @@ namespace MWWorld
         gameContentLoader.addLoader(".omwaddon", &esmLoader);
         gameContentLoader.addLoader(".project", &esmLoader);
 
+        /*
+            Start of tes3mp addition
+
+            Load the records of the content files that don't depend on other records from a snapshot
+            made on an earlier launch with the same content files if there is one, or otherwise parse
+            them on worker threads first, so loading the files one at a time below only has to add
+            them in order
+        */
+        const auto loadStart = std::chrono::steady_clock::now();
+        const std::vector<ESM::StoreSnapshot::ContentFile> snapshotContentFiles = getSnapshotContentFiles(fileCollections,
+            contentFiles, groundcoverFiles);
+        const std::string snapshotPath = snapshotContentFiles.empty() ? "" : getSnapshotPath(snapshotContentFiles);
+        const bool hasSnapshot = !snapshotPath.empty() && mStore.loadSnapshot(snapshotPath, getSnapshotEngineVersion(),
+            snapshotContentFiles, encoder);
+
+        if (!hasSnapshot)
+        {
+            std::vector<std::string> contentFilePaths;
+
+            for (const std::vector<std::string> *files : { &contentFiles, &groundcoverFiles })
+            {
+                for (const std::string &file : *files)
+                {
+                    const boost::filesystem::path filename(file);
+                    const Files::MultiDirCollection& col = fileCollections.getCollection(filename.extension().string());
+
+                    // Anything that isn't an existing content file is reported while loading it below
+                    if (col.doesExist(file) && gameContentLoader.hasLoader(filename.extension().string()))
+                        contentFilePaths.push_back(col.getPath(file).string());
+                    else
+                        contentFilePaths.emplace_back();
+                }
+            }
+
+            mStore.stage(contentFilePaths, encoder, listener);
+        }
+        /*
+            End of tes3mp addition
+        */
+
         loadContentFiles(fileCollections, contentFiles, groundcoverFiles, gameContentLoader);
 
+        /*
+            Start of tes3mp addition
+
+            Report how long loading the content files took with or without a snapshot, and write one
+            for later launches if there wasn't a usable one
+        */
+        Log(Debug::Info) << "Loaded content files in "
+            << std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count()
+            << " ms " << (hasSnapshot ? "with" : "without") << " a snapshot";
+
+        if (!hasSnapshot && !snapshotPath.empty())
+            mStore.writeSnapshot(snapshotPath, getSnapshotEngineVersion(), snapshotContentFiles, encoder);
+        /*
+            End of tes3mp addition
+        */
+
         listener->loadingOff();
 
         // insert records that may not be present in all versions of MW
@@ -877,11 +1008,13 @@ namespace MWWorld
                     deleteObject(ptr);
                     ptr.getCellRef().unsetRefNum();
                     ptr.getCellRef().setMpNum(0);
+                    cellStore->updateRefNumIndex(ptr);
 
                     MWWorld::ManualRef* reference = new MWWorld::ManualRef(getStore(), refId, 1);
                     MWWorld::Ptr newPtr = placeObject(reference->getPtr(), cellStore, *position);
                     newPtr.getCellRef().setRefNum(refNum);
                     newPtr.getCellRef().setMpNum(mpNum);
+                    newPtr.getCell()->updateRefNumIndex(newPtr);
 
                     // Update Ptrs for LocalActors and DedicatedActors
                     if (newPtr.getClass().isActor())
@@ -4370,6 +4503,17 @@ namespace MWWorld
     {
         breakInvisibility(actor);
 
+        /*
+            Start of tes3mp addition
+
+            Finish applying the contents received for a container before it can be opened or harvested
+        */
+        if (object.getClass().hasContainerStore(object))
+            mwmp::Main::get().getContainerEditQueue()->applyFor(object);
+        /*
+            End of tes3mp addition
+        */
+
         if (object.getRefData().activate())
         {
             std::shared_ptr<MWWorld::Action> action = (object.getClass().activate(object, actor));
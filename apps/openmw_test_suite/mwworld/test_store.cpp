@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #include <components/files/configurationmanager.hpp>
 #include <components/files/escape.hpp>
@@ -318,3 +319,261 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE (overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+template <typename T>
+void writeRecord(ESM::ESMWriter& writer, const std::string& id, const std::string& model, bool deleted)
+{
+    T record;
+    record.blank();
+    record.mId = id;
+    record.mModel = model;
+
+    writer.startRecord(T::sRecordId);
+    record.save(writer, deleted);
+    writer.endRecord(T::sRecordId);
+}
+
+template <typename T>
+void compareRecords(const MWWorld::ESMStore& esmStore, const MWWorld::ESMStore& otherStore)
+{
+    const MWWorld::Store<T>& store = esmStore.get<T>();
+    const MWWorld::Store<T>& other = otherStore.get<T>();
+
+    ASSERT_EQ (other.getSize(), store.getSize());
+
+    for (auto it = store.begin(), otherIt = other.begin(); it != store.end(); ++it, ++otherIt)
+    {
+        ASSERT_EQ (otherIt->mId, it->mId);
+        ASSERT_EQ (otherIt->mModel, it->mModel);
+    }
+}
+
+/// Tests loading content files parsed ahead of time, with every file split into several parts,
+/// against loading them in full.
+TEST_F(StoreTest, stage_test)
+{
+    const boost::filesystem::path directory = boost::filesystem::temp_directory_path()
+        / boost::filesystem::unique_path("openmw-stage-%%%%-%%%%-%%%%");
+    boost::filesystem::create_directories(directory);
+
+    const std::vector<std::string> paths = {(directory / "master.esm").string(), (directory / "plugin.esp").string()};
+    const int masterRecordCount = 900;
+
+    for (std::size_t file = 0; file < paths.size(); ++file)
+    {
+        // the plugin changes every seventh record of the master, deletes every eleventh one that
+        // isn't a cell and adds records of its own
+        std::vector<int> indexes;
+
+        for (int i = 0; i < masterRecordCount + 100; ++i)
+        {
+            if (file == 0 ? i < masterRecordCount : (i % 7 == 0 || i % 11 == 0 || i >= masterRecordCount))
+                indexes.push_back(i);
+        }
+
+        boost::filesystem::ofstream stream(paths[file], std::ios::binary);
+        ESM::ESMWriter writer;
+        writer.setFormat(0);
+        writer.setRecordCount(static_cast<int>(indexes.size()));
+        writer.save(stream);
+
+        for (int i : indexes)
+        {
+            const std::string id = "Record_" + std::to_string(i);
+            const std::string model = file == 0 ? id + ".nif" : id + "_changed.nif";
+            const bool deleted = file == 1 && i % 11 == 0 && i < masterRecordCount;
+
+            switch (i % 3)
+            {
+                case 0:
+                    writeRecord<ESM::Apparatus>(writer, id, model, deleted);
+                    break;
+                case 1:
+                    writeRecord<ESM::Miscellaneous>(writer, id, model, deleted);
+                    break;
+                default:
+                {
+                    // cells are never parsed ahead of time, so they are loaded in between
+                    ESM::Cell cell;
+                    cell.blank();
+                    cell.mName = id;
+                    cell.mData.mFlags = ESM::Cell::Interior;
+
+                    writer.startRecord(ESM::Cell::sRecordId);
+                    cell.save(writer);
+                    writer.endRecord(ESM::Cell::sRecordId);
+                    break;
+                }
+            }
+        }
+
+        writer.close();
+    }
+
+    const auto load = [&] (MWWorld::ESMStore& store, bool staged)
+    {
+        if (staged)
+            store.stage(paths, nullptr, &dummyListener, 4);
+
+        std::vector<ESM::ESMReader> readers(paths.size());
+
+        for (std::size_t i = 0; i < paths.size(); ++i)
+        {
+            readers[i].setIndex(static_cast<int>(i));
+            readers[i].setGlobalReaderList(&readers);
+            readers[i].open(paths[i]);
+            store.load(readers[i], &dummyListener);
+        }
+
+        store.setUp();
+    };
+
+    MWWorld::ESMStore stagedStore;
+    load(mEsmStore, false);
+    load(stagedStore, true);
+
+    compareRecords<ESM::Apparatus>(mEsmStore, stagedStore);
+    compareRecords<ESM::Miscellaneous>(mEsmStore, stagedStore);
+    ASSERT_EQ (stagedStore.get<ESM::Cell>().getSize(), mEsmStore.get<ESM::Cell>().getSize());
+
+    const MWWorld::Store<ESM::Apparatus>& apparatus = stagedStore.get<ESM::Apparatus>();
+    const MWWorld::Store<ESM::Miscellaneous>& miscellaneous = stagedStore.get<ESM::Miscellaneous>();
+
+    ASSERT_EQ (apparatus.search("record_3")->mModel, "Record_3.nif");
+    ASSERT_EQ (miscellaneous.search("record_7")->mModel, "Record_7_changed.nif");
+    ASSERT_TRUE (apparatus.search("record_33") == nullptr);
+    ASSERT_TRUE (miscellaneous.search("record_22") == nullptr);
+    ASSERT_EQ (apparatus.search("record_999")->mModel, "Record_999_changed.nif");
+
+    boost::system::error_code error;
+    boost::filesystem::remove_all(directory, error);
+}
+
+
+/// Tests loading the records merged from content files from a snapshot of them.
+TEST_F(StoreTest, snapshot_test)
+{
+    typedef ESM::Apparatus RecordType;
+
+    const std::vector<ESM::StoreSnapshot::ContentFile> contentFiles = {{"master.esm", 1}, {"plugin.esp", 2}};
+    const boost::filesystem::path path = boost::filesystem::temp_directory_path()
+        / boost::filesystem::unique_path("openmw-snapshot-%%%%-%%%%-%%%%");
+
+    RecordType first;
+    first.blank();
+    first.mId = "First";
+    first.mModel = "first_model";
+
+    RecordType second = first;
+    second.mId = "second";
+    second.mModel = "second_model";
+
+    RecordType third = first;
+    third.mId = "third";
+    third.mModel = "third_model";
+
+    ESM::ESMReader reader;
+    std::vector<ESM::ESMReader> readerList;
+    readerList.push_back(reader);
+    reader.setGlobalReaderList(&readerList);
+
+    // the master file inserts three records, after which a plugin deletes one and changes another
+    for (const auto& [record, deleted] : std::vector<std::pair<RecordType, bool>>{{first, false}, {second, false},
+        {third, false}, {second, true}, {first, false}})
+    {
+        Files::IStreamPtr file = getEsmFile(record, deleted);
+        reader.open(file, "filename");
+        mEsmStore.load(reader, &dummyListener);
+    }
+
+    mEsmStore.writeSnapshot(path.string(), "version", contentFiles, nullptr);
+
+    // a snapshot is only used for the same content files and engine version
+    MWWorld::ESMStore otherStore;
+    ASSERT_FALSE (otherStore.loadSnapshot(path.string(), "other version", contentFiles, nullptr));
+    ASSERT_FALSE (otherStore.loadSnapshot(path.string(), "version", {contentFiles[0]}, nullptr));
+    ASSERT_FALSE (otherStore.loadSnapshot((path.string() + "missing"), "version", contentFiles, nullptr));
+    ASSERT_TRUE (otherStore.get<RecordType>().getSize() == 0);
+
+    MWWorld::ESMStore snapshotStore;
+    ASSERT_TRUE (snapshotStore.loadSnapshot(path.string(), "version", contentFiles, nullptr));
+
+    // the records of the snapshot are skipped when loading the content files afterwards
+    Files::IStreamPtr file = getEsmFile(second, false);
+    reader.open(file, "filename");
+    snapshotStore.load(reader, &dummyListener);
+
+    mEsmStore.setUp();
+    snapshotStore.setUp();
+
+    const MWWorld::Store<RecordType>& store = mEsmStore.get<RecordType>();
+    const MWWorld::Store<RecordType>& snapshot = snapshotStore.get<RecordType>();
+
+    ASSERT_EQ (snapshot.getSize(), 2u);
+    ASSERT_EQ (snapshot.getSize(), store.getSize());
+
+    for (auto it = store.begin(), snapshotIt = snapshot.begin(); it != store.end(); ++it, ++snapshotIt)
+    {
+        ASSERT_EQ (snapshotIt->mId, it->mId);
+        ASSERT_EQ (snapshotIt->mModel, it->mModel);
+    }
+
+    ASSERT_TRUE (snapshot.search("second") == nullptr);
+
+    boost::filesystem::remove(path);
+}
+
+/// Tests searching for records by IDs in any letter case while they're added and removed.
+TEST_F(StoreTest, search_test)
+{
+    typedef ESM::Apparatus RecordType;
+
+    MWWorld::Store<RecordType> store;
+
+    RecordType record;
+    record.blank();
+
+    // enough records to grow the index a few times
+    for (int i = 0; i < 1000; ++i)
+    {
+        record.mId = "Static_" + std::to_string(i);
+        store.insertStatic(record);
+    }
+
+    record.mId = "Dynamic";
+    record.mModel = "dynamic_model";
+    store.insert(record);
+
+    // dynamic records take precedence over static ones with the same ID
+    record.mId = "STATIC_7";
+    store.insert(record);
+
+    ASSERT_EQ (store.getSize(), 1002u);
+    ASSERT_TRUE (store.search("static_500") != nullptr);
+    ASSERT_EQ (store.search(std::string_view("sTaTiC_999"))->mId, "Static_999");
+    ASSERT_TRUE (store.search("static_1000") == nullptr);
+    ASSERT_EQ (store.search("static_7")->mModel, "dynamic_model");
+    ASSERT_EQ (store.searchStatic("static_7")->mModel, "");
+    ASSERT_TRUE (store.isDynamic("DYNAMIC"));
+    ASSERT_FALSE (store.isDynamic("static_1"));
+    ASSERT_THROW (store.find("missing"), std::runtime_error);
+
+    // copies search their own records
+    const MWWorld::Store<RecordType> copy(store);
+    ASSERT_TRUE (copy.searchStatic("static_1") != nullptr);
+    ASSERT_TRUE (copy.searchStatic("static_1") != store.searchStatic("static_1"));
+
+    for (int i = 0; i < 1000; i += 2)
+        store.eraseStatic("STATIC_" + std::to_string(i));
+
+    for (int i = 0; i < 1000; ++i)
+        ASSERT_EQ (store.searchStatic("static_" + std::to_string(i)) != nullptr, i % 2 == 1);
+
+    ASSERT_TRUE (store.erase("static_7"));
+    ASSERT_TRUE (store.search("static_7") != nullptr);
+    ASSERT_EQ (store.search("static_7")->mModel, "");
+
+    store.clearDynamic();
+    ASSERT_TRUE (store.search("dynamic") == nullptr);
+    ASSERT_EQ (store.getSize(), 500u);
+}
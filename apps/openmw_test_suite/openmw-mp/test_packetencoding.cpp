@@ -0,0 +1,289 @@
+#include <gtest/gtest.h>
+
+#include <components/openmw-mp/Packets/PacketEncoding.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+    using namespace mwmp::PacketEncoding;
+
+    // A random value whose magnitude is also random, since packet fields are mostly small but the
+    // encodings have to hold anything
+    uint32_t randomUnsigned(std::mt19937 &random)
+    {
+        const unsigned int bits = std::uniform_int_distribution<unsigned int>(0, 32)(random);
+
+        if (bits == 0)
+            return 0;
+
+        return random() >> (32 - bits);
+    }
+
+    int32_t randomSigned(std::mt19937 &random)
+    {
+        const int32_t value = (int32_t) (randomUnsigned(random) >> 1);
+        return random() % 2 == 0 ? value : -value - 1;
+    }
+
+    struct PacketEncodingTest : ::testing::Test
+    {
+        RakNet::BitStream bs;
+        std::mt19937 random{42};
+    };
+
+    TEST_F(PacketEncodingTest, varint_round_trips_boundaries)
+    {
+        const std::vector<uint32_t> values = {0, 1, 127, 128, 16383, 16384, 2097151, 2097152,
+            std::numeric_limits<uint32_t>::max()};
+
+        for (uint32_t value : values)
+            writeVarint(&bs, value);
+
+        for (uint32_t value : values)
+        {
+            uint32_t result;
+            ASSERT_TRUE(readVarint(&bs, result));
+            EXPECT_EQ(result, value);
+        }
+    }
+
+    TEST_F(PacketEncodingTest, varint_size_grows_seven_bits_at_a_time)
+    {
+        writeVarint<uint32_t>(&bs, 127);
+        EXPECT_EQ(bs.GetNumberOfBitsUsed(), 8u);
+
+        writeVarint<uint32_t>(&bs, 128);
+        EXPECT_EQ(bs.GetNumberOfBitsUsed(), 24u);
+
+        writeVarint(&bs, std::numeric_limits<uint32_t>::max());
+        EXPECT_EQ(bs.GetNumberOfBitsUsed(), 64u);
+    }
+
+    TEST_F(PacketEncodingTest, varint_round_trips_other_widths)
+    {
+        writeVarint<uint8_t>(&bs, 255);
+        writeVarint<uint16_t>(&bs, 65535);
+        writeVarint(&bs, std::numeric_limits<uint64_t>::max());
+
+        uint8_t byte;
+        uint16_t word;
+        uint64_t quad;
+
+        ASSERT_TRUE(readVarint(&bs, byte));
+        ASSERT_TRUE(readVarint(&bs, word));
+        ASSERT_TRUE(readVarint(&bs, quad));
+        EXPECT_EQ(byte, 255);
+        EXPECT_EQ(word, 65535);
+        EXPECT_EQ(quad, std::numeric_limits<uint64_t>::max());
+    }
+
+    TEST_F(PacketEncodingTest, varint_read_fails_on_truncated_or_overlong_input)
+    {
+        uint32_t result;
+
+        bs.Write((uint8_t) 0x80);
+        EXPECT_FALSE(readVarint(&bs, result));
+
+        RakNet::BitStream overlong;
+
+        for (int i = 0; i < 6; ++i)
+            overlong.Write((uint8_t) 0xFF);
+
+        EXPECT_FALSE(readVarint(&overlong, result));
+    }
+
+    TEST_F(PacketEncodingTest, zigzag_round_trips_and_keeps_small_negatives_small)
+    {
+        const std::vector<int32_t> values = {0, -1, 1, -64, 63, -65, 64, std::numeric_limits<int32_t>::min(),
+            std::numeric_limits<int32_t>::max()};
+
+        for (int32_t value : values)
+            EXPECT_EQ(zigZagDecode<int32_t>(zigZagEncode(value)), value);
+
+        EXPECT_EQ(zigZagEncode<int32_t>(-1), 1u);
+        EXPECT_EQ(zigZagEncode<int32_t>(1), 2u);
+
+        writeVarint(&bs, zigZagEncode<int32_t>(-1));
+        EXPECT_EQ(bs.GetNumberOfBitsUsed(), 8u);
+    }
+
+    TEST_F(PacketEncodingTest, zigzag_round_trips_small_types)
+    {
+        for (int value = std::numeric_limits<int8_t>::min(); value <= std::numeric_limits<int8_t>::max(); ++value)
+            EXPECT_EQ(zigZagDecode<int8_t>(zigZagEncode((int8_t) value)), value);
+    }
+
+    TEST_F(PacketEncodingTest, bits_round_trip_and_take_up_exactly_their_width)
+    {
+        for (unsigned int bits = 1; bits <= 32; ++bits)
+        {
+            RakNet::BitStream stream;
+            const uint32_t value = bits == 32 ? random() : random() & ((1u << bits) - 1);
+
+            writeBits(&stream, value, bits);
+            EXPECT_EQ(stream.GetNumberOfBitsUsed(), bits);
+
+            uint32_t result;
+            ASSERT_TRUE(readBits(&stream, result, bits));
+            EXPECT_EQ(result, value);
+        }
+    }
+
+    TEST_F(PacketEncodingTest, quantized_round_trips_within_half_a_step)
+    {
+        const unsigned int bits = 12;
+        const float min = -100;
+        const float max = 300;
+        const float tolerance = (max - min) / ((1 << bits) - 1) / 2 + 1e-4f;
+
+        std::uniform_real_distribution<float> distribution(min, max);
+        std::vector<float> values = {min, max};
+
+        for (int i = 0; i < 1000; ++i)
+            values.push_back(distribution(random));
+
+        for (float value : values)
+            writeQuantized(&bs, value, min, max, bits);
+
+        EXPECT_EQ(bs.GetNumberOfBitsUsed(), values.size() * bits);
+
+        for (float value : values)
+        {
+            float result;
+            ASSERT_TRUE(readQuantized(&bs, result, min, max, bits));
+            EXPECT_NEAR(result, value, tolerance);
+        }
+    }
+
+    TEST_F(PacketEncodingTest, quantized_clamps_values_outside_of_the_range)
+    {
+        writeQuantized(&bs, -5, 0, 1, 8);
+        writeQuantized(&bs, 5, 0, 1, 8);
+        writeQuantized(&bs, std::numeric_limits<float>::quiet_NaN(), 0, 1, 8);
+
+        float result;
+        ASSERT_TRUE(readQuantized(&bs, result, 0, 1, 8));
+        EXPECT_EQ(result, 0);
+        ASSERT_TRUE(readQuantized(&bs, result, 0, 1, 8));
+        EXPECT_EQ(result, 1);
+        ASSERT_TRUE(readQuantized(&bs, result, 0, 1, 8));
+        EXPECT_EQ(result, 0);
+    }
+
+    // Write a long random mix of every encoding next to full width fields, as packets do, and make
+    // sure they all read back in sync
+    TEST_F(PacketEncodingTest, random_mixed_fields_round_trip)
+    {
+        enum Encoding { FULL, VARINT, ZIGZAG, BITS, QUANTIZED, BOOL, ENCODING_COUNT };
+
+        struct Field
+        {
+            Encoding encoding;
+            uint32_t unsignedValue;
+            int32_t signedValue;
+            float floatValue;
+            unsigned int bits;
+        };
+
+        std::vector<Field> fields(5000);
+
+        for (Field &field : fields)
+        {
+            field.encoding = (Encoding) (random() % ENCODING_COUNT);
+            field.unsignedValue = randomUnsigned(random);
+            field.signedValue = randomSigned(random);
+            field.floatValue = std::uniform_real_distribution<float>(-1, 1)(random);
+            field.bits = 1 + random() % 32;
+
+            if (field.bits < 32)
+                field.unsignedValue &= (1u << field.bits) - 1;
+
+            switch (field.encoding)
+            {
+                case FULL: bs.Write(field.unsignedValue); break;
+                case VARINT: writeVarint(&bs, field.unsignedValue); break;
+                case ZIGZAG: writeVarint(&bs, zigZagEncode(field.signedValue)); break;
+                case BITS: writeBits(&bs, field.unsignedValue, field.bits); break;
+                case QUANTIZED: writeQuantized(&bs, field.floatValue, -1, 1, 16); break;
+                case BOOL: bs.Write(field.unsignedValue % 2 == 1); break;
+                default: break;
+            }
+        }
+
+        for (const Field &field : fields)
+        {
+            uint32_t unsignedResult;
+            float floatResult;
+            bool boolResult;
+
+            switch (field.encoding)
+            {
+                case FULL:
+                    ASSERT_TRUE(bs.Read(unsignedResult));
+                    ASSERT_EQ(unsignedResult, field.unsignedValue);
+                    break;
+                case VARINT:
+                    ASSERT_TRUE(readVarint(&bs, unsignedResult));
+                    ASSERT_EQ(unsignedResult, field.unsignedValue);
+                    break;
+                case ZIGZAG:
+                    ASSERT_TRUE(readVarint(&bs, unsignedResult));
+                    ASSERT_EQ(zigZagDecode<int32_t>(unsignedResult), field.signedValue);
+                    break;
+                case BITS:
+                    ASSERT_TRUE(readBits(&bs, unsignedResult, field.bits));
+                    ASSERT_EQ(unsignedResult, field.unsignedValue);
+                    break;
+                case QUANTIZED:
+                    ASSERT_TRUE(readQuantized(&bs, floatResult, -1, 1, 16));
+                    ASSERT_NEAR(floatResult, field.floatValue, 2.0f / 65535);
+                    break;
+                case BOOL:
+                    ASSERT_TRUE(bs.Read(boolResult));
+                    ASSERT_EQ(boolResult, field.unsignedValue % 2 == 1);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        EXPECT_EQ(bs.GetNumberOfUnreadBits(), 0u);
+    }
+
+    // Compare the size of the fields of a typical container packet item under the previous full
+    // width encoding and the compact one the packet uses now
+    TEST_F(PacketEncodingTest, compact_container_fields_are_smaller_than_full_width)
+    {
+        RakNet::BitStream fullWidth;
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            const uint32_t refNum = random() % 500000;
+            const uint32_t mpNum = random() % 2 == 0 ? 0 : random() % 10000;
+            const uint32_t itemCount = random() % 40;
+            const int32_t count = 1 + random() % 100;
+            const int32_t charge = random() % 4 == 0 ? (int32_t) (random() % 3000) : -1;
+            const unsigned char action = random() % 4;
+
+            fullWidth.Write(refNum);
+            fullWidth.Write(mpNum);
+            fullWidth.Write(itemCount);
+            fullWidth.Write(count);
+            fullWidth.Write(charge);
+            fullWidth.Write(action);
+
+            writeVarint(&bs, refNum);
+            writeVarint(&bs, mpNum);
+            writeVarint(&bs, itemCount);
+            writeVarint(&bs, zigZagEncode(count));
+            writeVarint(&bs, zigZagEncode(charge));
+            writeBits(&bs, action, 2);
+        }
+
+        EXPECT_LT(bs.GetNumberOfBitsUsed() * 2, fullWidth.GetNumberOfBitsUsed());
+    }
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <components/openmw-mp/Packets/RecordIdState.hpp>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    using mwmp::RecordIdState;
+
+    const uint8_t channel = 3;
+
+    // A sender and a receiver of record ids, after the receiver has asked for them to go through
+    // the tables
+    struct RecordIdStateTest : ::testing::Test
+    {
+        RecordIdState mSender;
+        RecordIdState mReceiver;
+
+        void SetUp() override
+        {
+            mSender.resetWrite(mReceiver.resetRead());
+        }
+
+        void write(RakNet::BitStream &bs, const std::vector<std::string> &refIds)
+        {
+            for (const std::string &refId : refIds)
+                mSender.write(&bs, channel, refId);
+        }
+
+        std::vector<std::string> read(RakNet::BitStream &bs, std::size_t count)
+        {
+            std::vector<std::string> refIds;
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                std::string refId;
+
+                if (!mReceiver.read(&bs, channel, refId))
+                    break;
+
+                refIds.push_back(refId);
+            }
+
+            return refIds;
+        }
+    };
+
+    TEST(RecordIdStateWithoutResetTest, should_not_write_through_tables_before_a_reset)
+    {
+        RecordIdState state;
+        EXPECT_FALSE(state.isWriting());
+        EXPECT_FALSE(state.isReadEpoch(0));
+    }
+
+    TEST_F(RecordIdStateTest, should_read_record_ids_written_before)
+    {
+        const std::vector<std::string> refIds = {"gold_001", "iron dagger", "gold_001", "", "iron dagger"};
+
+        RakNet::BitStream first;
+        write(first, refIds);
+        EXPECT_EQ(read(first, refIds.size()), refIds);
+
+        RakNet::BitStream second;
+        write(second, refIds);
+        EXPECT_EQ(read(second, refIds.size()), refIds);
+        EXPECT_FALSE(mReceiver.isDesynced());
+    }
+
+    TEST_F(RecordIdStateTest, should_find_a_packet_that_was_never_read)
+    {
+        RakNet::BitStream skipped;
+        write(skipped, {"gold_001"});
+
+        RakNet::BitStream next;
+        write(next, {"iron dagger"});
+
+        EXPECT_TRUE(read(next, 1).empty());
+        EXPECT_TRUE(mReceiver.isDesynced());
+    }
+
+    TEST_F(RecordIdStateTest, should_find_an_index_that_was_never_read)
+    {
+        RakNet::BitStream skipped;
+        write(skipped, {"gold_001"});
+
+        RakNet::BitStream next;
+        write(next, {"gold_001"});
+
+        EXPECT_TRUE(read(next, 1).empty());
+        EXPECT_TRUE(mReceiver.isDesynced());
+    }
+
+    TEST_F(RecordIdStateTest, should_read_record_ids_again_after_a_reset)
+    {
+        const uint8_t oldEpoch = mSender.getWriteEpoch();
+
+        RakNet::BitStream skipped;
+        write(skipped, {"gold_001"});
+
+        RakNet::BitStream next;
+        write(next, {"gold_001"});
+        EXPECT_TRUE(read(next, 1).empty());
+
+        mSender.resetWrite(mReceiver.resetRead());
+        EXPECT_FALSE(mReceiver.isDesynced());
+        EXPECT_FALSE(mReceiver.isReadEpoch(oldEpoch));
+        EXPECT_TRUE(mReceiver.isReadEpoch(mSender.getWriteEpoch()));
+
+        const std::vector<std::string> refIds = {"gold_001", "gold_001"};
+        RakNet::BitStream afterReset;
+        write(afterReset, refIds);
+        EXPECT_EQ(read(afterReset, refIds.size()), refIds);
+    }
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <components/vfs/archive.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    class TestFile : public VFS::File
+    {
+    public:
+        Files::IStreamPtr open() override
+        {
+            return nullptr;
+        }
+    };
+
+    // An archive whose files can be changed after it has been registered
+    class TestArchive : public VFS::Archive
+    {
+    public:
+        explicit TestArchive(const std::string& name)
+            : mName(name)
+        {
+        }
+
+        VFS::File* add(const std::string& path)
+        {
+            mFiles.push_back(std::make_unique<TestFile>());
+            mIndex[path] = mFiles.back().get();
+            return mFiles.back().get();
+        }
+
+        void remove(const std::string& path)
+        {
+            mIndex.erase(path);
+        }
+
+        void listResources(std::map<std::string, VFS::File*>& out, char (*normalize_function) (char)) override
+        {
+            for (const auto& [path, file] : mIndex)
+            {
+                std::string normalized = path;
+                std::transform(normalized.begin(), normalized.end(), normalized.begin(), normalize_function);
+                out[normalized] = file;
+            }
+        }
+
+        bool contains(const std::string& file, char (*normalize_function) (char)) const override
+        {
+            for (const auto& [path, listed] : mIndex)
+            {
+                std::string normalized = path;
+                std::transform(normalized.begin(), normalized.end(), normalized.begin(), normalize_function);
+                if (normalized == file)
+                    return true;
+            }
+            return false;
+        }
+
+        std::string getDescription() const override
+        {
+            return mName;
+        }
+
+    private:
+        std::string mName;
+        std::vector<std::unique_ptr<TestFile>> mFiles;
+        std::map<std::string, VFS::File*> mIndex;
+    };
+
+    struct VFSManagerTest : public ::testing::Test
+    {
+        VFS::Manager mManager{false};
+
+        // Owned by mManager once registered
+        TestArchive* mMorrowind = new TestArchive("Morrowind.bsa");
+        TestArchive* mTribunal = new TestArchive("Tribunal.bsa");
+
+        VFS::File* mOriginalMesh = mMorrowind->add("meshes/x/ex_common_door.nif");
+        VFS::File* mOriginalTexture = mMorrowind->add("textures/tx_stone.dds");
+        VFS::File* mReplacedMesh = mTribunal->add("Meshes/X/Ex_Common_Door.NIF");
+        VFS::File* mNewSound = mTribunal->add("sound/fx/mournhold.wav");
+
+        void SetUp() override
+        {
+            mManager.addArchive(mMorrowind);
+            mManager.addArchive(mTribunal);
+        }
+
+        VFS::File* getIndexed(const std::string& normalizedName) const
+        {
+            const std::map<std::string, VFS::File*>& index = mManager.getIndex();
+            auto it = index.find(normalizedName);
+            return it != index.end() ? it->second : nullptr;
+        }
+    };
+
+    TEST_F(VFSManagerTest, later_archives_should_override_files_of_earlier_ones)
+    {
+        EXPECT_EQ(mManager.getIndex().size(), 3u);
+        EXPECT_EQ(getIndexed("meshes/x/ex_common_door.nif"), mReplacedMesh);
+        EXPECT_EQ(getIndexed("textures/tx_stone.dds"), mOriginalTexture);
+        EXPECT_EQ(getIndexed("sound/fx/mournhold.wav"), mNewSound);
+    }
+
+    TEST_F(VFSManagerTest, getArchive_should_return_the_overriding_archive)
+    {
+        EXPECT_EQ(mManager.getArchive("meshes/x/ex_common_door.nif"), "Tribunal.bsa");
+        EXPECT_EQ(mManager.getArchive("textures/tx_stone.dds"), "Morrowind.bsa");
+        EXPECT_EQ(mManager.getArchive("sound/fx/mournhold.wav"), "Tribunal.bsa");
+    }
+
+    TEST_F(VFSManagerTest, missing_files_should_not_be_found)
+    {
+        EXPECT_FALSE(mManager.exists("meshes/x/ex_common_door.dds"));
+        EXPECT_EQ(mManager.getArchive("meshes/x/ex_common_door.dds"), "");
+        EXPECT_THROW(mManager.get("meshes/x/ex_common_door.dds"), std::runtime_error);
+    }
+
+    TEST_F(VFSManagerTest, lookups_should_ignore_letter_case_and_slash_direction)
+    {
+        for (const char* name : {"Meshes\\X\\Ex_Common_Door.nif", "MESHES/x\\EX_COMMON_DOOR.NIF",
+            "meshes\\x/ex_common_door.nif"})
+        {
+            EXPECT_TRUE(mManager.exists(name)) << name;
+            EXPECT_EQ(mManager.getArchive(name), "Tribunal.bsa") << name;
+            EXPECT_NO_THROW(mManager.get(name)) << name;
+        }
+
+        EXPECT_TRUE(mManager.exists("Textures\\TX_Stone.DDS"));
+        EXPECT_EQ(mManager.getArchive("Textures\\TX_Stone.DDS"), "Morrowind.bsa");
+    }
+
+    TEST(VFSManagerStrictTest, strict_lookups_should_only_ignore_slash_direction)
+    {
+        VFS::Manager manager(true);
+        TestArchive* archive = new TestArchive("Data Files");
+        archive->add("Meshes/X/Ex_Common_Door.nif");
+        manager.addArchive(archive);
+
+        EXPECT_TRUE(manager.exists("Meshes\\X\\Ex_Common_Door.nif"));
+        EXPECT_EQ(manager.getArchive("Meshes\\X\\Ex_Common_Door.nif"), "Data Files");
+        EXPECT_FALSE(manager.exists("meshes/x/ex_common_door.nif"));
+        EXPECT_EQ(manager.getArchive("meshes/x/ex_common_door.nif"), "");
+    }
+
+    TEST_F(VFSManagerTest, buildIndex_should_give_the_same_index_as_addArchive)
+    {
+        const std::map<std::string, VFS::File*> index = mManager.getIndex();
+
+        mManager.buildIndex();
+
+        EXPECT_EQ(mManager.getIndex(), index);
+        EXPECT_EQ(mManager.getArchive("Meshes\\X\\Ex_Common_Door.nif"), "Tribunal.bsa");
+        EXPECT_EQ(mManager.getArchive("Textures\\TX_Stone.DDS"), "Morrowind.bsa");
+    }
+
+    TEST_F(VFSManagerTest, buildIndex_should_pick_up_changes_to_archives)
+    {
+        mTribunal->remove("Meshes/X/Ex_Common_Door.NIF");
+        VFS::File* newTexture = mTribunal->add("textures/tx_stone.dds");
+
+        mManager.buildIndex();
+
+        EXPECT_EQ(getIndexed("meshes/x/ex_common_door.nif"), mOriginalMesh);
+        EXPECT_EQ(mManager.getArchive("Meshes\\X\\Ex_Common_Door.nif"), "Morrowind.bsa");
+        EXPECT_EQ(getIndexed("textures/tx_stone.dds"), newTexture);
+        EXPECT_EQ(mManager.getArchive("Textures\\TX_Stone.DDS"), "Tribunal.bsa");
+    }
+
+    TEST_F(VFSManagerTest, archives_added_after_buildIndex_should_override_earlier_ones)
+    {
+        mManager.buildIndex();
+
+        TestArchive* bloodmoon = new TestArchive("Bloodmoon.bsa");
+        VFS::File* bloodmoonMesh = bloodmoon->add("meshes\\x\\ex_common_door.nif");
+        mManager.addArchive(bloodmoon);
+
+        EXPECT_EQ(getIndexed("meshes/x/ex_common_door.nif"), bloodmoonMesh);
+        EXPECT_EQ(mManager.getArchive("Meshes/X/Ex_Common_Door.nif"), "Bloodmoon.bsa");
+        EXPECT_EQ(mManager.getArchive("Textures\\TX_Stone.DDS"), "Morrowind.bsa");
+    }
+}
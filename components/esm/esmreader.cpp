@@ -2,6 +2,18 @@
 
 #include <stdexcept>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <cstring>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+/*
+    End of tes3mp addition
+*/
+
 namespace ESM
 {
 
@@ -15,7 +27,15 @@ using namespace Misc;
 ESM_Context ESMReader::getContext()
 {
     // Update the file position before returning
-    mCtx.filePos = mEsm->tellg();
+    /*
+        Start of tes3mp change (minor)
+
+        Get the position in memory mapped files as well
+    */
+    mCtx.filePos = getFileOffset();
+    /*
+        End of tes3mp change (minor)
+    */
     return mCtx;
 }
 
@@ -44,11 +64,33 @@ void ESMReader::restoreContext(const ESM_Context &rc)
     mCtx = rc;
 
     // Make sure we seek to the right place
-    mEsm->seekg(mCtx.filePos);
+    /*
+        Start of tes3mp change (minor)
+
+        Seek in memory mapped files as well
+    */
+    if (mMappedFile)
+        mMappedPos = mCtx.filePos;
+    else
+        mEsm->seekg(mCtx.filePos);
+    /*
+        End of tes3mp change (minor)
+    */
 }
 
 void ESMReader::close()
 {
+    /*
+        Start of tes3mp addition
+
+        Release the memory mapping, which is only unmapped once no copy of this reader uses it
+    */
+    mMappedFile.reset();
+    mMappedData = nullptr;
+    mMappedPos = 0;
+    /*
+        End of tes3mp addition
+    */
     mEsm.reset();
     clearCtx();
     mHeader.blank();
@@ -77,13 +119,50 @@ void ESMReader::openRaw(Files::IStreamPtr _esm, const std::string& name)
 
 void ESMReader::openRaw(const std::string& filename)
 {
+    /*
+        Start of tes3mp addition
+
+        Memory map the file if possible
+    */
+    if (mUseMemoryMapping && openRawMapped(filename))
+        return;
+    /*
+        End of tes3mp addition
+    */
+
     openRaw(Files::openConstrainedFileStream(filename.c_str()), filename);
 }
 
-void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
+/*
+    Start of tes3mp addition
+
+    Open a file through a memory mapping, returning false if it can't be mapped, which is the case
+    for empty files among others
+*/
+bool ESMReader::openRawMapped(const std::string &filename)
 {
-    openRaw(_esm, name);
+    std::shared_ptr<boost::iostreams::mapped_file_source> mappedFile;
+
+    try
+    {
+        mappedFile = std::make_shared<boost::iostreams::mapped_file_source>(filename);
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+
+    close();
+    mMappedFile = mappedFile;
+    mMappedData = mappedFile->data();
+    mMappedPos = 0;
+    mCtx.filename = filename;
+    mCtx.leftFile = mFileSize = mappedFile->size();
+    return true;
+}
 
+void ESMReader::readHeader()
+{
     if (getRecName() != "TES3")
         fail("Not a valid Morrowind file");
 
@@ -91,10 +170,37 @@ void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
 
     mHeader.load (*this);
 }
+/*
+    End of tes3mp addition
+*/
+
+void ESMReader::open(Files::IStreamPtr _esm, const std::string &name)
+{
+    openRaw(_esm, name);
+
+    /*
+        Start of tes3mp change (minor)
+
+        Share reading the header with files opened by name
+    */
+    readHeader();
+    /*
+        End of tes3mp change (minor)
+    */
+}
 
 void ESMReader::open(const std::string &file)
 {
-    open (Files::openConstrainedFileStream (file.c_str ()), file);
+    /*
+        Start of tes3mp change (minor)
+
+        Open the file by name, so it can be memory mapped
+    */
+    openRaw(file);
+    readHeader();
+    /*
+        End of tes3mp change (minor)
+    */
 }
 
 std::string ESMReader::getHNOString(const char* name)
@@ -119,7 +225,15 @@ std::string ESMReader::getHString()
     // them. For some reason, they break the rules, and contain a byte
     // (value 0) even if the header says there is no data. If
     // Morrowind accepts it, so should we.
-    if (mCtx.leftSub == 0 && !mEsm->peek())
+    /*
+        Start of tes3mp change (minor)
+
+        Check the next byte of memory mapped files as well
+    */
+    if (mCtx.leftSub == 0 && isNextByteZero())
+    /*
+        End of tes3mp change (minor)
+    */
     {
         // Skip the following zero byte
         mCtx.leftRec--;
@@ -302,6 +416,20 @@ void ESMReader::getRecHeader(uint32_t &flags)
 
 void ESMReader::getExact(void*x, int size)
 {
+    /*
+        Start of tes3mp addition
+
+        Copy straight out of memory mapped files
+    */
+    if (mMappedFile)
+    {
+        std::memcpy(x, getView(size).data(), size);
+        return;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     try
     {
         mEsm->read((char*)x, size);
@@ -314,6 +442,32 @@ void ESMReader::getExact(void*x, int size)
 
 std::string ESMReader::getString(int size)
 {
+    /*
+        Start of tes3mp addition
+
+        Convert strings straight out of memory mapped files when they are zero terminated within
+        their subrecord, as they almost always are, since the encoder relies on the terminator
+    */
+    if (mMappedFile)
+    {
+        const std::string_view view = getView(size);
+        const size_t length = strnlen(view.data(), view.size());
+
+        if (length < view.size() || !mEncoder)
+        {
+            if (mEncoder)
+                return mEncoder->getUtf8(view.data(), length);
+
+            return std::string(view.data(), length);
+        }
+
+        // Not terminated, so go back and copy it into the buffer instead
+        mMappedPos -= view.size();
+    }
+    /*
+        End of tes3mp addition
+    */
+
     size_t s = size;
     if (mBuffer.size() <= s)
         // Add some extra padding to reduce the chance of having to resize
@@ -344,8 +498,16 @@ void ESMReader::fail(const std::string &msg)
     ss << "\n  File: " << mCtx.filename;
     ss << "\n  Record: " << mCtx.recName.toString();
     ss << "\n  Subrecord: " << mCtx.subName.toString();
-    if (mEsm.get())
-        ss << "\n  Offset: 0x" << std::hex << mEsm->tellg();
+    /*
+        Start of tes3mp change (minor)
+
+        Report the offset in memory mapped files as well
+    */
+    if (mEsm.get() || mMappedFile)
+        ss << "\n  Offset: 0x" << std::hex << getFileOffset();
+    /*
+        End of tes3mp change (minor)
+    */
     throw std::runtime_error(ss.str());
 }
 
@@ -356,12 +518,79 @@ void ESMReader::setEncoder(ToUTF8::Utf8Encoder* encoder)
 
 size_t ESMReader::getFileOffset() const
 {
+    /*
+        Start of tes3mp addition
+
+        Get the position in memory mapped files as well
+    */
+    if (mMappedFile)
+        return mMappedPos;
+    /*
+        End of tes3mp addition
+    */
+
     return mEsm->tellg();
 }
 
 void ESMReader::skip(int bytes)
 {
+    /*
+        Start of tes3mp addition
+
+        Skip within the bounds of memory mapped files
+    */
+    if (mMappedFile)
+    {
+        if (bytes < 0 || static_cast<size_t>(bytes) > mFileSize - mMappedPos)
+            fail("Skip past the end of the file");
+
+        mMappedPos += bytes;
+        return;
+    }
+    /*
+        End of tes3mp addition
+    */
+
     mEsm->seekg(getFileOffset()+bytes);
 }
 
+/*
+    Start of tes3mp addition
+
+    Read the next bytes without copying them when the file is memory mapped, with the same bounds
+    checks a read from a stream has
+*/
+std::string_view ESMReader::getView(int size)
+{
+    if (size < 0)
+        fail("Read error: negative size");
+
+    if (mMappedFile)
+    {
+        if (static_cast<size_t>(size) > mFileSize - mMappedPos)
+            fail("Read error: unexpected end of file");
+
+        const std::string_view view(mMappedData + mMappedPos, size);
+        mMappedPos += size;
+        return view;
+    }
+
+    if (mBuffer.size() < static_cast<size_t>(size))
+        mBuffer.resize(size);
+
+    getExact(mBuffer.data(), size);
+    return std::string_view(mBuffer.data(), size);
+}
+
+bool ESMReader::isNextByteZero()
+{
+    if (mMappedFile)
+        return mMappedPos < mFileSize && mMappedData[mMappedPos] == 0;
+
+    return !mEsm->peek();
+}
+/*
+    End of tes3mp addition
+*/
+
 }
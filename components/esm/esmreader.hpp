@@ -6,6 +6,17 @@
 #include <vector>
 #include <sstream>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <memory>
+#include <string_view>
+/*
+    End of tes3mp addition
+*/
+
 #include <components/files/constrainedfilestream.hpp>
 
 #include <components/misc/stringops.hpp>
@@ -15,6 +26,22 @@
 #include "esmcommon.hpp"
 #include "loadtes3.hpp"
 
+/*
+    Start of tes3mp addition
+
+    Declare additional classes for multiplayer purposes
+*/
+namespace boost
+{
+namespace iostreams
+{
+    class mapped_file_source;
+}
+}
+/*
+    End of tes3mp addition
+*/
+
 namespace ESM {
 
 class ESMReader
@@ -72,6 +99,19 @@ public:
 
   void openRaw(const std::string &filename);
 
+  /*
+      Start of tes3mp addition
+
+      Make files opened by name from now on be memory mapped instead of read through a stream,
+      which avoids copying their data through a stream buffer and lets getView() return views
+      straight into them, falling back to a stream for files that can't be mapped
+  */
+  void setMemoryMapped(bool memoryMapped) { mUseMemoryMapping = memoryMapped; }
+  bool isMemoryMapped() const { return mMappedFile != nullptr; }
+  /*
+      End of tes3mp addition
+  */
+
   /// Get the current position in the file. Make sure that the file has been opened!
   size_t getFileOffset() const;
 
@@ -251,6 +291,17 @@ public:
   // them from native encoding to UTF8 in the process.
   std::string getString(int size);
 
+  /*
+      Start of tes3mp addition
+
+      Read the next 'size' bytes without copying them if the file is memory mapped, in which case
+      the view stays valid until the file is closed, and otherwise only until the next read
+  */
+  std::string_view getView(int size);
+  /*
+      End of tes3mp addition
+  */
+
   void skip(int bytes);
 
   /// Used for error handling
@@ -267,6 +318,24 @@ public:
 private:
   void clearCtx();
 
+  /*
+      Start of tes3mp addition
+
+      Memory mapped files are read straight from the mapping, with each copy of a reader keeping
+      its own position in it
+  */
+  bool openRawMapped(const std::string &filename);
+  void readHeader();
+  bool isNextByteZero();
+
+  std::shared_ptr<boost::iostreams::mapped_file_source> mMappedFile;
+  const char *mMappedData = nullptr;
+  size_t mMappedPos = 0;
+  bool mUseMemoryMapping = false;
+  /*
+      End of tes3mp addition
+  */
+
   Files::IStreamPtr mEsm;
 
   ESM_Context mCtx;
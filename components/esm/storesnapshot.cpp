@@ -0,0 +1,74 @@
+#include "storesnapshot.hpp"
+
+#include "defs.hpp"
+#include "esmreader.hpp"
+#include "esmwriter.hpp"
+
+unsigned int ESM::StoreSnapshot::sRecordId = ESM::FourCC<'S','N','A','P'>::value;
+int ESM::StoreSnapshot::sCurrentFormat = 1;
+
+bool ESM::StoreSnapshot::matches(const std::string &engineVersion, const std::vector<ContentFile> &contentFiles) const
+{
+    return mFormat == sCurrentFormat && mEngineVersion == engineVersion && mContentFiles == contentFiles;
+}
+
+void ESM::StoreSnapshot::load (ESMReader &esm)
+{
+    esm.getHNT (mFormat, "FORM");
+
+    // Don't read any further into a snapshot written differently
+    if (mFormat != sCurrentFormat)
+    {
+        esm.skipRecord();
+        return;
+    }
+
+    mEngineVersion = esm.getHNString ("VERS");
+
+    mContentFiles.clear();
+    while (esm.isNextSub ("FNAM"))
+    {
+        ContentFile file;
+        file.mName = esm.getHString();
+        esm.getHNT (file.mChecksum, "CRC_");
+        mContentFiles.push_back (file);
+    }
+
+    mRecordTypes.clear();
+    while (esm.isNextSub ("TYPE"))
+    {
+        int type;
+        esm.getHT (type);
+        mRecordTypes.push_back (type);
+    }
+
+    mRefCounts.clear();
+    while (esm.isNextSub ("NAME"))
+    {
+        std::pair<std::string, int> refCount;
+        refCount.first = esm.getHString();
+        esm.getHNT (refCount.second, "INTV");
+        mRefCounts.push_back (refCount);
+    }
+}
+
+void ESM::StoreSnapshot::save (ESMWriter &esm) const
+{
+    esm.writeHNT ("FORM", mFormat);
+    esm.writeHNString ("VERS", mEngineVersion);
+
+    for (const ContentFile &file : mContentFiles)
+    {
+        esm.writeHNString ("FNAM", file.mName);
+        esm.writeHNT ("CRC_", file.mChecksum);
+    }
+
+    for (int type : mRecordTypes)
+        esm.writeHNT ("TYPE", type);
+
+    for (const std::pair<std::string, int> &refCount : mRefCounts)
+    {
+        esm.writeHNString ("NAME", refCount.first);
+        esm.writeHNT ("INTV", refCount.second);
+    }
+}
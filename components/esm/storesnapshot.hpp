@@ -0,0 +1,61 @@
+#ifndef OPENMW_ESM_STORESNAPSHOT_H
+#define OPENMW_ESM_STORESNAPSHOT_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ESM
+{
+    class ESMReader;
+    class ESMWriter;
+
+    /*
+        Header of a snapshot of the records merged from a list of content files, so later launches
+        with the same content files can load them from it instead of parsing every file again
+
+        The snapshot is itself written like a content file, with this record first and the merged
+        records of every type in mRecordTypes following it in the order they were loaded in
+    */
+    struct StoreSnapshot
+    {
+        struct ContentFile
+        {
+            std::string mName;
+            unsigned int mChecksum;
+
+            bool operator==(const ContentFile &other) const
+            {
+                return mName == other.mName && mChecksum == other.mChecksum;
+            }
+        };
+
+        static unsigned int sRecordId;
+
+        // Increased whenever snapshots are written differently, so older ones are no longer used
+        static int sCurrentFormat;
+
+        int mFormat;
+        std::string mEngineVersion;
+
+        // The content files the records were merged from in load order, along with the CRC32
+        // checksums of their contents
+        std::vector<ContentFile> mContentFiles;
+
+        // The types of the records the snapshot holds, none of which have to be loaded from the
+        // content files anymore
+        std::vector<int> mRecordTypes;
+
+        // How many references to each record the cells of the content files have
+        std::vector<std::pair<std::string, int>> mRefCounts;
+
+        // Whether this snapshot was made from the given content files by the given engine version,
+        // making it usable in place of them
+        bool matches(const std::string &engineVersion, const std::vector<ContentFile> &contentFiles) const;
+
+        void load (ESMReader &esm);
+        void save (ESMWriter &esm) const;
+    };
+}
+
+#endif
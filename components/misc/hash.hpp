@@ -1,6 +1,17 @@
 #ifndef MISC_HASH_H
 #define MISC_HASH_H
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <cstdint>
+#include <string_view>
+/*
+    End of tes3mp addition
+*/
+
 namespace Misc
 {
     /// Implemented similar to the boost::hash_combine
@@ -10,6 +21,29 @@ namespace Misc
         std::hash<T> hasher;
         seed ^= hasher(v) + 0x9e3779b9 + (seed<<6) + (seed>>2);
     }
+
+    /*
+        Start of tes3mp addition
+
+        64-bit FNV-1a over the characters of a string as returned by normalize, so strings that only
+        differ in ways normalize evens out, such as case, get the same hash
+    */
+    template <class Normalize>
+    inline std::uint64_t fnv1a(std::string_view str, Normalize normalize)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+
+        for (char c : str)
+        {
+            hash ^= static_cast<unsigned char>(normalize(c));
+            hash *= 1099511628211ull;
+        }
+
+        return hash;
+    }
+    /*
+        End of tes3mp addition
+    */
 }
 
-#endif
\ No newline at end of file
+#endif
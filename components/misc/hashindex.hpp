@@ -0,0 +1,181 @@
+#ifndef MISC_HASHINDEX_H
+#define MISC_HASHINDEX_H
+
+#include <cstddef>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace Misc
+{
+    /*
+        An open addressing hash table from strings to values, for lookups that happen far more often
+        than changes and shouldn't have to allocate anything, with Hash and Equal deciding which
+        strings count as the same key
+
+        The table doesn't own its keys, which have to stay valid for as long as they are in it, so it
+        is meant to sit next to the container actually holding them, such as the nodes of a map
+    */
+    template <class Value, class Hash, class Equal>
+    class HashIndex
+    {
+    public:
+        explicit HashIndex(const Hash &hasher = Hash(), const Equal &equal = Equal())
+            : hasher(hasher), equal(equal)
+        {
+        }
+
+        std::size_t hash(std::string_view key) const
+        {
+            return hasher(key);
+        }
+
+        const Value *find(std::string_view key) const
+        {
+            return find(key, hash(key));
+        }
+
+        // Find a key whose hash was already worked out, so a key looked up in several indexes
+        // with the same Hash only has to be hashed once
+        const Value *find(std::string_view key, std::size_t keyHash) const
+        {
+            if (count == 0)
+                return nullptr;
+
+            for (std::size_t i = keyHash & mask; !isEmpty(slots[i]); i = (i + 1) & mask)
+            {
+                if (slots[i].hash == keyHash && equal(slots[i].key, key))
+                    return &slots[i].value;
+            }
+
+            return nullptr;
+        }
+
+        // Add a key or replace the value of an equal one that is already there, along with the
+        // key itself, since the old one may not stay valid
+        void insert(std::string_view key, const Value &value)
+        {
+            if ((count + 1) * 4 > slots.size() * 3)
+                rehash(slots.empty() ? 16 : slots.size() * 2);
+
+            const std::size_t keyHash = hash(key);
+            std::size_t i = keyHash & mask;
+
+            for (; !isEmpty(slots[i]); i = (i + 1) & mask)
+            {
+                if (slots[i].hash == keyHash && equal(slots[i].key, key))
+                {
+                    slots[i].key = key;
+                    slots[i].value = value;
+                    return;
+                }
+            }
+
+            slots[i] = Slot{keyHash, key, value};
+            ++count;
+        }
+
+        bool erase(std::string_view key)
+        {
+            if (count == 0)
+                return false;
+
+            const std::size_t keyHash = hash(key);
+            std::size_t hole = keyHash & mask;
+
+            for (;; hole = (hole + 1) & mask)
+            {
+                if (isEmpty(slots[hole]))
+                    return false;
+
+                if (slots[hole].hash == keyHash && equal(slots[hole].key, key))
+                    break;
+            }
+
+            // Shift back the keys after the erased one that would otherwise no longer be reachable
+            // from their ideal slots, instead of leaving a marker behind for lookups to step over
+            for (std::size_t i = (hole + 1) & mask; !isEmpty(slots[i]); i = (i + 1) & mask)
+            {
+                const std::size_t ideal = slots[i].hash & mask;
+
+                if (((i - ideal) & mask) >= ((i - hole) & mask))
+                {
+                    slots[hole] = std::move(slots[i]);
+                    hole = i;
+                }
+            }
+
+            slots[hole] = Slot();
+            --count;
+            return true;
+        }
+
+        void clear()
+        {
+            slots.clear();
+            mask = 0;
+            count = 0;
+        }
+
+        // Make room for the given number of keys up front, so adding them doesn't rehash the table
+        // again and again
+        void reserve(std::size_t keys)
+        {
+            std::size_t capacity = 16;
+
+            while (keys * 4 > capacity * 3)
+                capacity *= 2;
+
+            if (capacity > slots.size())
+                rehash(capacity);
+        }
+
+        std::size_t size() const
+        {
+            return count;
+        }
+
+    private:
+        // Slots are empty when they don't point to a key, which a key taken from a string never does
+        struct Slot
+        {
+            std::size_t hash = 0;
+            std::string_view key;
+            Value value = Value();
+        };
+
+        static bool isEmpty(const Slot &slot)
+        {
+            return slot.key.data() == nullptr;
+        }
+
+        void rehash(std::size_t capacity)
+        {
+            std::vector<Slot> oldSlots(capacity);
+            oldSlots.swap(slots);
+            mask = capacity - 1;
+
+            for (Slot &slot : oldSlots)
+            {
+                if (isEmpty(slot))
+                    continue;
+
+                std::size_t i = slot.hash & mask;
+
+                while (!isEmpty(slots[i]))
+                    i = (i + 1) & mask;
+
+                slots[i] = std::move(slot);
+            }
+        }
+
+        std::vector<Slot> slots;
+        std::size_t mask = 0;
+        std::size_t count = 0;
+
+        Hash hasher;
+        Equal equal;
+    };
+}
+
+#endif
@@ -4,6 +4,18 @@
 #include <cctype>
 #include <string>
 #include <algorithm>
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <cstdint>
+#include <string_view>
+
+#include "hash.hpp"
+/*
+    End of tes3mp addition
+*/
 
 #include "utf8stream.hpp"
 
@@ -172,6 +184,39 @@ public:
         }
     };
 
+    /*
+        Start of tes3mp addition
+
+        Case-insensitive hashing and equality for unordered containers, usable with string views
+        so lookups don't need to build a lowercase copy of their key
+    */
+    struct CiHash
+    {
+        std::size_t operator()(std::string_view str) const
+        {
+            return static_cast<std::size_t>(fnv1a(str, &StringUtils::toLower));
+        }
+    };
+
+    struct CiEqual
+    {
+        bool operator()(std::string_view left, std::string_view right) const
+        {
+            if (left.size() != right.size())
+                return false;
+
+            for (std::size_t i = 0; i < left.size(); ++i)
+            {
+                if (toLower(left[i]) != toLower(right[i]))
+                    return false;
+            }
+            return true;
+        }
+    };
+    /*
+        End of tes3mp addition
+    */
+
 
     /// Performs a binary search on a sorted container for a string that 'key' starts with
     template<typename Iterator, typename T>
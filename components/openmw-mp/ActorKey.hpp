@@ -0,0 +1,35 @@
+#ifndef OPENMW_ACTORKEY_HPP
+#define OPENMW_ACTORKEY_HPP
+
+#include <cstdint>
+#include <string>
+
+namespace mwmp
+{
+    // An object's refNum and mpNum packed into a single integer, used as the key of anything indexed
+    // by them, such as actors, without building a string for every lookup
+    typedef uint64_t ActorKey;
+
+    inline ActorKey getActorKey(unsigned int refNum, unsigned int mpNum)
+    {
+        return (static_cast<uint64_t>(refNum) << 32) | mpNum;
+    }
+
+    inline unsigned int getActorKeyRefNum(ActorKey actorKey)
+    {
+        return static_cast<unsigned int>(actorKey >> 32);
+    }
+
+    inline unsigned int getActorKeyMpNum(ActorKey actorKey)
+    {
+        return static_cast<unsigned int>(actorKey);
+    }
+
+    // The refNum-mpNum form actors are referred to by in logs
+    inline std::string getActorKeyDescription(ActorKey actorKey)
+    {
+        return std::to_string(getActorKeyRefNum(actorKey)) + "-" + std::to_string(getActorKeyMpNum(actorKey));
+    }
+}
+
+#endif //OPENMW_ACTORKEY_HPP
@@ -1,6 +1,8 @@
 #ifndef OPENMW_BASEACTOR_HPP
 #define OPENMW_BASEACTOR_HPP
 
+#include <cstdint>
+
 #include <components/esm/loadcell.hpp>
 
 #include <components/openmw-mp/Base/BaseStructs.hpp>
@@ -19,6 +21,17 @@ namespace mwmp
             hasStatsDynamicData = false;
         }
 
+        // The parts of an actor carried by an ID_ACTOR_UPDATE
+        enum UPDATE_FLAG
+        {
+            UPDATE_ANIM_FLAGS = 1 << 0,
+            UPDATE_ANIM_PLAY = 1 << 1,
+            UPDATE_SPEECH = 1 << 2,
+            UPDATE_STATS_DYNAMIC = 1 << 3,
+            UPDATE_ATTACK = 1 << 4,
+            UPDATE_CAST = 1 << 5
+        };
+
         std::string refId = "";
         unsigned int refNum;
         unsigned int mpNum;
@@ -57,6 +70,8 @@ namespace mwmp
         bool hasPositionData;
         bool hasStatsDynamicData;
 
+        uint8_t updateFlags = 0;
+
         Item equipmentItems[19];
         SpellsActiveChanges spellsActiveChanges;
     };
@@ -99,6 +114,9 @@ namespace mwmp
 
         unsigned char action; // 0 - Clear and set in entirety, 1 - Add item, 2 - Remove item, 3 - Request items
 
+        // The server time in milliseconds at which positions were sent out, or 0 if they weren't timed
+        uint32_t timestamp = 0;
+
         bool isValid;
     };
 }
@@ -3,7 +3,7 @@
 
 #include <string>
 #include <memory>
-#include <unordered_map>
+#include <array>
 #include <stdexcept>
 
 #define BPP_INIT(packet_id) packetID = packet_id; strPacketID = #packet_id; className = typeid(this).name(); avoidReading = false;
@@ -12,7 +12,8 @@ template<typename Proccessor>
 class BasePacketProcessor
 {
 public:
-    typedef std::unordered_map<unsigned char, std::unique_ptr<Proccessor>> processors_t;
+    // Indexed directly by packet ID, so finding the processor for a packet is a single lookup
+    typedef std::array<std::unique_ptr<Proccessor>, 256> processors_t;
     unsigned char GetPacketID()
     {
         return packetID;
@@ -29,13 +30,18 @@ public:
 
     static void AddProcessor(Proccessor *processor)
     {
-        for (auto &p : processors)
-        {
-            if (processor->packetID == p.first)
-                throw std::logic_error("processor " + p.second->strPacketID + " already registered. Check " +
-                                       processor->className + " and " + p.second->className);
-        }
-        processors.insert(typename processors_t::value_type(processor->GetPacketID(), processor));
+        const std::unique_ptr<Proccessor> &registered = processors[processor->GetPacketID()];
+
+        if (registered)
+            throw std::logic_error("processor " + registered->strPacketID + " already registered. Check " +
+                                   processor->className + " and " + registered->className);
+
+        processors[processor->GetPacketID()].reset(processor);
+    }
+
+    static Proccessor *GetProcessor(unsigned char packetID)
+    {
+        return processors[packetID].get();
     }
 protected:
     unsigned char packetID;
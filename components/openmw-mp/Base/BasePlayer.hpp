@@ -1,6 +1,8 @@
 #ifndef OPENMW_BASEPLAYER_HPP
 #define OPENMW_BASEPLAYER_HPP
 
+#include <cstdint>
+
 #include <components/esm/loadcell.hpp>
 #include <components/esm/loadcrea.hpp>
 #include <components/esm/loadnpc.hpp>
@@ -238,6 +240,8 @@ namespace mwmp
 
         ESM::Position position;
         ESM::Position direction;
+        // The server time in milliseconds at which the position was sent out, or 0 if it wasn't timed
+        uint32_t positionTimestamp = 0;
         ESM::Position previousCellPosition;
         ESM::Position momentum;
         ESM::Cell cell;
@@ -1,6 +1,7 @@
 #ifndef OPENMW_BASESYSTEM_HPP
 #define OPENMW_BASESYSTEM_HPP
 
+#include <cstdint>
 #include <string>
 
 #include <RakNetTypes.h>
@@ -25,6 +26,9 @@ namespace mwmp
         std::string playerName;
         std::string serverPassword;
 
+        // The epoch sent in an ID_SYSTEM_RECORD_ID_RESET
+        uint8_t recordIdEpoch = 0;
+
     };
 }
 
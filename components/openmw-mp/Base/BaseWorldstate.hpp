@@ -334,11 +334,14 @@ namespace mwmp
     };
 
     static const int maxImageDataSize = 1800;
+    // The most map tiles a client can ask for at a time, so every chunk stays reasonably small
+    static const unsigned int maxMapTilesPerRequest = 16;
 
     struct MapTile
     {
         int x;
         int y;
+        uint64_t hash;
         std::vector<char> imageData;
     };
 
@@ -370,8 +373,19 @@ namespace mwmp
 
             time.daysPassed = -1;
             time.timeScale = -1;
+
+            mapTilesAction = MAP_TILES_SET;
         }
 
+        enum MAP_TILES_ACTION
+        {
+            MAP_TILES_SET = 0,  // Tiles with their image data
+            MAP_TILES_LIST,     // Tiles with only the hashes of their image data
+            MAP_TILES_REQUEST,  // Listed tiles a client doesn't have the image data for
+            MAP_TILES_CHUNK,    // Tiles with their image data, sent in reply to a request
+            MAP_TILES_CACHED    // Listed tiles a client already has the image data for
+        };
+
         RakNet::RakNetGUID guid;
 
         mwmp::Time time;
@@ -391,6 +405,7 @@ namespace mwmp
         std::vector<std::string> enforcedCollisionRefIds;
         std::map<std::string, std::string> destinationOverrides;
 
+        unsigned char mapTilesAction;
         std::vector<MapTile> mapTiles;
 
         bool forceWeather;
@@ -427,6 +442,9 @@ namespace mwmp
 
         std::vector<ESM::Cell> cellsToReset;
 
+        // The hashes of the records a client has cached
+        std::vector<uint64_t> cachedRecords;
+
         bool isValid;
     };
 }
@@ -0,0 +1,151 @@
+#include <algorithm>
+#include <cstdio>
+#include <ctime>
+#include <utility>
+
+#include <boost/filesystem.hpp>
+#include <boost/filesystem/fstream.hpp>
+
+#include "ContentCache.hpp"
+#include "TimedLog.hpp"
+#include "Utils.hpp"
+
+using namespace mwmp;
+
+std::string ContentCache::baseDirectory = "";
+
+namespace
+{
+    // Skip leftover temporary files and anything else that isn't named after a hash
+    bool isBlobName(const std::string &fileName)
+    {
+        return fileName.size() == 16 && fileName.find_first_not_of("0123456789abcdef") == std::string::npos;
+    }
+}
+
+ContentCache::ContentCache(const std::string &name) : name(name)
+{
+}
+
+bool ContentCache::load(uint64_t hash, std::vector<char> &data) const
+{
+    boost::filesystem::ifstream file(getPath(hash), std::ios::binary);
+
+    if (!file)
+        return false;
+
+    data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+    if (Utils::hashBytes(data.data(), data.size()) != hash)
+    {
+        data.clear();
+        return false;
+    }
+
+    boost::system::error_code error;
+    boost::filesystem::last_write_time(getPath(hash), std::time(nullptr), error);
+
+    return true;
+}
+
+void ContentCache::store(uint64_t hash, const std::vector<char> &data) const
+{
+    const boost::filesystem::path path = getPath(hash);
+
+    if (boost::filesystem::exists(path))
+        return;
+
+    boost::system::error_code error;
+    boost::filesystem::create_directories(path.parent_path(), error);
+
+    // Write to a temporary file first, so an interrupted write never leaves a partial blob behind
+    // under the final name
+    const boost::filesystem::path temporaryPath = path.string() + ".tmp";
+
+    {
+        boost::filesystem::ofstream file(temporaryPath, std::ios::binary);
+        file.write(data.data(), data.size());
+
+        if (!file)
+        {
+            LOG_MESSAGE_SIMPLE(TimedLog::LOG_WARN, "Could not write %s to the %s cache", temporaryPath.string().c_str(),
+                name.c_str());
+            return;
+        }
+    }
+
+    boost::filesystem::rename(temporaryPath, path, error);
+}
+
+void ContentCache::getHashes(std::vector<uint64_t> &hashes, std::size_t maxHashes) const
+{
+    boost::system::error_code error;
+    boost::filesystem::directory_iterator it(getDirectory(), error);
+
+    if (error)
+        return;
+
+    for (; it != boost::filesystem::directory_iterator() && hashes.size() < maxHashes; it.increment(error))
+    {
+        if (error)
+            break;
+
+        const std::string fileName = it->path().filename().string();
+
+        if (!isBlobName(fileName))
+            continue;
+
+        hashes.push_back(std::stoull(fileName, nullptr, 16));
+    }
+}
+
+void ContentCache::trim(std::size_t maxBlobs) const
+{
+    std::vector<std::pair<std::time_t, boost::filesystem::path>> blobs;
+
+    boost::system::error_code error;
+    boost::filesystem::directory_iterator it(getDirectory(), error);
+
+    if (error)
+        return;
+
+    for (; it != boost::filesystem::directory_iterator(); it.increment(error))
+    {
+        if (error)
+            return;
+
+        if (!isBlobName(it->path().filename().string()))
+            continue;
+
+        blobs.emplace_back(boost::filesystem::last_write_time(it->path(), error), it->path());
+    }
+
+    if (blobs.size() <= maxBlobs)
+        return;
+
+    const std::size_t removedCount = blobs.size() - maxBlobs;
+    std::nth_element(blobs.begin(), blobs.begin() + removedCount, blobs.end());
+
+    for (std::size_t i = 0; i < removedCount; ++i)
+        boost::filesystem::remove(blobs[i].second, error);
+
+    LOG_MESSAGE_SIMPLE(TimedLog::LOG_INFO, "Removed %zu unused blobs from the %s cache", removedCount, name.c_str());
+}
+
+void ContentCache::setBaseDirectory(const std::string &directory)
+{
+    baseDirectory = directory;
+}
+
+std::string ContentCache::getDirectory() const
+{
+    return (boost::filesystem::path(baseDirectory) / name).string();
+}
+
+std::string ContentCache::getPath(uint64_t hash) const
+{
+    char fileName[17];
+    snprintf(fileName, sizeof(fileName), "%016llx", (unsigned long long) hash);
+
+    return (boost::filesystem::path(getDirectory()) / fileName).string();
+}
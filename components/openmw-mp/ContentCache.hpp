@@ -0,0 +1,48 @@
+#ifndef OPENMW_CONTENTCACHE_HPP
+#define OPENMW_CONTENTCACHE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace mwmp
+{
+    /*
+        Blobs of data received from servers, kept on disk under the hash of their contents so they
+        don't have to be sent again on later connections
+
+        Anything loaded is hashed again before it is used, so a damaged file is only ever a miss.
+        Loading a blob marks it as used, so trimming the cache removes the ones unused the longest
+    */
+    class ContentCache
+    {
+    public:
+        // The directory is created inside the base directory the first time it's needed, and can be
+        // a path of several directories
+        ContentCache(const std::string &name);
+
+        bool load(uint64_t hash, std::vector<char> &data) const;
+        void store(uint64_t hash, const std::vector<char> &data) const;
+
+        // Get the hashes of everything in the cache, up to the given number of them
+        void getHashes(std::vector<uint64_t> &hashes, std::size_t maxHashes) const;
+
+        // Remove the blobs unused the longest until there are at most the given number of them
+        void trim(std::size_t maxBlobs) const;
+
+        // Get where the blob with the given hash is kept, for blobs that are too large to be loaded
+        // in full and are read from the file directly instead
+        std::string getPath(uint64_t hash) const;
+
+        static void setBaseDirectory(const std::string &directory);
+
+    private:
+        std::string getDirectory() const;
+
+        std::string name;
+
+        static std::string baseDirectory;
+    };
+}
+
+#endif //OPENMW_CONTENTCACHE_HPP
@@ -13,6 +13,8 @@
 #include "../Packets/Actor/PacketActorSpeech.hpp"
 #include "../Packets/Actor/PacketActorSpellsActive.hpp"
 #include "../Packets/Actor/PacketActorStatsDynamic.hpp"
+#include "../Packets/Actor/PacketActorSnapshot.hpp"
+#include "../Packets/Actor/PacketActorUpdate.hpp"
 
 
 #include "ActorPacketController.hpp"
@@ -21,8 +23,7 @@ template <typename T>
 inline void AddPacket(mwmp::ActorPacketController::packets_t *packets, RakNet::RakPeerInterface *peer)
 {
     T *packet = new T(peer);
-    typedef mwmp::ActorPacketController::packets_t::value_type value_t;
-    packets->insert(value_t(packet->GetPacketID(), value_t::second_type(packet)));
+    (*packets)[packet->GetPacketID()].reset(packet);
 }
 
 mwmp::ActorPacketController::ActorPacketController(RakNet::RakPeerInterface *peer)
@@ -42,26 +43,26 @@ mwmp::ActorPacketController::ActorPacketController(RakNet::RakPeerInterface *pee
     AddPacket<PacketActorSpeech>(&packets, peer);
     AddPacket<PacketActorSpellsActive>(&packets, peer);
     AddPacket<PacketActorStatsDynamic>(&packets, peer);
+    AddPacket<PacketActorSnapshot>(&packets, peer);
+    AddPacket<PacketActorUpdate>(&packets, peer);
 }
 
 
 mwmp::ActorPacket *mwmp::ActorPacketController::GetPacket(RakNet::MessageID id)
 {
-    return packets[(unsigned char)id].get();
+    return packets[id].get();
 }
 
 void mwmp::ActorPacketController::SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream)
 {
     for(const auto &packet : packets)
-        packet.second->SetStreams(inStream, outStream);
+    {
+        if (packet)
+            packet->SetStreams(inStream, outStream);
+    }
 }
 
 bool mwmp::ActorPacketController::ContainsPacket(RakNet::MessageID id)
 {
-    for(const auto &packet : packets)
-    {
-        if (packet.first == id)
-            return true;
-    }
-    return false;
+    return packets[id] != nullptr;
 }
@@ -0,0 +1,66 @@
+#ifndef OPENMW_PACKETDISPATCHTABLE_HPP
+#define OPENMW_PACKETDISPATCHTABLE_HPP
+
+#include <RakNetTypes.h>
+#include <components/openmw-mp/Packets/BasePacket.hpp>
+
+#include <array>
+#include <stdexcept>
+#include <string>
+
+namespace mwmp
+{
+    /*
+        Maps every possible MessageID to the packet controller category that handles it and to the
+        packet instance it is read into, so incoming packets are dispatched with a single lookup
+        instead of asking each controller in turn whether it contains the packet
+    */
+    class PacketDispatchTable
+    {
+    public:
+        enum class Category : unsigned char
+        {
+            None,
+            System,
+            Player,
+            Actor,
+            Object,
+            Worldstate
+        };
+
+        struct Entry
+        {
+            Category category = Category::None;
+            BasePacket *packet = nullptr;
+        };
+
+        template<typename Controller>
+        void addController(Category category, Controller &controller)
+        {
+            for (unsigned int id = 0; id < entries.size(); ++id)
+            {
+                BasePacket *packet = controller.GetPacket(static_cast<RakNet::MessageID>(id));
+
+                if (packet == nullptr)
+                    continue;
+
+                if (entries[id].packet != nullptr)
+                    throw std::logic_error("packet with identifier " + std::to_string(id) +
+                                           " is registered by more than one packet controller");
+
+                entries[id].category = category;
+                entries[id].packet = packet;
+            }
+        }
+
+        const Entry &get(RakNet::MessageID id) const
+        {
+            return entries[id];
+        }
+
+    private:
+        std::array<Entry, 256> entries;
+    };
+}
+
+#endif //OPENMW_PACKETDISPATCHTABLE_HPP
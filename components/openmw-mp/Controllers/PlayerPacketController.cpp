@@ -48,8 +48,7 @@ template <typename T>
 inline void AddPacket(mwmp::PlayerPacketController::packets_t *packets, RakNet::RakPeerInterface *peer)
 {
     T *packet = new T(peer);
-    typedef mwmp::PlayerPacketController::packets_t::value_type value_t;
-    packets->insert(value_t(packet->GetPacketID(), value_t::second_type(packet)));
+    (*packets)[packet->GetPacketID()].reset(packet);
 }
 
 mwmp::PlayerPacketController::PlayerPacketController(RakNet::RakPeerInterface *peer)
@@ -103,21 +102,19 @@ mwmp::PlayerPacketController::PlayerPacketController(RakNet::RakPeerInterface *p
 
 mwmp::PlayerPacket *mwmp::PlayerPacketController::GetPacket(RakNet::MessageID id)
 {
-    return packets[(unsigned char)id].get();
+    return packets[id].get();
 }
 
 void mwmp::PlayerPacketController::SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream)
 {
     for(const auto &packet : packets)
-        packet.second->SetStreams(inStream, outStream);
+    {
+        if (packet)
+            packet->SetStreams(inStream, outStream);
+    }
 }
 
 bool mwmp::PlayerPacketController::ContainsPacket(RakNet::MessageID id)
 {
-    for(const auto &packet : packets)
-    {
-        if (packet.first == id)
-            return true;
-    }
-    return false;
+    return packets[id] != nullptr;
 }
@@ -4,7 +4,7 @@
 
 #include <RakPeerInterface.h>
 #include "../Packets/System/SystemPacket.hpp"
-#include <unordered_map>
+#include <array>
 #include <memory>
 
 namespace mwmp
@@ -18,7 +18,8 @@ namespace mwmp
 
         bool ContainsPacket(RakNet::MessageID id);
 
-        typedef std::unordered_map<unsigned char, std::unique_ptr<SystemPacket> > packets_t;
+        // Indexed directly by MessageID, so lookups never search or insert
+        typedef std::array<std::unique_ptr<SystemPacket>, 256> packets_t;
     private:
         packets_t packets;
     };
@@ -1,6 +1,7 @@
 #include "../Packets/Worldstate/PacketCellReset.hpp"
 #include "../Packets/Worldstate/PacketClientScriptGlobal.hpp"
 #include "../Packets/Worldstate/PacketClientScriptSettings.hpp"
+#include "../Packets/Worldstate/PacketRecordCache.hpp"
 #include "../Packets/Worldstate/PacketRecordDynamic.hpp"
 #include "../Packets/Worldstate/PacketWorldCollisionOverride.hpp"
 #include "../Packets/Worldstate/PacketWorldDestinationOverride.hpp"
@@ -16,8 +17,7 @@ template <typename T>
 inline void AddPacket(mwmp::WorldstatePacketController::packets_t *packets, RakNet::RakPeerInterface *peer)
 {
     T *packet = new T(peer);
-    typedef mwmp::WorldstatePacketController::packets_t::value_type value_t;
-    packets->insert(value_t(packet->GetPacketID(), value_t::second_type(packet)));
+    (*packets)[packet->GetPacketID()].reset(packet);
 }
 
 mwmp::WorldstatePacketController::WorldstatePacketController(RakNet::RakPeerInterface *peer)
@@ -25,6 +25,7 @@ mwmp::WorldstatePacketController::WorldstatePacketController(RakNet::RakPeerInte
     AddPacket<PacketCellReset>(&packets, peer);
     AddPacket<PacketClientScriptGlobal>(&packets, peer);
     AddPacket<PacketClientScriptSettings>(&packets, peer);
+    AddPacket<PacketRecordCache>(&packets, peer);
     AddPacket<PacketRecordDynamic>(&packets, peer);
     AddPacket<PacketWorldCollisionOverride>(&packets, peer);
     AddPacket<PacketWorldDestinationOverride>(&packets, peer);
@@ -38,21 +39,19 @@ mwmp::WorldstatePacketController::WorldstatePacketController(RakNet::RakPeerInte
 
 mwmp::WorldstatePacket *mwmp::WorldstatePacketController::GetPacket(RakNet::MessageID id)
 {
-    return packets[(unsigned char)id].get();
+    return packets[id].get();
 }
 
 void mwmp::WorldstatePacketController::SetStream(RakNet::BitStream *inStream, RakNet::BitStream *outStream)
 {
     for(const auto &packet : packets)
-        packet.second->SetStreams(inStream, outStream);
+    {
+        if (packet)
+            packet->SetStreams(inStream, outStream);
+    }
 }
 
 bool mwmp::WorldstatePacketController::ContainsPacket(RakNet::MessageID id)
 {
-    for(const auto &packet : packets)
-    {
-        if (packet.first == id)
-            return true;
-    }
-    return false;
+    return packets[id] != nullptr;
 }
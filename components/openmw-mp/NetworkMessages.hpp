@@ -113,6 +113,11 @@ enum GameMessages
     ID_WORLD_DESTINATION_OVERRIDE,
     ID_ACTOR_SPELLS_ACTIVE,
     ID_PLAYER_COOLDOWNS,
+    ID_PACKET_BATCH,
+    ID_ACTOR_SNAPSHOT,
+    ID_ACTOR_UPDATE,
+    ID_RECORD_CACHE,
+    ID_SYSTEM_RECORD_ID_RESET,
     ID_PLACEHOLDER
 };
 
@@ -123,7 +128,8 @@ enum OrderingChannel
     CHANNEL_PLAYER,
     CHANNEL_OBJECT,
     CHANNEL_MASTER,
-    CHANNEL_WORLDSTATE
+    CHANNEL_WORLDSTATE,
+    CHANNEL_WORLDMAP
 };
 
 
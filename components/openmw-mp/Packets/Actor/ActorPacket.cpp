@@ -37,8 +37,8 @@ void ActorPacket::Packet(RakNet::BitStream *newBitstream, bool send)
         if (send)
             actor = actorList->baseActors.at(i);
 
-        RW(actor.refNum, send);
-        RW(actor.mpNum, send);
+        RWVarint(actor.refNum, send);
+        RWVarint(actor.mpNum, send);
 
         Actor(actor, send);
 
@@ -59,7 +59,7 @@ bool ActorPacket::PacketHeader(RakNet::BitStream *newBitstream, bool send)
     else
         actorList->baseActors.clear();
 
-    RW(actorList->count, send);
+    RWVarint(actorList->count, send);
 
     if (actorList->count > maxActors)
     {
@@ -75,3 +75,102 @@ void ActorPacket::Actor(BaseActor &actor, bool send)
 {
 
 }
+
+void ActorPacket::ActorAttack(BaseActor &actor, bool send)
+{
+    RW(actor.attack.target.isPlayer, send);
+
+    if (actor.attack.target.isPlayer)
+    {
+        RW(actor.attack.target.guid, send);
+    }
+    else
+    {
+        RW(actor.attack.target.refId, send, true);
+        RWVarint(actor.attack.target.refNum, send);
+        RWVarint(actor.attack.target.mpNum, send);
+    }
+
+    RW(actor.attack.type, send);
+
+    RW(actor.attack.pressed, send);
+    RW(actor.attack.success, send);
+
+    RW(actor.attack.isHit, send);
+
+    if (actor.attack.type == mwmp::Attack::MELEE)
+    {
+        RW(actor.attack.attackAnimation, send, true);
+    }
+    else if (actor.attack.type == mwmp::Attack::RANGED)
+    {
+        RWQuantized(actor.attack.attackStrength, 0, 1, 16, send);
+        RW(actor.attack.rangedWeaponId, send, true);
+        RW(actor.attack.rangedAmmoId, send, true);
+
+        RW(actor.attack.projectileOrigin.origin[0], send);
+        RW(actor.attack.projectileOrigin.origin[1], send);
+        RW(actor.attack.projectileOrigin.origin[2], send);
+        RW(actor.attack.projectileOrigin.orientation[0], send);
+        RW(actor.attack.projectileOrigin.orientation[1], send);
+        RW(actor.attack.projectileOrigin.orientation[2], send);
+        RW(actor.attack.projectileOrigin.orientation[3], send);
+    }
+
+    if (actor.attack.isHit)
+    {
+        RW(actor.attack.damage, send);
+        RW(actor.attack.block, send);
+        RW(actor.attack.knockdown, send);
+        RW(actor.attack.applyWeaponEnchantment, send);
+
+        if (actor.attack.type == mwmp::Attack::RANGED)
+            RW(actor.attack.applyAmmoEnchantment, send);
+
+        RW(actor.attack.hitPosition.pos[0], send);
+        RW(actor.attack.hitPosition.pos[1], send);
+        RW(actor.attack.hitPosition.pos[2], send);
+    }
+}
+
+void ActorPacket::ActorCast(BaseActor &actor, bool send)
+{
+    RW(actor.cast.target.isPlayer, send);
+
+    if (actor.cast.target.isPlayer)
+    {
+        RW(actor.cast.target.guid, send);
+    }
+    else
+    {
+        RW(actor.cast.target.refId, send, true);
+        RWVarint(actor.cast.target.refNum, send);
+        RWVarint(actor.cast.target.mpNum, send);
+    }
+
+    RW(actor.cast.type, send);
+
+    if (actor.cast.type == mwmp::Cast::ITEM)
+        RW(actor.cast.itemId, send, true);
+    else
+    {
+        RW(actor.cast.pressed, send);
+        RW(actor.cast.success, send);
+
+        RW(actor.cast.instant, send);
+        RW(actor.cast.spellId, send, true);
+    }
+
+    RW(actor.cast.hasProjectile, send);
+
+    if (actor.cast.hasProjectile)
+    {
+        RW(actor.cast.projectileOrigin.origin[0], send);
+        RW(actor.cast.projectileOrigin.origin[1], send);
+        RW(actor.cast.projectileOrigin.origin[2], send);
+        RW(actor.cast.projectileOrigin.orientation[0], send);
+        RW(actor.cast.projectileOrigin.orientation[1], send);
+        RW(actor.cast.projectileOrigin.orientation[2], send);
+        RW(actor.cast.projectileOrigin.orientation[3], send);
+    }
+}
@@ -25,6 +25,9 @@ namespace mwmp
     protected:
         bool PacketHeader(RakNet::BitStream *newBitstream, bool send);
         virtual void Actor(BaseActor &actor, bool send);
+        // Shared by the packets that carry attacks and casts on their own and as part of other data
+        void ActorAttack(BaseActor &actor, bool send);
+        void ActorCast(BaseActor &actor, bool send);
         BaseActorList *actorList;
         static const int maxActors = 3000;
     };
@@ -1,5 +1,7 @@
+#include <components/openmw-mp/ActorKey.hpp>
 #include <components/openmw-mp/NetworkMessages.hpp>
 #include <components/openmw-mp/TimedLog.hpp>
+#include <components/openmw-mp/Packets/PositionDeltaState.hpp>
 #include "PacketActorPosition.hpp"
 
 using namespace mwmp;
@@ -9,10 +11,68 @@ PacketActorPosition::PacketActorPosition(RakNet::RakPeerInterface *peer) : Actor
     packetID = ID_ACTOR_POSITION;
 }
 
+void PacketActorPosition::Packet(RakNet::BitStream *newBitstream, bool send)
+{
+    if (!PacketHeader(newBitstream, send))
+        return;
+
+    RW(actorList->timestamp, send);
+
+    isDeltaEncoded = deltaState != nullptr;
+    RW(isDeltaEncoded, send);
+
+    if (isDeltaEncoded && deltaState == nullptr)
+    {
+        packetValid = false;
+        actorList->isValid = false;
+        return;
+    }
+
+    BaseActor actor;
+
+    for (unsigned int i = 0; i < actorList->count; i++)
+    {
+        if (send)
+            actor = actorList->baseActors.at(i);
+
+        RWVarint(actor.refNum, send);
+        RWVarint(actor.mpNum, send);
+
+        Actor(actor, send);
+
+        if (!packetValid)
+            return;
+
+        // Leave out actors whose deltas are based on a keyframe we never read
+        if (!send && actor.hasPositionData)
+            actorList->baseActors.push_back(actor);
+    }
+
+    if (!send)
+        actorList->count = (unsigned int)(actorList->baseActors.size());
+}
+
 void PacketActorPosition::Actor(BaseActor &actor, bool send)
 {
-    RW(actor.position, send, true);
-    RW(actor.direction, send, true);
+    if (isDeltaEncoded)
+    {
+        ActorKey actorKey = getActorKey(actor.refNum, actor.mpNum);
 
-    actor.hasPositionData = true;
+        if (send)
+            deltaState->write(bs, actorKey, actor.position);
+        else if (!deltaState->read(bs, actorKey, actor.position, actor.hasPositionData))
+        {
+            packetValid = false;
+            actorList->isValid = false;
+            actor.hasPositionData = false;
+            return;
+        }
+    }
+    else
+    {
+        RW(actor.position, send, true);
+        actor.hasPositionData = true;
+    }
+
+    RW(actor.direction, send, true);
 }
@@ -10,7 +10,16 @@ namespace mwmp
     public:
         PacketActorPosition(RakNet::RakPeerInterface *peer);
 
+        virtual void Packet(RakNet::BitStream *newBitstream, bool send);
         virtual void Actor(BaseActor &actor, bool send);
+
+        virtual bool usesDeltaState() const
+        {
+            return true;
+        }
+
+    private:
+        bool isDeltaEncoded;
     };
 }
 
@@ -0,0 +1,49 @@
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/TimedLog.hpp>
+#include "PacketActorSnapshot.hpp"
+
+using namespace mwmp;
+
+PacketActorSnapshot::PacketActorSnapshot(RakNet::RakPeerInterface *peer) : ActorPacket(peer)
+{
+    packetID = ID_ACTOR_SNAPSHOT;
+}
+
+void PacketActorSnapshot::Packet(RakNet::BitStream *newBitstream, bool send)
+{
+    if (!PacketHeader(newBitstream, send))
+        return;
+
+    RW(actorList->timestamp, send);
+
+    BaseActor actor;
+
+    for (unsigned int i = 0; i < actorList->count; i++)
+    {
+        if (send)
+            actor = actorList->baseActors.at(i);
+
+        RWVarint(actor.refNum, send);
+        RWVarint(actor.mpNum, send);
+
+        Actor(actor, send);
+
+        if (!send)
+            actorList->baseActors.push_back(actor);
+    }
+}
+
+void PacketActorSnapshot::Actor(BaseActor &actor, bool send)
+{
+    RW(actor.hasPositionData, send);
+    RW(actor.hasStatsDynamicData, send);
+
+    if (actor.hasPositionData)
+    {
+        RW(actor.position, send, true);
+        RW(actor.direction, send, true);
+    }
+
+    if (actor.hasStatsDynamicData)
+        RW(actor.creatureStats.mDynamic, send);
+}
@@ -0,0 +1,25 @@
+#ifndef OPENMW_PACKETACTORSNAPSHOT_HPP
+#define OPENMW_PACKETACTORSNAPSHOT_HPP
+
+#include <components/openmw-mp/Packets/Actor/ActorPacket.hpp>
+
+namespace mwmp
+{
+    /*
+        The last known positions and dynamic stats of a cell's actors, sent by the server to a player
+        who has just loaded the cell, with each actor only carrying the data the server has for it
+
+        The snapshot carries the same kind of server timestamp as ID_ACTOR_POSITION, so the positions
+        sent after it can be interpolated from the ones in it
+    */
+    class PacketActorSnapshot : public ActorPacket
+    {
+    public:
+        PacketActorSnapshot(RakNet::RakPeerInterface *peer);
+
+        virtual void Packet(RakNet::BitStream *newBitstream, bool send);
+        virtual void Actor(BaseActor &actor, bool send);
+    };
+}
+
+#endif //OPENMW_PACKETACTORSNAPSHOT_HPP
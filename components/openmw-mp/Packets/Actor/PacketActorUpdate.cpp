@@ -0,0 +1,44 @@
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include "PacketActorUpdate.hpp"
+
+using namespace mwmp;
+
+PacketActorUpdate::PacketActorUpdate(RakNet::RakPeerInterface *peer) : ActorPacket(peer)
+{
+    packetID = ID_ACTOR_UPDATE;
+}
+
+void PacketActorUpdate::Actor(BaseActor &actor, bool send)
+{
+    RWBits(actor.updateFlags, 6, send);
+
+    if (actor.updateFlags & BaseActor::UPDATE_ANIM_FLAGS)
+    {
+        RW(actor.movementFlags, send);
+        RW(actor.drawState, send);
+        RW(actor.isFlying, send);
+    }
+
+    if (actor.updateFlags & BaseActor::UPDATE_ANIM_PLAY)
+    {
+        RW(actor.animation.groupname, send);
+        RW(actor.animation.mode, send);
+        RW(actor.animation.count, send);
+        RW(actor.animation.persist, send);
+    }
+
+    if (actor.updateFlags & BaseActor::UPDATE_SPEECH)
+        RW(actor.sound, send);
+
+    if (actor.updateFlags & BaseActor::UPDATE_STATS_DYNAMIC)
+    {
+        RW(actor.creatureStats.mDynamic, send);
+        actor.hasStatsDynamicData = true;
+    }
+
+    if (actor.updateFlags & BaseActor::UPDATE_ATTACK)
+        ActorAttack(actor, send);
+
+    if (actor.updateFlags & BaseActor::UPDATE_CAST)
+        ActorCast(actor, send);
+}
@@ -0,0 +1,24 @@
+#ifndef OPENMW_PACKETACTORUPDATE_HPP
+#define OPENMW_PACKETACTORUPDATE_HPP
+
+#include <components/openmw-mp/Packets/Actor/ActorPacket.hpp>
+
+namespace mwmp
+{
+    /*
+        The changes to a cell's actors during a single update, with each actor carrying a set of
+        update flags followed by only the parts of it that the flags say have changed
+
+        Positions are left to ID_ACTOR_POSITION, because they are delta encoded separately for every
+        connection, and events that scripts are told about keep their own packets
+    */
+    class PacketActorUpdate : public ActorPacket
+    {
+    public:
+        PacketActorUpdate(RakNet::RakPeerInterface *peer);
+
+        virtual void Actor(BaseActor &actor, bool send);
+    };
+}
+
+#endif //OPENMW_PACKETACTORUPDATE_HPP
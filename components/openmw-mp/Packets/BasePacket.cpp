@@ -2,15 +2,21 @@
 #include <PacketPriority.h>
 #include <RakPeer.h>
 #include "BasePacket.hpp"
+#include "RecordIdState.hpp"
 
 using namespace mwmp;
 
+BasePacket::BeforeSendCallback BasePacket::beforeSendCallback = nullptr;
+
 BasePacket::BasePacket(RakNet::RakPeerInterface *peer)
 {
     packetID = 0;
     priority = HIGH_PRIORITY;
     reliability = RELIABLE_ORDERED;
     orderChannel = CHANNEL_SYSTEM;
+    deltaState = nullptr;
+    recordIdState = nullptr;
+    isRecordIdEncoded = false;
     this->peer = peer;
 }
 
@@ -44,11 +50,78 @@ void BasePacket::SetStreams(RakNet::BitStream *inStream, RakNet::BitStream *outS
         bsSend = outStream;
 }
 
+void BasePacket::setDeltaState(PositionDeltaState *state)
+{
+    deltaState = state;
+}
+
+void BasePacket::setRecordIdState(RecordIdState *state)
+{
+    recordIdState = state;
+}
+
+bool BasePacket::RecordIdHeader(bool send)
+{
+    if (send)
+        isRecordIdEncoded = recordIdState != nullptr && recordIdState->isWriting();
+
+    RW(isRecordIdEncoded, send);
+
+    if (!isRecordIdEncoded)
+        return true;
+
+    if (recordIdState == nullptr)
+    {
+        packetValid = false;
+        return false;
+    }
+
+    uint8_t epoch;
+
+    if (send)
+        epoch = recordIdState->getWriteEpoch();
+
+    RW(epoch, send);
+
+    // Packets sent before the tables were last reset can't be read with them
+    if (!send && !recordIdState->isReadEpoch(epoch))
+    {
+        packetValid = false;
+        return false;
+    }
+
+    return true;
+}
+
+bool BasePacket::RWRecordId(std::string &refId, bool send)
+{
+    if (!isRecordIdEncoded)
+        return RW(refId, send, true);
+
+    if (send)
+    {
+        recordIdState->write(bs, orderChannel, refId);
+        return true;
+    }
+
+    if (!recordIdState->read(bs, orderChannel, refId))
+    {
+        packetValid = false;
+        return false;
+    }
+
+    return true;
+}
+
 uint32_t BasePacket::RequestData(RakNet::RakNetGUID targetGuid)
 {
     bsSend->ResetWritePointer();
     bsSend->Write(packetID);
     bsSend->Write(targetGuid);
+
+    if (beforeSendCallback)
+        beforeSendCallback(targetGuid, false, orderChannel);
+
     return peer->Send(bsSend, HIGH_PRIORITY, RELIABLE_ORDERED, orderChannel, targetGuid, false);
 }
 
@@ -56,6 +129,10 @@ uint32_t BasePacket::Send(RakNet::AddressOrGUID destination)
 {
     bsSend->ResetWritePointer();
     Packet(bsSend, true);
+
+    if (beforeSendCallback)
+        beforeSendCallback(destination, false, orderChannel);
+
     return peer->Send(bsSend, priority, reliability, orderChannel, destination, false);
 }
 
@@ -63,9 +140,40 @@ uint32_t BasePacket::Send(bool toOther)
 {
     bsSend->ResetWritePointer();
     Packet(bsSend, true);
+
+    if (beforeSendCallback)
+        beforeSendCallback(guid, toOther, orderChannel);
+
     return peer->Send(bsSend, priority, reliability, orderChannel, guid, toOther);
 }
 
+SerializedPacketPtr BasePacket::Serialize()
+{
+    bsSend->ResetWritePointer();
+    Packet(bsSend, true);
+
+    auto serializedPacket = std::make_shared<SerializedPacket>();
+    serializedPacket->data.assign(bsSend->GetData(), bsSend->GetData() + bsSend->GetNumberOfBytesUsed());
+    serializedPacket->priority = priority;
+    serializedPacket->reliability = reliability;
+    serializedPacket->orderChannel = orderChannel;
+    return serializedPacket;
+}
+
+uint32_t BasePacket::Send(const SerializedPacketPtr &serializedPacket, RakNet::AddressOrGUID destination)
+{
+    if (beforeSendCallback)
+        beforeSendCallback(destination, false, serializedPacket->orderChannel);
+
+    return peer->Send(reinterpret_cast<const char *>(serializedPacket->data.data()), (int) serializedPacket->data.size(),
+        serializedPacket->priority, serializedPacket->reliability, serializedPacket->orderChannel, destination, false);
+}
+
+void BasePacket::setBeforeSendCallback(BeforeSendCallback callback)
+{
+    beforeSendCallback = callback;
+}
+
 void BasePacket::Read()
 {
     Packet(bsRead, false);
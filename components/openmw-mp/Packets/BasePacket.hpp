@@ -1,14 +1,33 @@
 #ifndef OPENMW_BASEPACKET_HPP
 #define OPENMW_BASEPACKET_HPP
 
+#include <memory>
 #include <string>
+#include <vector>
 #include <RakNetTypes.h>
 #include <BitStream.h>
 #include <PacketPriority.h>
 
+#include "PacketEncoding.hpp"
+
 
 namespace mwmp
 {
+    // A packet body that has already been serialized, so it can be handed to any number of
+    // recipients without running Packet() again for each of them
+    struct SerializedPacket
+    {
+        std::vector<unsigned char> data;
+        PacketPriority priority;
+        PacketReliability reliability;
+        int8_t orderChannel;
+    };
+
+    typedef std::shared_ptr<const SerializedPacket> SerializedPacketPtr;
+
+    class PositionDeltaState;
+    class RecordIdState;
+
     class BasePacket
     {
     public:
@@ -21,14 +40,37 @@ namespace mwmp
         virtual uint32_t Send(RakNet::AddressOrGUID destination);
         virtual void Read();
 
+        SerializedPacketPtr Serialize();
+        uint32_t Send(const SerializedPacketPtr &serializedPacket, RakNet::AddressOrGUID destination);
+
         void setGUID(RakNet::RakNetGUID newGuid);
         RakNet::RakNetGUID getGUID();
 
         void SetReadStream(RakNet::BitStream *bitStream);
         void SetSendStream(RakNet::BitStream *bitStream);
         void SetStreams(RakNet::BitStream *inStream, RakNet::BitStream *outStream);
+
+        // Packets using a delta state are encoded differently for every connection, so they
+        // can't be serialized once and sent to several recipients
+        void setDeltaState(PositionDeltaState *state);
+        virtual bool usesDeltaState() const
+        {
+            return false;
+        }
+        // The same goes for packets sending record ids through a record id state
+        void setRecordIdState(RecordIdState *state);
+        virtual bool usesRecordIdState() const
+        {
+            return false;
+        }
         virtual uint32_t RequestData(RakNet::RakNetGUID targetGuid);
 
+        // Called before any packet is sent right away, with whether it goes to everyone but the
+        // destination, so packets held back to be sent later on the same ordering channel can be
+        // sent first and don't arrive after it
+        typedef void (*BeforeSendCallback)(const RakNet::AddressOrGUID &destination, bool broadcast, int8_t orderChannel);
+        static void setBeforeSendCallback(BeforeSendCallback callback);
+
         static inline uint32_t headerSize()
         {
             return static_cast<uint32_t>(1 + RakNet::RakNetGUID::size()); // packetID + RakNetGUID (uint64_t)
@@ -84,6 +126,70 @@ namespace mwmp
             return true;
         }
 
+        // Unsigned integers that are usually small, such as counts and reference numbers
+        template<class templateType>
+        bool RWVarint(templateType &data, bool write)
+        {
+            if (write)
+            {
+                PacketEncoding::writeVarint(bs, data);
+                return true;
+            }
+
+            return PacketEncoding::readVarint(bs, data);
+        }
+
+        // Signed integers that are usually close to 0, including small negative ones
+        template<class templateType>
+        bool RWZigZag(templateType &data, bool write)
+        {
+            typename std::make_unsigned<templateType>::type encoded;
+
+            if (write)
+            {
+                encoded = PacketEncoding::zigZagEncode(data);
+                PacketEncoding::writeVarint(bs, encoded);
+                return true;
+            }
+
+            if (!PacketEncoding::readVarint(bs, encoded))
+                return false;
+
+            data = PacketEncoding::zigZagDecode<templateType>(encoded);
+            return true;
+        }
+
+        // Unsigned integers, such as actions and flags, that always fit in the given number of bits
+        template<class templateType>
+        bool RWBits(templateType &data, unsigned int bits, bool write)
+        {
+            uint32_t value;
+
+            if (write)
+            {
+                PacketEncoding::writeBits(bs, (uint32_t) data, bits);
+                return true;
+            }
+
+            if (!PacketEncoding::readBits(bs, value, bits))
+                return false;
+
+            data = (templateType) value;
+            return true;
+        }
+
+        // Floats that stay within a known range and can afford to lose precision
+        bool RWQuantized(float &data, float min, float max, unsigned int bits, bool write)
+        {
+            if (write)
+            {
+                PacketEncoding::writeQuantized(bs, data, min, max, bits);
+                return true;
+            }
+
+            return PacketEncoding::readQuantized(bs, data, min, max, bits);
+        }
+
         const static uint32_t maxStrSize = 64 * 1024; // 64 KiB
 
         bool RW(std::string &str, bool write, bool compress = false, std::string::size_type maxSize = maxStrSize)
@@ -120,6 +226,11 @@ namespace mwmp
         }
 
     protected:
+        // Read or write whether the packet's record ids go through the record id state, and with
+        // which epoch, returning false if they do but can't be read with the state
+        bool RecordIdHeader(bool send);
+        bool RWRecordId(std::string &refId, bool send);
+
         uint8_t packetID;
         PacketReliability reliability;
         PacketPriority priority;
@@ -128,6 +239,11 @@ namespace mwmp
         RakNet::RakPeerInterface *peer;
         RakNet::RakNetGUID guid;
         bool packetValid;
+        PositionDeltaState *deltaState;
+        RecordIdState *recordIdState;
+        bool isRecordIdEncoded;
+
+        static BeforeSendCallback beforeSendCallback;
     };
 }
 
@@ -58,7 +58,7 @@ bool ObjectPacket::PacketHeader(RakNet::BitStream *newBitstream, bool send)
     else
         objectList->baseObjects.clear();
 
-    RW(objectList->baseObjectCount, send);
+    RWVarint(objectList->baseObjectCount, send);
 
     if (objectList->baseObjectCount > maxObjects)
     {
@@ -78,6 +78,6 @@ bool ObjectPacket::PacketHeader(RakNet::BitStream *newBitstream, bool send)
 void ObjectPacket::Object(BaseObject &baseObject, bool send)
 {
     RW(baseObject.refId, send, true);
-    RW(baseObject.refNum, send);
-    RW(baseObject.mpNum, send);
+    RWVarint(baseObject.refNum, send);
+    RWVarint(baseObject.mpNum, send);
 }
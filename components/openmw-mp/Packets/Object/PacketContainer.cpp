@@ -15,8 +15,14 @@ void PacketContainer::Packet(RakNet::BitStream *newBitstream, bool send)
     if (!PacketHeader(newBitstream, send))
         return;
 
-    RW(objectList->action, send);
-    RW(objectList->containerSubAction, send);
+    RWBits(objectList->action, 2, send);
+    RWBits(objectList->containerSubAction, 3, send);
+
+    if (!RecordIdHeader(send))
+    {
+        objectList->isValid = false;
+        return;
+    }
 
     BaseObject baseObject;
     for (unsigned int i = 0; i < objectList->baseObjectCount; i++)
@@ -31,7 +37,7 @@ void PacketContainer::Packet(RakNet::BitStream *newBitstream, bool send)
 
         Object(baseObject, send);
 
-        RW(baseObject.containerItemCount, send);
+        RWVarint(baseObject.containerItemCount, send);
 
         if (baseObject.containerItemCount > maxObjects || baseObject.refId.empty() || (baseObject.refNum != 0 && baseObject.mpNum != 0))
         {
@@ -46,12 +52,17 @@ void PacketContainer::Packet(RakNet::BitStream *newBitstream, bool send)
             if (send)
                 containerItem = baseObject.containerItems.at(j);
 
-            RW(containerItem.refId, send, true);
-            RW(containerItem.count, send);
-            RW(containerItem.charge, send);
+            if (!RWRecordId(containerItem.refId, send))
+            {
+                objectList->isValid = false;
+                return;
+            }
+
+            RWZigZag(containerItem.count, send);
+            RWZigZag(containerItem.charge, send);
             RW(containerItem.enchantmentCharge, send);
             RW(containerItem.soul, send, true);
-            RW(containerItem.actionCount, send);
+            RWZigZag(containerItem.actionCount, send);
 
             if (!send)
                 baseObject.containerItems.push_back(containerItem);
@@ -11,6 +11,11 @@ namespace mwmp
         PacketContainer(RakNet::RakPeerInterface *peer);
 
         virtual void Packet(RakNet::BitStream *newBitstream, bool send);
+
+        virtual bool usesRecordIdState() const
+        {
+            return true;
+        }
     };
 }
 
@@ -0,0 +1,131 @@
+#ifndef OPENMW_PACKETENCODING_HPP
+#define OPENMW_PACKETENCODING_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <BitStream.h>
+
+namespace mwmp
+{
+    /*
+        Compact encodings for single packet fields, which each packet picks per field in its Packet()
+        through BasePacket's RWVarint, RWZigZag, RWQuantized and RWBits
+
+        None of them are aligned to bytes, so they can be mixed freely with the full width ones
+    */
+    namespace PacketEncoding
+    {
+        // Unsigned integers seven bits at a time, with the highest bit of each byte set when more
+        // bytes follow, so values below 128 only take up a single byte
+        template<class T>
+        void writeVarint(RakNet::BitStream *bs, T value)
+        {
+            static_assert(std::is_unsigned<T>::value, "Varints can only hold unsigned integers");
+
+            while (value >= 0x80)
+            {
+                bs->Write((uint8_t) ((value & 0x7F) | 0x80));
+                value >>= 7;
+            }
+
+            bs->Write((uint8_t) value);
+        }
+
+        template<class T>
+        bool readVarint(RakNet::BitStream *bs, T &value)
+        {
+            static_assert(std::is_unsigned<T>::value, "Varints can only hold unsigned integers");
+
+            value = 0;
+
+            for (unsigned int shift = 0; shift < sizeof(T) * 8; shift += 7)
+            {
+                uint8_t byte;
+
+                if (!bs->Read(byte))
+                    return false;
+
+                value |= (T) ((T) (byte & 0x7F) << shift);
+
+                if ((byte & 0x80) == 0)
+                    return true;
+            }
+
+            // More bytes followed than the type can hold
+            return false;
+        }
+
+        // Signed integers interleaved as 0, -1, 1, -2, 2..., so small negative values also end up
+        // as small varints
+        template<class T>
+        typename std::make_unsigned<T>::type zigZagEncode(T value)
+        {
+            typedef typename std::make_unsigned<T>::type Unsigned;
+            return (Unsigned) ((Unsigned) ((Unsigned) value << 1) ^ (Unsigned) (value < 0 ? ~Unsigned(0) : 0));
+        }
+
+        template<class T>
+        T zigZagDecode(typename std::make_unsigned<T>::type value)
+        {
+            typedef typename std::make_unsigned<T>::type Unsigned;
+            return (T) (Unsigned) ((value >> 1) ^ (Unsigned) (0 - (value & 1)));
+        }
+
+        // The lowest bits of an unsigned integer, written a byte at a time so the result doesn't
+        // depend on the endianness of either side
+        inline void writeBits(RakNet::BitStream *bs, uint32_t value, unsigned int bits)
+        {
+            for (unsigned int written = 0; written < bits; written += 8)
+            {
+                const unsigned char byte = (unsigned char) (value >> written);
+                bs->WriteBits(&byte, bits - written < 8 ? bits - written : 8, true);
+            }
+        }
+
+        inline bool readBits(RakNet::BitStream *bs, uint32_t &value, unsigned int bits)
+        {
+            value = 0;
+
+            for (unsigned int read = 0; read < bits; read += 8)
+            {
+                unsigned char byte = 0;
+
+                if (!bs->ReadBits(&byte, bits - read < 8 ? bits - read : 8, true))
+                    return false;
+
+                value |= (uint32_t) byte << read;
+            }
+
+            return true;
+        }
+
+        // Floats known to stay between min and max, stored as one of 2^bits evenly spaced steps
+        // between them, with anything outside of the range clamped to it
+        inline void writeQuantized(RakNet::BitStream *bs, float value, float min, float max, unsigned int bits)
+        {
+            const double steps = (double) ((1ull << bits) - 1);
+
+            if (!(value >= min)) // Also catches NaN
+                value = min;
+            else if (value > max)
+                value = max;
+
+            writeBits(bs, (uint32_t) std::llround((value - min) / ((double) max - min) * steps), bits);
+        }
+
+        inline bool readQuantized(RakNet::BitStream *bs, float &value, float min, float max, unsigned int bits)
+        {
+            const double steps = (double) ((1ull << bits) - 1);
+            uint32_t step;
+
+            if (!readBits(bs, step, bits))
+                return false;
+
+            value = (float) (min + step / steps * ((double) max - min));
+            return true;
+        }
+    }
+}
+
+#endif //OPENMW_PACKETENCODING_HPP
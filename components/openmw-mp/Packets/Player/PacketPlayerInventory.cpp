@@ -12,14 +12,17 @@ void PacketPlayerInventory::Packet(RakNet::BitStream *newBitstream, bool send)
 {
     PlayerPacket::Packet(newBitstream, send);
 
-    RW(player->inventoryChanges.action, send);
+    RWBits(player->inventoryChanges.action, 2, send);
+
+    if (!RecordIdHeader(send))
+        return;
 
     uint32_t count;
 
     if (send)
         count = static_cast<uint32_t>(player->inventoryChanges.items.size());
 
-    RW(count, send);
+    RWVarint(count, send);
 
     if (!send)
     {
@@ -29,9 +32,11 @@ void PacketPlayerInventory::Packet(RakNet::BitStream *newBitstream, bool send)
 
     for (auto &&item : player->inventoryChanges.items)
     {
-        RW(item.refId, send, true);
-        RW(item.count, send);
-        RW(item.charge, send);
+        if (!RWRecordId(item.refId, send))
+            return;
+
+        RWZigZag(item.count, send);
+        RWZigZag(item.charge, send);
         RW(item.enchantmentCharge, send);
         RW(item.soul, send, true);
     }
@@ -1,5 +1,6 @@
 #include "PacketPlayerPosition.hpp"
 #include <components/openmw-mp/NetworkMessages.hpp>
+#include <components/openmw-mp/Packets/PositionDeltaState.hpp>
 
 using namespace mwmp;
 
@@ -14,6 +15,35 @@ void PacketPlayerPosition::Packet(RakNet::BitStream *newBitstream, bool send)
 {
     PlayerPacket::Packet(newBitstream, send);
 
-    RW(player->position, send, 1);
+    RW(player->positionTimestamp, send);
+
+    bool isDeltaEncoded = deltaState != nullptr;
+    RW(isDeltaEncoded, send);
+
+    if (isDeltaEncoded)
+    {
+        if (deltaState == nullptr)
+        {
+            packetValid = false;
+            return;
+        }
+
+        if (send)
+            deltaState->write(bs, guid.g, player->position);
+        else
+        {
+            bool hasPosition;
+
+            // Ignore the packet if it is based on a keyframe we never read
+            if (!deltaState->read(bs, guid.g, player->position, hasPosition) || !hasPosition)
+            {
+                packetValid = false;
+                return;
+            }
+        }
+    }
+    else
+        RW(player->position, send, 1);
+
     RW(player->direction, send, 1);
 }
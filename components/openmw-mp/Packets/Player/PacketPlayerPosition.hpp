@@ -11,6 +11,11 @@ namespace mwmp
         PacketPlayerPosition(RakNet::RakPeerInterface *peer);
 
         virtual void Packet(RakNet::BitStream *newBitstream, bool send);
+
+        virtual bool usesDeltaState() const
+        {
+            return true;
+        }
     };
 }
 
@@ -0,0 +1,150 @@
+#include <cmath>
+#include "PositionDeltaState.hpp"
+
+using namespace mwmp;
+
+namespace
+{
+    // Positions are quantized to an eighth of a unit and rotations to 1/65536 of a turn
+    const float positionScale = 8.0f;
+    const float pi = 3.14159265358979323846f;
+    const float rotationScale = 65536.0f / (2.0f * pi);
+
+    // Larger movements, such as teleports, are sent as keyframes
+    const int32_t maxPositionDelta = 1 << 20;
+
+    const unsigned int keyframeInterval = 30;
+}
+
+void PositionDeltaState::write(RakNet::BitStream *bs, uint64_t entity, const ESM::Position &position)
+{
+    auto it = sentKeyframes.find(entity);
+
+    int32_t positionDeltas[3];
+    int16_t rotationDeltas[3];
+
+    bool isKeyframe = it == sentKeyframes.end() || it->second.deltasSinceKeyframe >= keyframeInterval ||
+        !getDeltas(it->second.position, position, positionDeltas, rotationDeltas);
+
+    bs->Write(isKeyframe);
+
+    if (isKeyframe)
+    {
+        uint8_t keyframeId = it == sentKeyframes.end() ? 0 : it->second.id + 1;
+
+        Keyframe &keyframe = sentKeyframes[entity];
+        keyframe.position = position;
+        keyframe.id = keyframeId;
+        keyframe.deltasSinceKeyframe = 0;
+
+        bs->Write(keyframe.id);
+        bs->Write(keyframe.position);
+    }
+    else
+    {
+        bs->Write(it->second.id);
+
+        for (int i = 0; i < 3; i++)
+            bs->WriteCompressed(positionDeltas[i]);
+
+        for (int i = 0; i < 3; i++)
+            bs->WriteCompressed(rotationDeltas[i]);
+
+        it->second.deltasSinceKeyframe++;
+    }
+}
+
+bool PositionDeltaState::read(RakNet::BitStream *bs, uint64_t entity, ESM::Position &position, bool &hasPosition)
+{
+    bool isKeyframe;
+    uint8_t keyframeId;
+
+    if (!bs->Read(isKeyframe) || !bs->Read(keyframeId))
+        return false;
+
+    if (isKeyframe)
+    {
+        Keyframe keyframe;
+
+        if (!bs->Read(keyframe.position))
+            return false;
+
+        keyframe.id = keyframeId;
+        keyframe.deltasSinceKeyframe = 0;
+        receivedKeyframes[entity] = keyframe;
+
+        position = keyframe.position;
+        hasPosition = true;
+        return true;
+    }
+
+    int32_t positionDeltas[3];
+    int16_t rotationDeltas[3];
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (!bs->ReadCompressed(positionDeltas[i]))
+            return false;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        if (!bs->ReadCompressed(rotationDeltas[i]))
+            return false;
+    }
+
+    auto it = receivedKeyframes.find(entity);
+
+    if (it == receivedKeyframes.end() || it->second.id != keyframeId)
+    {
+        hasPosition = false;
+        return true;
+    }
+
+    const ESM::Position &keyframePosition = it->second.position;
+
+    for (int i = 0; i < 3; i++)
+    {
+        position.pos[i] = keyframePosition.pos[i] + positionDeltas[i] / positionScale;
+
+        float rotation = keyframePosition.rot[i] + rotationDeltas[i] / rotationScale;
+
+        // Rotation deltas wrap around, so keep the result within the range of the original angle
+        if (rotation > pi)
+            rotation -= 2.0f * pi;
+        else if (rotation < -pi)
+            rotation += 2.0f * pi;
+
+        position.rot[i] = rotation;
+    }
+
+    hasPosition = true;
+    return true;
+}
+
+void PositionDeltaState::clear()
+{
+    sentKeyframes.clear();
+    receivedKeyframes.clear();
+}
+
+bool PositionDeltaState::getDeltas(const ESM::Position &keyframePosition, const ESM::Position &position,
+    int32_t positionDeltas[3], int16_t rotationDeltas[3])
+{
+    for (int i = 0; i < 3; i++)
+    {
+        float positionDelta = std::round((position.pos[i] - keyframePosition.pos[i]) * positionScale);
+        float rotationDelta = std::round((position.rot[i] - keyframePosition.rot[i]) * rotationScale);
+
+        if (!std::isfinite(positionDelta) || !std::isfinite(rotationDelta) ||
+            std::abs(positionDelta) > maxPositionDelta || std::abs(rotationDelta) > maxPositionDelta)
+            return false;
+
+        positionDeltas[i] = static_cast<int32_t>(positionDelta);
+
+        // Truncating to 16 bits wraps the rotation delta around a full turn
+        rotationDeltas[i] = static_cast<int16_t>(static_cast<uint16_t>(static_cast<int32_t>(rotationDelta)));
+    }
+
+    return true;
+}
@@ -0,0 +1,48 @@
+#ifndef OPENMW_POSITIONDELTASTATE_HPP
+#define OPENMW_POSITIONDELTASTATE_HPP
+
+#include <cstdint>
+#include <unordered_map>
+#include <BitStream.h>
+#include <components/esm/defs.hpp>
+
+namespace mwmp
+{
+    /*
+        The position keyframes exchanged with a single connection, in both directions, used to
+        encode positions as quantized deltas against the last keyframe instead of as full floats
+
+        Position packets are sent as RELIABLE_ORDERED, so a keyframe that has been sent is always
+        read by the other side before any delta that refers to it. Every delta still carries the
+        id of its keyframe, so a receiver that skipped reading a keyframe discards the deltas based
+        on it until the next keyframe arrives
+    */
+    class PositionDeltaState
+    {
+    public:
+        // Writes a keyframe or a delta for an entity, depending on what was last sent for it
+        void write(RakNet::BitStream *bs, uint64_t entity, const ESM::Position &position);
+
+        // Returns false if the data could not be read, and sets hasPosition to false if the data
+        // referred to a keyframe that was not received, leaving position untouched
+        bool read(RakNet::BitStream *bs, uint64_t entity, ESM::Position &position, bool &hasPosition);
+
+        void clear();
+
+    private:
+        struct Keyframe
+        {
+            ESM::Position position;
+            uint8_t id;
+            unsigned int deltasSinceKeyframe;
+        };
+
+        static bool getDeltas(const ESM::Position &keyframePosition, const ESM::Position &position,
+            int32_t positionDeltas[3], int16_t rotationDeltas[3]);
+
+        std::unordered_map<uint64_t, Keyframe> sentKeyframes;
+        std::unordered_map<uint64_t, Keyframe> receivedKeyframes;
+    };
+}
+
+#endif //OPENMW_POSITIONDELTASTATE_HPP
@@ -0,0 +1,125 @@
+#include <RakString.h>
+#include "RecordIdState.hpp"
+#include "PacketEncoding.hpp"
+
+using namespace mwmp;
+
+namespace
+{
+    // Record ids seen after a table is full keep being sent as full strings
+    const uint32_t maxTableSize = 16384;
+}
+
+void RecordIdState::write(RakNet::BitStream *bs, uint8_t channel, const std::string &refId)
+{
+    Table &table = tables[channel % channelCount];
+    auto it = table.sentIndexes.find(refId);
+
+    // Indexes are sent one higher than they are, so 0 can mean that a full string follows
+    if (it != table.sentIndexes.end())
+    {
+        PacketEncoding::writeVarint<uint32_t>(bs, it->second + 1);
+        return;
+    }
+
+    PacketEncoding::writeVarint<uint32_t>(bs, 0);
+    RakNet::RakString::SerializeCompressed(refId.c_str(), bs);
+
+    // The full string is followed by the index it was added at, again one higher, or by 0 if the
+    // table is full, so the other side can tell whether its table still matches
+    if (table.sentIndexes.size() < maxTableSize)
+    {
+        const uint32_t index = (uint32_t) table.sentIndexes.size();
+        table.sentIndexes.emplace(refId, index);
+        PacketEncoding::writeVarint<uint32_t>(bs, index + 1);
+    }
+    else
+        PacketEncoding::writeVarint<uint32_t>(bs, 0);
+}
+
+bool RecordIdState::read(RakNet::BitStream *bs, uint8_t channel, std::string &refId)
+{
+    if (desynced)
+        return false;
+
+    Table &table = tables[channel % channelCount];
+    uint32_t index;
+
+    if (!PacketEncoding::readVarint(bs, index))
+        return false;
+
+    if (index > 0)
+    {
+        // An index we don't have was added by a packet we never read
+        if (index > table.receivedIds.size())
+        {
+            desynced = true;
+            return false;
+        }
+
+        refId = table.receivedIds[index - 1];
+        return true;
+    }
+
+    RakNet::RakString rstr;
+    uint32_t addedIndex;
+
+    if (!rstr.DeserializeCompressed(bs) || !PacketEncoding::readVarint(bs, addedIndex))
+        return false;
+
+    refId = rstr.C_String();
+
+    if (addedIndex > 0)
+    {
+        if (addedIndex - 1 != table.receivedIds.size())
+        {
+            desynced = true;
+            return false;
+        }
+
+        table.receivedIds.push_back(refId);
+    }
+
+    return true;
+}
+
+bool RecordIdState::isWriting() const
+{
+    return writeEpoch != 0;
+}
+
+uint8_t RecordIdState::getWriteEpoch() const
+{
+    return writeEpoch;
+}
+
+bool RecordIdState::isReadEpoch(uint8_t epoch) const
+{
+    return epoch != 0 && epoch == readEpoch;
+}
+
+bool RecordIdState::isDesynced() const
+{
+    return desynced;
+}
+
+uint8_t RecordIdState::resetRead()
+{
+    for (Table &table : tables)
+        table.receivedIds.clear();
+
+    desynced = false;
+
+    if (++readEpoch == 0)
+        readEpoch = 1;
+
+    return readEpoch;
+}
+
+void RecordIdState::resetWrite(uint8_t epoch)
+{
+    for (Table &table : tables)
+        table.sentIndexes.clear();
+
+    writeEpoch = epoch;
+}
@@ -0,0 +1,74 @@
+#ifndef OPENMW_RECORDIDSTATE_HPP
+#define OPENMW_RECORDIDSTATE_HPP
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <BitStream.h>
+
+namespace mwmp
+{
+    /*
+        The record ids exchanged with a single connection, in both directions, used to send each
+        record id as a full string only the first time and as a short index into a table afterwards
+
+        Both sides add a record id to their table when it is first sent or read, so the tables only
+        stay the same as long as every packet using them is read in the order it was sent. Packets
+        are only ordered within their ordering channel, so every channel has its own tables
+
+        Record ids are only sent through the tables once the other side has asked for it with an
+        ID_SYSTEM_RECORD_ID_RESET, which it sends once it reads every such packet, and again with a new
+        epoch whenever it finds its tables no longer match. Packets from before the latest reset carry
+        an older epoch and can't be read
+
+        Each connection gets a state of its own, which lasts as long as the connection does, since the
+        server creates a new Player for every connection and the client quits when it disconnects
+    */
+    class RecordIdState
+    {
+    public:
+        void write(RakNet::BitStream *bs, uint8_t channel, const std::string &refId);
+        bool read(RakNet::BitStream *bs, uint8_t channel, std::string &refId);
+
+        // Whether the other side has asked for record ids to be sent through the tables, and with
+        // which epoch
+        bool isWriting() const;
+        uint8_t getWriteEpoch() const;
+
+        // Whether packets written with the given epoch can be read, which they can't if they were
+        // sent before the latest reset
+        bool isReadEpoch(uint8_t epoch) const;
+
+        // Whether reading found the tables no longer match the other side's, after which nothing
+        // can be read until they are reset
+        bool isDesynced() const;
+
+        // Start over with empty tables for reading, returning the new epoch to send to the other side
+        // in an ID_SYSTEM_RECORD_ID_RESET
+        uint8_t resetRead();
+
+        // Start over with empty tables for writing, after the other side has sent an
+        // ID_SYSTEM_RECORD_ID_RESET with the given epoch
+        void resetWrite(uint8_t epoch);
+
+    private:
+        struct Table
+        {
+            std::unordered_map<std::string, uint32_t> sentIndexes;
+            std::vector<std::string> receivedIds;
+        };
+
+        static const std::size_t channelCount = 8;
+
+        std::array<Table, channelCount> tables;
+
+        // 0 is never used as an epoch, so it means there hasn't been a reset yet
+        uint8_t writeEpoch = 0;
+        uint8_t readEpoch = 0;
+        bool desynced = false;
+    };
+}
+
+#endif //OPENMW_RECORDIDSTATE_HPP
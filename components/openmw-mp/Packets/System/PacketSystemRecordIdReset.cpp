@@ -0,0 +1,17 @@
+#include <components/openmw-mp/NetworkMessages.hpp>
+#include "PacketSystemRecordIdReset.hpp"
+
+using namespace mwmp;
+
+PacketSystemRecordIdReset::PacketSystemRecordIdReset(RakNet::RakPeerInterface *peer) : SystemPacket(peer)
+{
+    packetID = ID_SYSTEM_RECORD_ID_RESET;
+    orderChannel = CHANNEL_SYSTEM;
+}
+
+void PacketSystemRecordIdReset::Packet(RakNet::BitStream *newBitstream, bool send)
+{
+    SystemPacket::Packet(newBitstream, send);
+
+    RW(system->recordIdEpoch, send);
+}
@@ -0,0 +1,17 @@
+#ifndef OPENMW_PACKETSYSTEMRECORDIDRESET_HPP
+#define OPENMW_PACKETSYSTEMRECORDIDRESET_HPP
+
+#include <components/openmw-mp/Packets/System/SystemPacket.hpp>
+
+namespace mwmp
+{
+    class PacketSystemRecordIdReset : public SystemPacket
+    {
+    public:
+        PacketSystemRecordIdReset(RakNet::RakPeerInterface *peer);
+
+        virtual void Packet(RakNet::BitStream *newBitstream, bool send);
+    };
+}
+
+#endif //OPENMW_PACKETSYSTEMRECORDIDRESET_HPP
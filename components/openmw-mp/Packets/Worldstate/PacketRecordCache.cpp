@@ -0,0 +1,39 @@
+#include "PacketRecordCache.hpp"
+#include <components/openmw-mp/NetworkMessages.hpp>
+
+using namespace mwmp;
+
+PacketRecordCache::PacketRecordCache(RakNet::RakPeerInterface *peer) : WorldstatePacket(peer)
+{
+    packetID = ID_RECORD_CACHE;
+    // Sent while joining, on the same channel as ID_LOADED, so the server always has it before
+    // any of its scripts can send records to the player
+    orderChannel = CHANNEL_PLAYER;
+}
+
+void PacketRecordCache::Packet(RakNet::BitStream *newBitstream, bool send)
+{
+    WorldstatePacket::Packet(newBitstream, send);
+
+    uint32_t cachedRecordsCount;
+
+    if (send)
+        cachedRecordsCount = static_cast<uint32_t>(worldstate->cachedRecords.size());
+
+    RWVarint(cachedRecordsCount, send);
+
+    if (cachedRecordsCount > maxCachedRecords)
+    {
+        worldstate->isValid = false;
+        return;
+    }
+
+    if (!send)
+    {
+        worldstate->cachedRecords.clear();
+        worldstate->cachedRecords.resize(cachedRecordsCount);
+    }
+
+    for (auto &&hash : worldstate->cachedRecords)
+        RW(hash, send);
+}
@@ -0,0 +1,21 @@
+#ifndef OPENMW_PACKETRECORDCACHE_HPP
+#define OPENMW_PACKETRECORDCACHE_HPP
+
+#include <components/openmw-mp/Packets/Worldstate/WorldstatePacket.hpp>
+#include <components/openmw-mp/NetworkMessages.hpp>
+
+namespace mwmp
+{
+    class PacketRecordCache: public WorldstatePacket
+    {
+    public:
+        PacketRecordCache(RakNet::RakPeerInterface *peer);
+
+        virtual void Packet(RakNet::BitStream *newBitstream, bool send);
+
+        // Clients keep no more records than this for each server, so this is sent on every join
+        static const uint32_t maxCachedRecords = 20000;
+    };
+}
+
+#endif //OPENMW_PACKETRECORDCACHE_HPP
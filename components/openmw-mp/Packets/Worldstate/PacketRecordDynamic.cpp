@@ -10,6 +10,19 @@ PacketRecordDynamic::PacketRecordDynamic(RakNet::RakPeerInterface *peer) : World
 {
     packetID = ID_RECORD_DYNAMIC;
     orderChannel = CHANNEL_WORLDSTATE;
+    knownRecords = nullptr;
+    recordCache = nullptr;
+    isCacheEncoded = false;
+}
+
+void PacketRecordDynamic::setKnownRecords(std::unordered_set<uint64_t> *knownRecords)
+{
+    this->knownRecords = knownRecords;
+}
+
+void PacketRecordDynamic::setRecordCache(const ContentCache *recordCache)
+{
+    this->recordCache = recordCache;
 }
 
 void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
@@ -18,6 +31,17 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
 
     RW(worldstate->recordsType, send);
 
+    if (send)
+        isCacheEncoded = knownRecords != nullptr;
+
+    RW(isCacheEncoded, send);
+
+    if (isCacheEncoded && !send && recordCache == nullptr)
+    {
+        worldstate->isValid = false;
+        return;
+    }
+
     if (send)
     {
         // These can be created by players through gameplay and should be checked first
@@ -146,7 +170,7 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
 
     if (worldstate->recordsType == mwmp::RECORD_TYPE::SPELL)
     {
-        for (auto &&record : worldstate->spellRecords)
+        ProcessRecords(worldstate->spellRecords, send, [&](auto &record)
         {
             auto &&recordData = record.data;
 
@@ -167,11 +191,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasFlags, send);
                 RW(overrides.hasEffects, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::POTION)
     {
-        for (auto &&record : worldstate->potionRecords)
+        ProcessRecords(worldstate->potionRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -199,11 +223,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasScript, send);
                 RW(overrides.hasEffects, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::ENCHANTMENT)
     {
-        for (auto &&record : worldstate->enchantmentRecords)
+        ProcessRecords(worldstate->enchantmentRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -224,11 +248,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasFlags, send);
                 RW(overrides.hasEffects, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::ARMOR)
     {
-        for (auto &&record : worldstate->armorRecords)
+        ProcessRecords(worldstate->armorRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -263,11 +287,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasScript, send);
                 RW(overrides.hasBodyParts, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::BOOK)
     {
-        for (auto &&record : worldstate->bookRecords)
+        ProcessRecords(worldstate->bookRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -300,11 +324,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasEnchantmentId, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::CLOTHING)
     {
-        for (auto &&record : worldstate->clothingRecords)
+        ProcessRecords(worldstate->clothingRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -335,11 +359,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasScript, send);
                 RW(overrides.hasBodyParts, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::MISCELLANEOUS)
     {
-        for (auto &&record : worldstate->miscellaneousRecords)
+        ProcessRecords(worldstate->miscellaneousRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -364,11 +388,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasKeyState, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::WEAPON)
     {
-        for (auto &&record : worldstate->weaponRecords)
+        ProcessRecords(worldstate->weaponRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -415,11 +439,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasEnchantmentId, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::ACTIVATOR)
     {
-        for (auto &&record : worldstate->activatorRecords)
+        ProcessRecords(worldstate->activatorRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -436,11 +460,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasModel, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::APPARATUS)
     {
-        for (auto &&record : worldstate->apparatusRecords)
+        ProcessRecords(worldstate->apparatusRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -467,11 +491,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasQuality, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::BODYPART)
     {
-        for (auto &&record : worldstate->bodyPartRecords)
+        ProcessRecords(worldstate->bodyPartRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -494,21 +518,21 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasVampireState, send);
                 RW(overrides.hasFlags, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::CELL)
     {
-        for (auto &&record : worldstate->cellRecords)
+        ProcessRecords(worldstate->cellRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
             RW(record.baseId, send, true);
             RW(recordData.mName, send, true);
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::CONTAINER)
     {
-        for (auto &&record : worldstate->containerRecords)
+        ProcessRecords(worldstate->containerRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -531,11 +555,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasScript, send);
                 RW(overrides.hasInventory, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::CREATURE)
     {
-        for (auto &&record : worldstate->creatureRecords)
+        ProcessRecords(worldstate->creatureRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -590,11 +614,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasScript, send);
                 RW(overrides.hasInventory, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::DOOR)
     {
-        for (auto &&record : worldstate->doorRecords)
+        ProcessRecords(worldstate->doorRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -615,11 +639,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasCloseSound, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::GAMESETTING)
     {
-        for (auto&& record : worldstate->gameSettingRecords)
+        ProcessRecords(worldstate->gameSettingRecords, send, [&](auto &record)
         {
             auto& recordData = record.data;
 
@@ -650,11 +674,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 recordData.mValue.setType(ESM::VarType::VT_String);
                 recordData.mValue.setString(record.variable.stringValue);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::INGREDIENT)
     {
-        for (auto &&record : worldstate->ingredientRecords)
+        ProcessRecords(worldstate->ingredientRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -681,11 +705,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasEffects, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::LIGHT)
     {
-        for (auto &&record : worldstate->lightRecords)
+        ProcessRecords(worldstate->lightRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -718,11 +742,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasFlags, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::LOCKPICK)
     {
-        for (auto &&record : worldstate->lockpickRecords)
+        ProcessRecords(worldstate->lockpickRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -749,11 +773,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasUses, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::NPC)
     {
-        for (auto &&record : worldstate->npcRecords)
+        ProcessRecords(worldstate->npcRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -804,11 +828,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasAutoCalc, send);
                 RW(overrides.hasInventory, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::PROBE)
     {
-        for (auto &&record : worldstate->probeRecords)
+        ProcessRecords(worldstate->probeRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -835,11 +859,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasUses, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::REPAIR)
     {
-        for (auto &&record : worldstate->repairRecords)
+        ProcessRecords(worldstate->repairRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -866,11 +890,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasUses, send);
                 RW(overrides.hasScript, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::SCRIPT)
     {
-        for (auto &&record : worldstate->scriptRecords)
+        ProcessRecords(worldstate->scriptRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -883,11 +907,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 auto &&overrides = record.baseOverrides;
                 RW(overrides.hasScriptText, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::STATIC)
     {
-        for (auto &&record : worldstate->staticRecords)
+        ProcessRecords(worldstate->staticRecords, send, [&](auto &record)
         {
             auto &recordData = record.data;
 
@@ -900,11 +924,11 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 auto &&overrides = record.baseOverrides;
                 RW(overrides.hasModel, send);
             }
-        }
+        });
     }
     else if (worldstate->recordsType == mwmp::RECORD_TYPE::SOUND)
     {
-        for (auto&& record : worldstate->soundRecords)
+        ProcessRecords(worldstate->soundRecords, send, [&](auto &record)
         {
             auto& recordData = record.data;
 
@@ -923,8 +947,100 @@ void PacketRecordDynamic::Packet(RakNet::BitStream *newBitstream, bool send)
                 RW(overrides.hasMinRange, send);
                 RW(overrides.hasMaxRange, send);
             }
+        });
+    }
+}
+
+// Records are serialized by themselves, so they can be hashed and then either sent in full or left
+// out if the recipient has them cached already, with both sides reading them back from the same bytes
+bool PacketRecordDynamic::ProcessCachedRecord(bool send, const std::function<void()> &processRecord)
+{
+    RakNet::BitStream *packetStream = bs;
+    std::vector<char> recordData;
+    uint64_t hash;
+    bool isCached;
+
+    if (send)
+    {
+        RakNet::BitStream recordStream;
+        bs = &recordStream;
+        processRecord();
+        bs = packetStream;
+
+        const char *data = reinterpret_cast<const char *>(recordStream.GetData());
+        recordData.assign(data, data + recordStream.GetNumberOfBytesUsed());
+        hash = Utils::hashBytes(recordData.data(), recordData.size());
+        isCached = knownRecords->count(hash) != 0;
+    }
+
+    RW(hash, send);
+    RW(isCached, send);
+
+    if (!isCached)
+    {
+        uint32_t recordSize;
+
+        if (send)
+            recordSize = static_cast<uint32_t>(recordData.size());
+
+        RWVarint(recordSize, send);
+
+        // A record this large ends the packet, which the recipient then ignores, so neither it nor
+        // any record after it becomes known
+        if (recordSize > maxRecordSize)
+        {
+            if (send)
+                LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Sent ID_RECORD_DYNAMIC packet with a record of %u bytes, over the limit of %u",
+                    recordSize, maxRecordSize);
+
+            worldstate->isValid = false;
+            return false;
+        }
+
+        if (!send)
+            recordData.resize(recordSize);
+
+        if (recordSize > 0)
+        {
+            char *data = recordData.data();
+
+            if (!RW(data, recordSize, send))
+            {
+                worldstate->isValid = false;
+                return false;
+            }
         }
     }
+
+    // The recipient caches every record it receives in full
+    if (send)
+    {
+        knownRecords->insert(hash);
+        return true;
+    }
+
+    if (!isCached)
+    {
+        recordCache->store(hash, recordData);
+        receivedRecords[hash] = recordData;
+    }
+    else if (auto it = receivedRecords.find(hash); it != receivedRecords.end())
+        recordData = it->second;
+    else if (!recordCache->load(hash, recordData))
+    {
+        LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Processed ID_RECORD_DYNAMIC packet with a record %016llx that is not cached",
+            (unsigned long long) hash);
+        worldstate->isValid = false;
+        return false;
+    }
+
+    RakNet::BitStream recordStream(reinterpret_cast<unsigned char *>(recordData.data()),
+        static_cast<unsigned int>(recordData.size()), false);
+    bs = &recordStream;
+    processRecord();
+    bs = packetStream;
+
+    return true;
 }
 
 void PacketRecordDynamic::ProcessEffects(ESM::EffectList &effectList, bool send)
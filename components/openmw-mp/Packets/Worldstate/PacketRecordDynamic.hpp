@@ -1,6 +1,12 @@
 #ifndef OPENMW_PACKETRECORDDYNAMIC_HPP
 #define OPENMW_PACKETRECORDDYNAMIC_HPP
 
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <components/openmw-mp/ContentCache.hpp>
 #include <components/openmw-mp/Packets/Worldstate/WorldstatePacket.hpp>
 #include <components/openmw-mp/NetworkMessages.hpp>
 
@@ -13,12 +19,41 @@ namespace mwmp
 
         virtual void Packet(RakNet::BitStream *newBitstream, bool send);
 
+        // When sending to a single connection, only send the hashes of the records it already has
+        // cached, adding the ones sent in full to them
+        void setKnownRecords(std::unordered_set<uint64_t> *knownRecords);
+        // When reading, take records sent as hashes from this cache and add the ones sent in full to it
+        void setRecordCache(const ContentCache *recordCache);
+
         void ProcessEffects(ESM::EffectList &effectList, bool send);
         void ProcessBodyParts(ESM::PartReferenceList &bodyPartList, bool send);
         void ProcessInventoryList(std::vector<mwmp::Item> &inventory, ESM::InventoryList &inventoryList, bool send);
 
     protected:
+        template<class RecordType, class Function>
+        void ProcessRecords(std::vector<RecordType> &records, bool send, Function processRecord)
+        {
+            for (auto &&record : records)
+            {
+                if (!isCacheEncoded)
+                    processRecord(record);
+                else if (!ProcessCachedRecord(send, [&]() { processRecord(record); }))
+                    return;
+            }
+        }
+
+        bool ProcessCachedRecord(bool send, const std::function<void()> &processRecord);
+
+        std::unordered_set<uint64_t> *knownRecords;
+        const ContentCache *recordCache;
+
+        // The records read in full so far, which are looked up before the record cache because
+        // storing them in it can fail while the sender will only send their hashes from then on
+        std::unordered_map<uint64_t, std::vector<char>> receivedRecords;
+        bool isCacheEncoded;
+
         static const int maxRecords = 3000;
+        static const uint32_t maxRecordSize = 64 * 1024;
         static const int maxEffects = 100;
         static const int maxParts = 7;
         static const int maxItems = 1000;
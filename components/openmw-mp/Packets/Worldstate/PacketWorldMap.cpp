@@ -7,18 +7,23 @@ using namespace mwmp;
 PacketWorldMap::PacketWorldMap(RakNet::RakPeerInterface *peer) : WorldstatePacket(peer)
 {
     packetID = ID_WORLD_MAP;
+    // Map tiles can add up to a lot of data, so keep them from holding up any other worldstate packets
+    priority = MEDIUM_PRIORITY;
+    orderChannel = CHANNEL_WORLDMAP;
 }
 
 void PacketWorldMap::Packet(RakNet::BitStream *newBitstream, bool send)
 {
     WorldstatePacket::Packet(newBitstream, send);
 
+    RWBits(worldstate->mapTilesAction, 3, send);
+
     uint32_t changesCount;
 
     if (send)
         changesCount = static_cast<uint32_t>(worldstate->mapTiles.size());
 
-    RW(changesCount, send);
+    RWVarint(changesCount, send);
 
     if (!send)
     {
@@ -26,23 +31,44 @@ void PacketWorldMap::Packet(RakNet::BitStream *newBitstream, bool send)
         worldstate->mapTiles.resize(changesCount);
     }
 
+    const bool hasImageData = worldstate->mapTilesAction == BaseWorldstate::MAP_TILES_SET ||
+        worldstate->mapTilesAction == BaseWorldstate::MAP_TILES_CHUNK;
+
+    // Everything after this point is a whole number of bytes, so aligning once lets every tile's
+    // image data be copied into or out of the stream in one go
+    if (hasImageData)
+    {
+        if (send)
+            bs->AlignWriteToByteBoundary();
+        else
+            bs->AlignReadToByteBoundary();
+    }
+
     for (auto &&mapTile : worldstate->mapTiles)
     {
-        RW(mapTile.x, send);
-        RW(mapTile.y, send);
+        RWZigZag(mapTile.x, send);
+        RWZigZag(mapTile.y, send);
+
+        if (worldstate->mapTilesAction == BaseWorldstate::MAP_TILES_LIST ||
+            worldstate->mapTilesAction == BaseWorldstate::MAP_TILES_CACHED)
+            RW(mapTile.hash, send);
+
+        if (!hasImageData)
+            continue;
 
         uint32_t imageDataSize;
 
         if (send)
             imageDataSize = static_cast<uint32_t>(mapTile.imageData.size());
 
-        RW(imageDataSize, send);
+        RWVarint(imageDataSize, send);
 
         if (imageDataSize > mwmp::maxImageDataSize)
         {
             LOG_MESSAGE_SIMPLE(TimedLog::LOG_ERROR, "Processed invalid ID_WORLD_MAP packet where tile %i, %i had an imageDataSize of %i",
                 mapTile.x, mapTile.y, imageDataSize);
-            LOG_APPEND(TimedLog::LOG_ERROR, "- The packet was ignored after that point");
+            LOG_APPEND(TimedLog::LOG_ERROR, "- The packet was ignored");
+            worldstate->mapTiles.clear();
             return;
         }
 
@@ -52,9 +78,15 @@ void PacketWorldMap::Packet(RakNet::BitStream *newBitstream, bool send)
             mapTile.imageData.resize(imageDataSize);
         }
 
-        for (auto &&imageChar : mapTile.imageData)
+        if (imageDataSize > 0)
         {
-            RW(imageChar, send);
+            char *imageData = mapTile.imageData.data();
+
+            if (!RW(imageData, imageDataSize, send))
+            {
+                worldstate->mapTiles.clear();
+                return;
+            }
         }
     }
 }
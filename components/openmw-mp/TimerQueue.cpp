@@ -0,0 +1,87 @@
+#include "TimerQueue.hpp"
+
+#include <algorithm>
+
+using namespace mwmp;
+
+bool TimerQueue::isLater(const Entry &lhs, const Entry &rhs)
+{
+    if (lhs.expiry != rhs.expiry)
+        return lhs.expiry > rhs.expiry;
+
+    return lhs.sequence > rhs.sequence;
+}
+
+void TimerQueue::schedule(int id, Clock::time_point expiry)
+{
+    if (id < 0)
+        return;
+
+    if (static_cast<std::size_t>(id) >= pendingSequences.size())
+        pendingSequences.resize(id + 1, 0);
+
+    if (pendingSequences[id] == 0)
+        scheduledCount++;
+
+    const uint64_t sequence = nextSequence++;
+    pendingSequences[id] = sequence;
+
+    heap.push_back({ expiry, sequence, id });
+    std::push_heap(heap.begin(), heap.end(), isLater);
+
+    if (heap.size() > 2 * scheduledCount + 64)
+        compact();
+}
+
+void TimerQueue::cancel(int id)
+{
+    if (!isScheduled(id))
+        return;
+
+    pendingSequences[id] = 0;
+    scheduledCount--;
+}
+
+bool TimerQueue::isScheduled(int id) const
+{
+    return id >= 0 && static_cast<std::size_t>(id) < pendingSequences.size() && pendingSequences[id] != 0;
+}
+
+void TimerQueue::popExpired(Clock::time_point now, std::vector<int> &expired)
+{
+    while (!heap.empty() && heap.front().expiry <= now)
+    {
+        std::pop_heap(heap.begin(), heap.end(), isLater);
+        const Entry entry = heap.back();
+        heap.pop_back();
+
+        // Skip entries left behind by timers that have since been rescheduled or cancelled
+        if (pendingSequences[entry.id] != entry.sequence)
+            continue;
+
+        pendingSequences[entry.id] = 0;
+        scheduledCount--;
+        expired.push_back(entry.id);
+    }
+}
+
+std::size_t TimerQueue::size() const
+{
+    return scheduledCount;
+}
+
+void TimerQueue::clear()
+{
+    heap.clear();
+    pendingSequences.clear();
+    scheduledCount = 0;
+}
+
+void TimerQueue::compact()
+{
+    heap.erase(std::remove_if(heap.begin(), heap.end(), [this](const Entry &entry) {
+        return pendingSequences[entry.id] != entry.sequence;
+    }), heap.end());
+
+    std::make_heap(heap.begin(), heap.end(), isLater);
+}
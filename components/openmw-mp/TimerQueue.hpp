@@ -0,0 +1,52 @@
+#ifndef OPENMW_TIMERQUEUE_HPP
+#define OPENMW_TIMERQUEUE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace mwmp
+{
+    /*
+        Min-heap of pending timer expiries keyed by timer id
+
+        Rescheduling or cancelling a timer does not search the heap; the old entry is left behind and
+        skipped once it reaches the top, and the heap is rebuilt whenever such entries outnumber the
+        live ones
+    */
+    class TimerQueue
+    {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        // Schedule a timer to expire at the given time, replacing any expiry it already had
+        void schedule(int id, Clock::time_point expiry);
+        void cancel(int id);
+        bool isScheduled(int id) const;
+
+        // Append the ids of all timers that have expired by the given time, in order of expiry
+        void popExpired(Clock::time_point now, std::vector<int> &expired);
+
+        std::size_t size() const;
+        void clear();
+
+    private:
+        struct Entry
+        {
+            Clock::time_point expiry;
+            uint64_t sequence;
+            int id;
+        };
+
+        static bool isLater(const Entry &lhs, const Entry &rhs);
+        void compact();
+
+        std::vector<Entry> heap;
+        // Sequence number of each timer's live heap entry, or 0 if it is not scheduled
+        std::vector<uint64_t> pendingSequences;
+        uint64_t nextSequence = 1;
+        std::size_t scheduledCount = 0;
+    };
+}
+
+#endif //OPENMW_TIMERQUEUE_HPP
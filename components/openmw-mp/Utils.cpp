@@ -7,6 +7,7 @@
 #include <memory>
 #include <iostream>
 #include <sstream>
+#include <components/misc/hash.hpp>
 #include <boost/crc.hpp>
 #include <boost/filesystem/fstream.hpp>
 #include <iomanip>
@@ -173,6 +174,11 @@ unsigned int ::Utils::crc32Checksum(const std::string &file)
     return crc32.checksum();
 }
 
+uint64_t Utils::hashBytes(const char *data, std::size_t size)
+{
+    return Misc::fnv1a(std::string_view(data, size), [](char c) { return c; });
+}
+
 std::string Utils::getOperatingSystemType()
 {
 #if defined(_WIN32)
@@ -2,6 +2,7 @@
 #define UTILS_HPP
 
 #include <algorithm>
+#include <cstdint>
 #include <string>
 #include <sstream>
 #include <vector>
@@ -55,6 +56,8 @@ namespace Utils
     long int getFileLength(const char *file);
 
     unsigned int crc32Checksum(const std::string &file);
+    // 64-bit FNV-1a, for telling apart blobs of data that are sent or cached by their contents
+    uint64_t hashBytes(const char *data, std::size_t size);
 
     std::string getOperatingSystemType();
     std::string getArchitectureType();
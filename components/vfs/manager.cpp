@@ -2,6 +2,16 @@
 
 #include <stdexcept>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <components/misc/hash.hpp>
+/*
+    End of tes3mp addition
+*/
+
 #include <components/misc/stringops.hpp>
 
 #include "archive.hpp"
@@ -25,13 +35,50 @@ namespace
         std::transform(path.begin(), path.end(), path.begin(), normalize_char);
     }
 
+    /*
+        Start of tes3mp addition
+
+        Hash and compare paths as they would be after normalizing them, without a normalized copy
+    */
+    template <char (*normalize_char)(char)>
+    std::size_t hash_path(std::string_view path)
+    {
+        return static_cast<std::size_t>(Misc::fnv1a(path, normalize_char));
+    }
+
+    template <char (*normalize_char)(char)>
+    bool equal_paths(std::string_view left, std::string_view right)
+    {
+        if (left.size() != right.size())
+            return false;
+
+        for (std::size_t i = 0; i < left.size(); ++i)
+        {
+            if (normalize_char(left[i]) != normalize_char(right[i]))
+                return false;
+        }
+        return true;
+    }
+    /*
+        End of tes3mp addition
+    */
+
 }
 
 namespace VFS
 {
 
+    /*
+        Start of tes3mp change (minor)
+
+        Hash and compare names in the index the same way they're normalized
+    */
     Manager::Manager(bool strict)
         : mStrict(strict)
+        , mHashIndex(PathHash{strict}, PathEqual{strict})
+    /*
+        End of tes3mp change (minor)
+    */
     {
 
     }
@@ -44,47 +91,86 @@ namespace VFS
     void Manager::reset()
     {
         mIndex.clear();
+
+        /*
+            Start of tes3mp addition
+
+            Keep the hash index in sync with the index
+        */
+        mHashIndex.clear();
+        /*
+            End of tes3mp addition
+        */
+
         for (std::vector<Archive*>::iterator it = mArchives.begin(); it != mArchives.end(); ++it)
             delete *it;
         mArchives.clear();
     }
 
+    /*
+        Start of tes3mp change (major)
+
+        Add the files of archives to the index as soon as the archives are registered, and look
+        names up in the hash index without normalizing them into a copy first
+    */
     void Manager::addArchive(Archive *archive)
     {
         mArchives.push_back(archive);
+        indexArchive(archive);
     }
 
     void Manager::buildIndex()
     {
         mIndex.clear();
+        mHashIndex.clear();
 
-        for (std::vector<Archive*>::const_iterator it = mArchives.begin(); it != mArchives.end(); ++it)
-            (*it)->listResources(mIndex, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+        for (Archive* archive : mArchives)
+            indexArchive(archive);
     }
 
-    Files::IStreamPtr Manager::get(const std::string &name) const
+    void Manager::indexArchive(Archive* archive)
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
+        std::map<std::string, File*> resources;
+        archive->listResources(resources, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
 
-        return getNormalized(normalized);
+        mHashIndex.reserve(mIndex.size() + resources.size());
+
+        // Files of the same name in archives registered earlier are replaced, keeping the node
+        // and thereby the name the hash index points to
+        for (const auto& [name, file] : resources)
+        {
+            std::map<std::string, File*>::iterator indexed = mIndex.insert_or_assign(name, file).first;
+            mHashIndex.insert(indexed->first, IndexEntry{file, archive});
+        }
     }
 
-    Files::IStreamPtr Manager::getNormalized(const std::string &normalizedName) const
+    Files::IStreamPtr Manager::get(std::string_view name) const
     {
-        std::map<std::string, File*>::const_iterator found = mIndex.find(normalizedName);
-        if (found == mIndex.end())
-            throw std::runtime_error("Resource '" + normalizedName + "' not found");
-        return found->second->open();
+        const IndexEntry* found = mHashIndex.find(name);
+        if (found == nullptr)
+        {
+            std::string normalized(name);
+            normalize_path(normalized, mStrict);
+            throw std::runtime_error("Resource '" + normalized + "' not found");
+        }
+        return found->mFile->open();
     }
 
-    bool Manager::exists(const std::string &name) const
+    Files::IStreamPtr Manager::getNormalized(std::string_view normalizedName) const
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
+        const IndexEntry* found = mHashIndex.find(normalizedName);
+        if (found == nullptr)
+            throw std::runtime_error("Resource '" + std::string(normalizedName) + "' not found");
+        return found->mFile->open();
+    }
 
-        return mIndex.find(normalized) != mIndex.end();
+    bool Manager::exists(std::string_view name) const
+    {
+        return mHashIndex.find(name) != nullptr;
     }
+    /*
+        End of tes3mp change (major)
+    */
 
     const std::map<std::string, File*>& Manager::getIndex() const
     {
@@ -96,15 +182,38 @@ namespace VFS
         normalize_path(name, mStrict);
     }
 
-    std::string Manager::getArchive(const std::string& name) const
+    /*
+        Start of tes3mp change (major)
+
+        Get the archive a file comes from out of the hash index, instead of asking every archive
+        whether it contains the file
+    */
+    std::string Manager::getArchive(std::string_view name) const
     {
-        std::string normalized = name;
-        normalize_path(normalized, mStrict);
-        for(auto it = mArchives.rbegin(); it != mArchives.rend(); ++it)
-        {
-            if((*it)->contains(normalized, mStrict ? &strict_normalize_char : &nonstrict_normalize_char))
-                return (*it)->getDescription();
-        }
-        return {};
+        const IndexEntry* found = mHashIndex.find(name);
+        if (found == nullptr)
+            return {};
+        return found->mArchive->getDescription();
+    }
+    /*
+        End of tes3mp change (major)
+    */
+
+    /*
+        Start of tes3mp addition
+
+        Hash and compare names in the index as they would be after normalizing them
+    */
+    std::size_t Manager::PathHash::operator()(std::string_view path) const
+    {
+        return mStrict ? hash_path<&strict_normalize_char>(path) : hash_path<&nonstrict_normalize_char>(path);
+    }
+
+    bool Manager::PathEqual::operator()(std::string_view left, std::string_view right) const
+    {
+        return mStrict ? equal_paths<&strict_normalize_char>(left, right) : equal_paths<&nonstrict_normalize_char>(left, right);
     }
+    /*
+        End of tes3mp addition
+    */
 }
@@ -6,6 +6,18 @@
 #include <vector>
 #include <map>
 
+/*
+    Start of tes3mp addition
+
+    Include additional headers for multiplayer purposes
+*/
+#include <string_view>
+
+#include <components/misc/hashindex.hpp>
+/*
+    End of tes3mp addition
+*/
+
 namespace VFS
 {
 
@@ -29,16 +41,34 @@ namespace VFS
         // Empty the file index and unregister archives.
         void reset();
 
-        /// Register the given archive. All files contained in it will be added to the index on the next buildIndex() call.
+        /*
+            Start of tes3mp change (major)
+
+            Add the files of archives to the index as soon as the archives are registered, so the
+            index doesn't have to be built again from every archive once they all are
+        */
+        /// Register the given archive. All files contained in it are added to the index right away, replacing
+        /// the files of the same names from archives registered before it.
         /// @note Takes ownership of the given pointer.
         void addArchive(Archive* archive);
 
-        /// Build the file index. Should be called when all archives have been registered.
+        /// Build the file index again from all registered archives, such as when their contents have changed.
         void buildIndex();
+        /*
+            End of tes3mp change (major)
+        */
 
+        /*
+            Start of tes3mp change (minor)
+
+            Take string views, so names can be looked up without a normalized copy of them
+        */
         /// Does a file with this name exist?
         /// @note May be called from any thread once the index has been built.
-        bool exists(const std::string& name) const;
+        bool exists(std::string_view name) const;
+        /*
+            End of tes3mp change (minor)
+        */
 
         /// Get a complete list of files from all archives
         /// @note May be called from any thread once the index has been built.
@@ -48,23 +78,64 @@ namespace VFS
         /// @note May be called from any thread once the index has been built.
         void normalizeFilename(std::string& name) const;
 
+        /*
+            Start of tes3mp change (minor)
+
+            Take string views, so names can be looked up without a normalized copy of them
+        */
         /// Retrieve a file by name.
         /// @note Throws an exception if the file can not be found.
         /// @note May be called from any thread once the index has been built.
-        Files::IStreamPtr get(const std::string& name) const;
+        Files::IStreamPtr get(std::string_view name) const;
 
         /// Retrieve a file by name (name is already normalized).
         /// @note Throws an exception if the file can not be found.
         /// @note May be called from any thread once the index has been built.
-        Files::IStreamPtr getNormalized(const std::string& normalizedName) const;
+        Files::IStreamPtr getNormalized(std::string_view normalizedName) const;
 
-        std::string getArchive(const std::string& name) const;
+        std::string getArchive(std::string_view name) const;
+        /*
+            End of tes3mp change (minor)
+        */
     private:
         bool mStrict;
 
         std::vector<Archive*> mArchives;
 
         std::map<std::string, File*> mIndex;
+
+        /*
+            Start of tes3mp addition
+
+            Hash index of the files in mIndex and the archives they come from, hashing and comparing
+            names as they would be after normalizing them, so names can be looked up as they are
+        */
+        struct PathHash
+        {
+            bool mStrict;
+
+            std::size_t operator()(std::string_view path) const;
+        };
+
+        struct PathEqual
+        {
+            bool mStrict;
+
+            bool operator()(std::string_view left, std::string_view right) const;
+        };
+
+        struct IndexEntry
+        {
+            File* mFile;
+            Archive* mArchive;
+        };
+
+        void indexArchive(Archive* archive);
+
+        Misc::HashIndex<IndexEntry, PathHash, PathEqual> mHashIndex;
+        /*
+            End of tes3mp addition
+        */
     };
 
 }
@@ -50,7 +50,15 @@ namespace VFS
             }
         }
 
-        vfs->buildIndex();
+        /*
+            Start of tes3mp change (minor)
+
+            Don't build the index again, since archives are added to it as they're registered
+        */
+        //vfs->buildIndex();
+        /*
+            End of tes3mp change (minor)
+        */
     }
 
 }